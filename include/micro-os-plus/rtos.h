@@ -103,7 +103,14 @@
 #include <micro-os-plus/rtos/semaphore.h>
 #include <micro-os-plus/rtos/memory-pool.h>
 #include <micro-os-plus/rtos/message-queue.h>
+#include <micro-os-plus/rtos/stream-buffer.h>
+#include <micro-os-plus/rtos/topic.h>
 #include <micro-os-plus/rtos/event-flags.h>
+#include <micro-os-plus/rtos/event-trace.h>
+#include <micro-os-plus/rtos/deferred-log.h>
+#include <micro-os-plus/rtos/object-registry.h>
+#include <micro-os-plus/rtos/cpu-load.h>
+#include <micro-os-plus/rtos/wakeup-graph.h>
 
 #include <micro-os-plus/rtos/hooks.h>
 #if (!(defined(__APPLE__) || defined(__linux__) || defined(__unix__)))
@@ -137,6 +144,14 @@ namespace micro_os_plus
        */
       extern thread::threads_list top_threads_list_;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+      /**
+       * @brief The next thread whose stack is scanned by the idle
+       * thread, or nullptr to restart from the first one.
+       */
+      extern thread* stack_scan_cursor_;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
       /**
        * @endcond
        */
@@ -291,6 +291,10 @@ namespace micro_os_plus
        * @cond ignore
        */
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      friend class object_registry;
+#endif
+
 #if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_CONDITION_VARIABLE)
       internal::waiting_threads_list list_;
       // clock& clock_;
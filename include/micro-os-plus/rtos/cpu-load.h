@@ -0,0 +1,153 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MICRO_OS_PLUS_RTOS_CPU_LOAD_H_
+#define MICRO_OS_PLUS_RTOS_CPU_LOAD_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) \
+    || defined(__DOXYGEN__)
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/rtos/declarations.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    /**
+     * @brief Sliding window CPU load.
+     * @ingroup micro-os-plus-rtos-core
+     * @details
+     * The thread CPU cycles accumulate since startup, so recent
+     * changes in the load are hidden by the long history.
+     *
+     * `sample()` must be called at a fixed interval, for example
+     * once per second from a low priority thread; at each call
+     * it computes, for each thread, the share of the interval
+     * spent running, and updates an exponentially decayed average.
+     * The idle thread share gives the idle percentage.
+     *
+     * All loads are expressed in hundredths of percent (0-10000).
+     *
+     * @note Available only when
+     * `MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD` is
+     * defined; it also enables
+     * `MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES`.
+     * The average weights the last interval with
+     * 1/2^`MICRO_OS_PLUS_INTEGER_RTOS_CPU_LOAD_DECAY_SHIFT`
+     * (default 3).
+     */
+    namespace cpu_load
+    {
+      /**
+       * @brief Sample the CPU cycles of all threads.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      sample (void);
+
+      /**
+       * @brief Get the duration of the last sample interval.
+       * @par Parameters
+       *  None.
+       * @return Number of CPU cycles.
+       */
+      rtos::statistics::duration_t
+      interval_cycles (void);
+
+      /**
+       * @brief Get the idle thread load during the last interval.
+       * @par Parameters
+       *  None.
+       * @return The load in hundredths of percent (0-10000).
+       */
+      uint32_t
+      idle (void);
+
+      /**
+       * @brief Get the exponentially decayed idle thread load.
+       * @par Parameters
+       *  None.
+       * @return The load in hundredths of percent (0-10000).
+       */
+      uint32_t
+      idle_average (void);
+
+      /**
+       * @brief Print the threads load, using `trace::printf()`.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      trace_print (void);
+
+      /**
+       * @cond ignore
+       */
+
+      void
+      internal_sample_ (thread* parent);
+
+      /**
+       * @endcond
+       */
+
+    } // namespace cpu_load
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_RTOS_CPU_LOAD_H_
+
+// ----------------------------------------------------------------------------
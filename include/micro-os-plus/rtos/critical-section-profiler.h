@@ -0,0 +1,169 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MICRO_OS_PLUS_RTOS_CRITICAL_SECTION_PROFILER_H_
+#define MICRO_OS_PLUS_RTOS_CRITICAL_SECTION_PROFILER_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_CRITICAL_SECTION_PROFILER) \
+    || defined(__DOXYGEN__)
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/rtos/declarations.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    /**
+     * @brief Critical sections hold time profiler.
+     * @ingroup micro-os-plus-rtos-core
+     * @details
+     * The `interrupts::critical_section` and
+     * `scheduler::critical_section` RAII helpers timestamp the entry
+     * and the exit of the outermost section with the high resolution
+     * clock, and record the hold time, in CPU cycles, per call site.
+     * The call site is the code address where the section was
+     * entered; it can be resolved with `addr2line -i -f` and the
+     * application ELF. With optimisations disabled, the constructor
+     * is not inlined and the site is less precise.
+     *
+     * Sections entered directly with `enter()`/`exit()`, `lock()`/
+     * `locked()`, or the uncritical sections, are not measured.
+     *
+     * @note Available only when
+     * `MICRO_OS_PLUS_INCLUDE_RTOS_CRITICAL_SECTION_PROFILER` is defined.
+     * The number of sites per kind is configured with
+     * `MICRO_OS_PLUS_INTEGER_RTOS_CRITICAL_SECTION_PROFILER_SITES`
+     * (default 32, must be a power of 2); when the table is full,
+     * new sites are accumulated in an entry with a null address.
+     */
+    namespace critical_section_profiler
+    {
+      /**
+       * @brief Kind of critical section.
+       */
+      enum class kind : uint8_t
+      {
+        interrupts = 0,
+        scheduler = 1
+      };
+
+      /**
+       * @brief Statistics of a call site.
+       */
+      struct site
+      {
+        // Code address where the section was entered.
+        void* address;
+        // Number of outermost sections entered.
+        uint32_t count;
+        rtos::statistics::duration_t max_cycles;
+        rtos::statistics::duration_t total_cycles;
+      };
+
+      /**
+       * @brief Get the call sites, sorted by the longest hold time.
+       * @param [in] type Kind of critical section.
+       * @param [out] out Pointer to an array of sites.
+       * @param [in] count Number of elements in the array.
+       * @return Number of sites stored.
+       */
+      std::size_t
+      report (kind type, site* out, std::size_t count) noexcept;
+
+      /**
+       * @brief Get the longest hold time.
+       * @param [in] type Kind of critical section.
+       * @return Number of CPU cycles.
+       */
+      rtos::statistics::duration_t
+      max_cycles (kind type) noexcept;
+
+      /**
+       * @brief Clear all measurements.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      clear (void) noexcept;
+
+      /**
+       * @brief Print the sorted report, using `trace::printf()`.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      trace_print (void);
+
+      /**
+       * @cond ignore
+       */
+
+      void __attribute__ ((noinline))
+      internal_enter_ (kind type) noexcept;
+
+      void __attribute__ ((noinline))
+      internal_exit_ (kind type) noexcept;
+
+      /**
+       * @endcond
+       */
+
+    } // namespace critical_section_profiler
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_CRITICAL_SECTION_PROFILER)
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_RTOS_CRITICAL_SECTION_PROFILER_H_
+
+// ----------------------------------------------------------------------------
@@ -48,6 +48,33 @@
 #include <micro-os-plus/config.h>
 #endif // HAVE_MICRO_OS_PLUS_CONFIG_H
 
+// The CPU load is computed from the thread CPU cycles.
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) \
+    && !defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+#define MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES
+#endif
+
+// The wakeup graph gets the object from the wait accounting and
+// the latency from the wakeup latency measurement.
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+#if !defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+#define MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT
+#endif
+#if !defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+#define MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY
+#endif
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT) \
+    && !defined(MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_THREAD_WAIT_OBJECTS)
+#define MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_THREAD_WAIT_OBJECTS (4)
+#endif
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX) \
+    && !defined(MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_MUTEX_WAITER_NAME_SIZE)
+#define MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_MUTEX_WAITER_NAME_SIZE (16)
+#endif
+
 // ----------------------------------------------------------------------------
 
 #include <micro-os-plus/rtos/port/declarations.h>
@@ -290,6 +317,38 @@ extern "C"
    * @}
    */
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
+  /**
+   * @brief Occupancy of a bounded container.
+   *
+   * @details
+   * The members of this structure are hidden and should not
+   * be accessed directly, but through associated functions.
+   *
+   * @see micro_os_plus::rtos::statistics::occupancy
+   */
+  typedef struct micro_os_plus_statistics_occupancy_s
+  {
+    /**
+     * @cond ignore
+     */
+
+    micro_os_plus_statistics_duration_t full_cycles;
+    micro_os_plus_statistics_duration_t empty_cycles;
+    micro_os_plus_statistics_duration_t full_timestamp;
+    micro_os_plus_statistics_duration_t empty_timestamp;
+    size_t count_max;
+
+    /**
+     * @endcond
+     */
+
+  } micro_os_plus_statistics_occupancy_t;
+
+#endif
+
   /**
    * @brief Internal event flags.
    *
@@ -462,6 +521,10 @@ extern "C"
 
     void* stack_addr;
     size_t stack_size_bytes;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+    size_t stack_scan_elements;
+    size_t stack_available_bytes;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
 
     /**
      * @endcond
@@ -497,7 +560,27 @@ extern "C"
   } micro_os_plus_thread_context_t;
 
 #if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
-    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+
+  /**
+   * @brief Time a thread was blocked on an object.
+   * @headerfile c-api.h <micro-os-plus/rtos/c-api.h>
+   *
+   * @see micro_os_plus::rtos::thread::statistics::wait_object
+   */
+  typedef struct micro_os_plus_thread_statistics_wait_object_s
+  {
+    const void* object;
+    uint8_t reason;
+    micro_os_plus_statistics_counter_t waits;
+    micro_os_plus_statistics_duration_t cycles;
+  } micro_os_plus_thread_statistics_wait_object_t;
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
 
   /**
    * @brief Thread statistics.
@@ -523,6 +606,37 @@ extern "C"
     micro_os_plus_statistics_duration_t cpu_cycles;
 #endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+    micro_os_plus_statistics_duration_t cpu_cycles_sampled;
+    uint32_t cpu_load;
+    uint32_t cpu_load_average;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+    micro_os_plus_statistics_duration_t wakeup_timestamp;
+    micro_os_plus_statistics_counter_t wakeups;
+    micro_os_plus_statistics_duration_t wakeup_latency_total;
+    micro_os_plus_statistics_duration_t wakeup_latency_min;
+    micro_os_plus_statistics_duration_t wakeup_latency_max;
+    uint32_t wakeup_histogram[16];
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+    micro_os_plus_statistics_counter_t waits[8];
+    micro_os_plus_statistics_duration_t wait_cycles[8];
+    micro_os_plus_statistics_duration_t wait_timestamp;
+    const void* wait_object;
+    uint8_t wait_reason;
+#if MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_THREAD_WAIT_OBJECTS > 0
+    micro_os_plus_thread_statistics_wait_object_t
+        wait_objects[MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_THREAD_WAIT_OBJECTS];
+#endif
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+    void* wakeup_edge;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+
     /**
      * @endcond
      */
@@ -616,6 +730,9 @@ extern "C"
 
     void* vtbl;
     const char* name;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+    micro_os_plus_internal_double_list_links_t registry_links;
+#endif
     int errno_; // Prevent the macro to expand (for example with a prefix).
     micro_os_plus_internal_waiting_thread_node_t ready_node;
     micro_os_plus_thread_function_t function;
@@ -642,10 +759,16 @@ extern "C"
     micro_os_plus_thread_user_storage_t user_storage; //
 #endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_CUSTOM_THREAD_USER_STORAGE)
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+    void* heap_arena;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+
 #if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
-    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
     micro_os_plus_thread_statistics_t statistics;
-#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
+#endif
 
 #if defined(MICRO_OS_PLUS_USE_RTOS_PORT_SCHEDULER)
     micro_os_plus_thread_port_data_t port;
@@ -826,6 +949,9 @@ extern "C"
      */
 
     const char* name;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+    micro_os_plus_internal_double_list_links_t registry_links;
+#endif
     micro_os_plus_timer_function_t function;
     micro_os_plus_timer_function_arguments_t function_arguments;
 #if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_TIMER)
@@ -989,6 +1115,43 @@ extern "C"
 
   } micro_os_plus_mutex_attributes_t;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
+  /**
+   * @brief Mutex statistics.
+   * @headerfile c-api.h <micro-os-plus/rtos/c-api.h>
+   *
+   * @details
+   * The members of this structure are hidden and should not
+   * be accessed directly, but through associated functions.
+   *
+   * @see micro_os_plus::rtos::mutex::statistics
+   */
+  typedef struct micro_os_plus_mutex_statistics_s
+  {
+    /**
+     * @cond ignore
+     */
+
+    micro_os_plus_statistics_counter_t acquisitions;
+    micro_os_plus_statistics_counter_t contentions;
+    micro_os_plus_statistics_duration_t wait_cycles_total;
+    micro_os_plus_statistics_duration_t wait_cycles_max;
+    micro_os_plus_statistics_duration_t hold_cycles_total;
+    micro_os_plus_statistics_duration_t hold_cycles_max;
+    micro_os_plus_statistics_duration_t hold_timestamp;
+    const void* longest_waiter;
+    char longest_waiter_name
+        [MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_MUTEX_WAITER_NAME_SIZE];
+
+    /**
+     * @endcond
+     */
+
+  } micro_os_plus_mutex_statistics_t;
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
   /**
    * @brief Mutex object storage.
    * @headerfile c-api.h <micro-os-plus/rtos/c-api.h>
@@ -1012,6 +1175,9 @@ extern "C"
      */
 
     const char* name;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+    micro_os_plus_internal_double_list_links_t registry_links;
+#endif
     void* owner;
 #if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_MUTEX)
     micro_os_plus_internal_threads_waiting_list_t list;
@@ -1032,6 +1198,12 @@ extern "C"
     micro_os_plus_mutex_protocol_t protocol;
     micro_os_plus_mutex_robustness_t robustness;
     micro_os_plus_mutex_count_t max_count;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+#if !defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+    micro_os_plus_internal_double_list_links_t statistics_links;
+#endif
+    micro_os_plus_mutex_statistics_t statistics;
+#endif
 
     /**
      * @endcond
@@ -1096,6 +1268,9 @@ extern "C"
      */
 
     const char* name;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+    micro_os_plus_internal_double_list_links_t registry_links;
+#endif
 #if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_CONDITION_VARIABLE)
     micro_os_plus_internal_threads_waiting_list_t list;
     // void* clock;
@@ -1180,6 +1355,9 @@ extern "C"
      */
 
     const char* name;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+    micro_os_plus_internal_double_list_links_t registry_links;
+#endif
 #if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_SEMAPHORE)
     micro_os_plus_internal_threads_waiting_list_t list;
     void* clock;
@@ -1244,6 +1422,38 @@ extern "C"
 
   } micro_os_plus_memory_pool_attributes_t;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+
+  /**
+   * @brief Memory pool statistics.
+   * @headerfile c-api.h <micro-os-plus/rtos/c-api.h>
+   *
+   * @details
+   * The members of this structure are hidden and should not
+   * be accessed directly, but through associated functions.
+   *
+   * @see micro_os_plus::rtos::memory_pool::statistics
+   */
+  typedef struct micro_os_plus_memory_pool_statistics_s
+  {
+    /**
+     * @cond ignore
+     */
+
+    micro_os_plus_statistics_counter_t allocations;
+    micro_os_plus_statistics_counter_t frees;
+    micro_os_plus_statistics_counter_t blocked_allocations;
+    micro_os_plus_statistics_counter_t timeouts;
+    micro_os_plus_statistics_occupancy_t occupancy;
+
+    /**
+     * @endcond
+     */
+
+  } micro_os_plus_memory_pool_statistics_t;
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+
   /**
    * @brief Memory pool object storage.
    * @headerfile c-api.h <micro-os-plus/rtos/c-api.h>
@@ -1269,6 +1479,9 @@ extern "C"
 
     void* vtbl;
     const char* name;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+    micro_os_plus_internal_double_list_links_t registry_links;
+#endif
 #if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_MEMORY_POOL)
     micro_os_plus_internal_threads_waiting_list_t list;
     void* clock;
@@ -1284,7 +1497,15 @@ extern "C"
     micro_os_plus_memory_pool_size_t blocks;
     micro_os_plus_memory_pool_size_t block_size_bytes;
     micro_os_plus_memory_pool_size_t count;
+    micro_os_plus_memory_pool_size_t watermark;
+#if defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+    uint32_t head;
+#else
     void* first;
+#endif
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+    micro_os_plus_memory_pool_statistics_t statistics;
+#endif
 
     /**
      * @endcond
@@ -1354,6 +1575,40 @@ typedef uint8_t micro_os_plus_message_queue_size_t;
 
   } micro_os_plus_message_queue_attributes_t;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
+  /**
+   * @brief Message queue statistics.
+   * @headerfile c-api.h <micro-os-plus/rtos/c-api.h>
+   *
+   * @details
+   * The members of this structure are hidden and should not
+   * be accessed directly, but through associated functions.
+   *
+   * @see micro_os_plus::rtos::message_queue::statistics
+   */
+  typedef struct micro_os_plus_message_queue_statistics_s
+  {
+    /**
+     * @cond ignore
+     */
+
+    micro_os_plus_statistics_counter_t sends;
+    micro_os_plus_statistics_counter_t receives;
+    micro_os_plus_statistics_counter_t blocked_senders;
+    micro_os_plus_statistics_counter_t blocked_receivers;
+    micro_os_plus_statistics_counter_t send_timeouts;
+    micro_os_plus_statistics_counter_t receive_timeouts;
+    micro_os_plus_statistics_occupancy_t occupancy;
+
+    /**
+     * @endcond
+     */
+
+  } micro_os_plus_message_queue_statistics_t;
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
   /**
    * @brief Message queue object storage.
    * @headerfile c-api.h <micro-os-plus/rtos/c-api.h>
@@ -1379,6 +1634,9 @@ typedef uint8_t micro_os_plus_message_queue_size_t;
 
     void* vtbl;
     const char* name;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+    micro_os_plus_internal_double_list_links_t registry_links;
+#endif
 #if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_MESSAGE_QUEUE)
     micro_os_plus_internal_threads_waiting_list_t send_list;
     micro_os_plus_internal_threads_waiting_list_t receive_list;
@@ -1407,6 +1665,9 @@ typedef uint8_t micro_os_plus_message_queue_size_t;
 #if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_MESSAGE_QUEUE)
     micro_os_plus_message_queue_index_t head;
 #endif
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+    micro_os_plus_message_queue_statistics_t statistics;
+#endif
 
     /**
      * @endcond
@@ -1473,6 +1734,9 @@ typedef uint8_t micro_os_plus_message_queue_size_t;
      */
 
     const char* name;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+    micro_os_plus_internal_double_list_links_t registry_links;
+#endif
 #if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_EVENT_FLAGS)
     micro_os_plus_internal_threads_waiting_list_t list;
     void* clock;
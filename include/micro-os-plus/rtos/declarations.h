@@ -44,6 +44,10 @@
 #include <cerrno>
 #include <cstring>
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+#include <micro-os-plus/utils/lists.h>
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
 // ----------------------------------------------------------------------------
 
 #pragma GCC diagnostic push
@@ -74,9 +78,13 @@ namespace micro_os_plus
     class memory_pool;
     class message_queue;
     class mutex;
+    class object_registry;
     class semaphore;
+    class stream_buffer;
     class thread;
     class timer;
+    class topic;
+    class topic_subscriber;
 
     // ------------------------------------------------------------------------
 
@@ -84,6 +92,8 @@ namespace micro_os_plus
     {
       template <typename T>
       class allocator_stateless_default_resource;
+
+      class heap_arena;
     }
 
     // ------------------------------------------------------------------------
@@ -224,6 +234,141 @@ namespace micro_os_plus
        */
       using duration_t = uint64_t;
 
+      /**
+       * @brief Reason for a thread to be blocked.
+       * @details
+       * Queue send and receive also apply to stream buffers and topics.
+       */
+      enum class wait_reason : uint8_t
+      {
+        other = 0,
+        mutex = 1,
+        semaphore = 2,
+        queue_send = 3,
+        queue_receive = 4,
+        flags = 5,
+        sleep = 6,
+        memory_pool = 7
+      };
+
+      /**
+       * @brief Number of wait reasons.
+       */
+      constexpr std::size_t wait_reasons = 8;
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE) \
+    || defined(__DOXYGEN__)
+
+      /**
+       * @brief Occupancy of a bounded container.
+       * @details
+       * Shared by the memory pool and the message queue statistics.
+       */
+      class occupancy
+      {
+      public:
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct an occupancy object instance.
+         * @par Parameters
+         *  None.
+         */
+        occupancy () = default;
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        occupancy (const occupancy&) = delete;
+        occupancy (occupancy&&) = delete;
+        occupancy&
+        operator= (const occupancy&)
+            = delete;
+        occupancy&
+        operator= (occupancy&&)
+            = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the occupancy object instance.
+         */
+        ~occupancy () = default;
+
+        /**
+         * @}
+         */
+
+      public:
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Get the high-water mark.
+         * @par Parameters
+         *  None.
+         * @return The largest count seen.
+         */
+        std::size_t
+        count_max (void) const;
+
+        /**
+         * @brief Get the time spent full.
+         * @par Parameters
+         *  None.
+         * @return Number of CPU cycles.
+         */
+        duration_t
+        full_cycles (void);
+
+        /**
+         * @brief Get the time spent empty.
+         * @par Parameters
+         *  None.
+         * @return Number of CPU cycles.
+         */
+        duration_t
+        empty_cycles (void);
+
+        /**
+         * @}
+         */
+
+        /**
+         * @cond ignore
+         */
+
+        void
+        internal_update_ (std::size_t count, std::size_t capacity);
+
+        void
+        internal_clear_ (void);
+
+      protected:
+        duration_t full_cycles_ = 0;
+        duration_t empty_cycles_ = 0;
+        // Start of the current full/empty interval, or 0.
+        duration_t full_timestamp_ = 0;
+        duration_t empty_timestamp_ = 0;
+        std::size_t count_max_ = 0;
+
+        /**
+         * @endcond
+         */
+      };
+
+#endif
+
     } // namespace statistics
 
     // ------------------------------------------------------------------------
@@ -550,9 +695,66 @@ namespace micro_os_plus
         static void
         operator delete[] (void* ptr, std::size_t bytes);
 
+#if defined(__cpp_aligned_new) || defined(__DOXYGEN__)
+
+        /**
+         * @brief Allocate space for a new over-aligned object instance
+         * using the RTOS system allocator.
+         * @param bytes Number of bytes to allocate.
+         * @param alignment Alignment of the object.
+         * @return Pointer to allocated object.
+         */
+        static void*
+        operator new (std::size_t bytes, std::align_val_t alignment);
+
+        /**
+         * @brief Allocate space for an array of new over-aligned object
+         * instances using the RTOS system allocator.
+         * @param bytes Number of bytes to allocate.
+         * @param alignment Alignment of the objects.
+         * @return Pointer to allocated array.
+         */
+        static void*
+        operator new[] (std::size_t bytes, std::align_val_t alignment);
+
+        /**
+         * @brief Deallocate the dynamically allocated over-aligned
+         * object instance using the RTOS system allocator.
+         * @param ptr Pointer to object.
+         * @param bytes Number of bytes to deallocate.
+         * @param alignment Alignment of the object.
+         * @par Returns
+         *  Nothing.
+         */
+        static void
+        operator delete (void* ptr, std::size_t bytes,
+                         std::align_val_t alignment);
+
+        /**
+         * @brief Deallocate the dynamically allocated array of
+         * over-aligned object instances using the RTOS system allocator.
+         * @param ptr Pointer to array of objects.
+         * @param bytes Number of bytes to deallocate.
+         * @param alignment Alignment of the objects.
+         * @par Returns
+         *  Nothing.
+         */
+        static void
+        operator delete[] (void* ptr, std::size_t bytes,
+                           std::align_val_t alignment);
+
+#endif // defined(__cpp_aligned_new)
+
         /**
          * @}
          */
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      public:
+        // Intrusive node used to link this object to the
+        // object registry.
+        utils::double_list_links registry_links_;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
       };
 
       // ======================================================================
@@ -0,0 +1,286 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MICRO_OS_PLUS_RTOS_DEFERRED_LOG_H_
+#define MICRO_OS_PLUS_RTOS_DEFERRED_LOG_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_DEFERRED_LOG) || defined(__DOXYGEN__)
+
+// ----------------------------------------------------------------------------
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    /**
+     * @brief Logging with deferred formatting.
+     * @ingroup micro-os-plus-rtos-core
+     * @details
+     * `deferred_log::printf()` has the same signature as
+     * `trace::printf()`, but stores only the format string address,
+     * a timestamp and the raw arguments in a RAM ring buffer.
+     * Writing a record does not enter any critical section; slots
+     * are reserved with an atomic increment.
+     *
+     * The records are formatted later, either on the target by
+     * `flush()`, called by default from the idle thread, or on the
+     * host, from a `dump()`, by `scripts/deferred-log-decode.py`,
+     * which reads the format strings from the application ELF.
+     *
+     * Restrictions:
+     * - the format must be a string literal (it is stored
+     *   by address);
+     * - at most `max_args` arguments, integers or pointers, each
+     *   stored as a machine word; floating point is not supported;
+     * - `%s` arguments must point to strings which are still valid
+     *   when formatted, usually literals or object names.
+     *
+     * @par Dump format
+     * All fields are in the target byte order. The dump begins with
+     * a `dump_header`, followed by `dump_header::records` records,
+     * oldest first, each with a 32-bit index, a 32-bit timestamp,
+     * the format address and `max_args` argument words.
+     *
+     * @note Available only when `MICRO_OS_PLUS_INCLUDE_RTOS_DEFERRED_LOG`
+     * is defined. The ring size is configured with
+     * `MICRO_OS_PLUS_INTEGER_RTOS_DEFERRED_LOG_RECORDS` (default 128,
+     * must be a power of 2). µOS++ is single core, so there is one ring.
+     */
+    namespace deferred_log
+    {
+      /**
+       * @brief Type of a stored argument.
+       */
+      using word_t = uintptr_t;
+
+      /**
+       * @brief Maximum number of arguments of a log call.
+       */
+      constexpr std::size_t max_args = 4;
+
+      /**
+       * @brief Log record.
+       */
+      struct record
+      {
+        // Index of the record since reset.
+        uint32_t index;
+        // Low 32-bits of the high resolution clock.
+        uint32_t timestamp;
+        // Address of the format string.
+        word_t format;
+        word_t args[max_args];
+      };
+
+      /**
+       * @brief Header of a log dump.
+       */
+      struct dump_header
+      {
+        // Must be `dump_magic`.
+        uint32_t magic;
+        uint16_t version;
+        // Must be `sizeof (record)`.
+        uint16_t record_size;
+        // Number of records following the header.
+        uint32_t records;
+        // Timestamps frequency.
+        uint32_t clock_frequency_hz;
+        // Records overwritten before being formatted.
+        uint32_t dropped;
+        // Must be `sizeof (word_t)`.
+        uint8_t word_size;
+        uint8_t reserved[3];
+      };
+
+      /**
+       * @brief Magic value identifying a dump ("uOSl").
+       */
+      constexpr uint32_t dump_magic = 0x6c534f75;
+
+      /**
+       * @brief Dump format version.
+       */
+      constexpr uint16_t dump_version = 1;
+
+      /**
+       * @brief Store a log record.
+       * @param [in] format Pointer to a format string literal.
+       * @param [in] args Integer or pointer arguments.
+       * @par Returns
+       *  Nothing.
+       */
+      template <typename... Args_T>
+      void
+      printf (const char* format, Args_T... args) noexcept;
+
+      /**
+       * @brief Format the pending records with `trace::printf()`.
+       * @par Parameters
+       *  None.
+       * @return Number of formatted records.
+       */
+      std::size_t
+      flush (void) noexcept;
+
+      /**
+       * @brief Enable or disable flushing from the idle thread.
+       * @param [in] state New state.
+       * @return The previous state.
+       */
+      bool
+      idle_flush (bool state) noexcept;
+
+      /**
+       * @brief Check if the idle thread flushes the records.
+       * @par Parameters
+       *  None.
+       * @retval true The idle thread formats the records.
+       * @retval false The records are kept for a dump.
+       */
+      bool
+      idle_flush (void) noexcept;
+
+      /**
+       * @brief Get the number of records lost before being formatted.
+       * @par Parameters
+       *  None.
+       * @return Integer.
+       */
+      uint32_t
+      dropped (void) noexcept;
+
+      /**
+       * @brief Discard all records.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      reset (void) noexcept;
+
+      /**
+       * @brief Write the records in the dump format.
+       * @param [out] buffer Pointer to the destination buffer.
+       * @param [in] bytes Size of the destination buffer.
+       * @return Number of bytes written.
+       */
+      std::size_t
+      dump (void* buffer, std::size_t bytes) noexcept;
+
+      /**
+       * @cond ignore
+       */
+
+      void
+      internal_write_ (const char* format, const word_t* args,
+                       std::size_t count) noexcept;
+
+      template <typename T>
+      inline typename std::enable_if<
+          std::is_integral<T>::value || std::is_enum<T>::value, word_t>::type
+      internal_word_ (T value) noexcept
+      {
+        return static_cast<word_t> (value);
+      }
+
+      template <typename T>
+      inline word_t
+      internal_word_ (T* value) noexcept
+      {
+        return reinterpret_cast<word_t> (value);
+      }
+
+      /**
+       * @endcond
+       */
+
+    } // namespace deferred_log
+  } // namespace rtos
+} // namespace micro_os_plus
+
+// ===== Inline & template implementations ====================================
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace deferred_log
+    {
+      /**
+       * @details
+       * The cost is a function call, an atomic increment,
+       * a timestamp and a few word stores.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      template <typename... Args_T>
+      inline void
+      printf (const char* format, Args_T... args) noexcept
+      {
+        static_assert (sizeof...(Args_T) <= max_args,
+                       "Too many arguments for a deferred log record.");
+
+        // The extra element avoids an empty array.
+        const word_t words[] = { internal_word_ (args)..., 0 };
+        internal_write_ (format, words, sizeof...(Args_T));
+      }
+
+    } // namespace deferred_log
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_DEFERRED_LOG)
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_RTOS_DEFERRED_LOG_H_
+
+// ----------------------------------------------------------------------------
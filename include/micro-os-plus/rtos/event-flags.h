@@ -314,6 +314,10 @@ namespace micro_os_plus
       clock* clock_;
 #endif
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      friend class object_registry;
+#endif
+
 #if defined(MICRO_OS_PLUS_USE_RTOS_PORT_EVENT_FLAGS)
       friend class port::event_flags;
       micro_os_plus_event_flags_port_data_t port_;
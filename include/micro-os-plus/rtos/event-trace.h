@@ -0,0 +1,278 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MICRO_OS_PLUS_RTOS_EVENT_TRACE_H_
+#define MICRO_OS_PLUS_RTOS_EVENT_TRACE_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE) || defined(__DOXYGEN__)
+
+// ----------------------------------------------------------------------------
+
+#include <cstdint>
+#include <cstddef>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    /**
+     * @brief Binary scheduler event trace.
+     * @ingroup micro-os-plus-rtos-core
+     * @details
+     * Scheduler events are stored as fixed size binary records
+     * in a RAM ring buffer, with high resolution clock timestamps,
+     * without formatting anything on the target. When the buffer
+     * is full, the oldest records are overwritten.
+     *
+     * Writing a record does not enter any critical section; slots
+     * are reserved with an atomic increment, so records can be
+     * written from threads and interrupt handlers.
+     *
+     * The dump produced by `dump()` is decoded on the host by
+     * `scripts/event-trace-decode.py`, which generates a Chrome
+     * trace JSON timeline and per-thread summaries.
+     *
+     * @par Dump format
+     * All fields are in the target byte order (little endian on
+     * Cortex-M). The dump begins with a `dump_header`, followed by
+     * `dump_header::records` records, oldest first.
+     * Addresses are truncated to 32-bits.
+     *
+     * Record fields, per event type:
+     *
+     * | Event | `arg` | `object` | `value` |
+     * |-------|-------|----------|---------|
+     * | `thread_name` | chunk index | thread | 4 name characters |
+     * | `context_switch` | new priority | new thread | old thread |
+     * | `thread_resume` | priority | thread | - |
+     * | `thread_suspend` | priority | thread | - |
+     * | `mutex_contention` | - | mutex | owner thread |
+     * | `queue_send` | message priority | queue | messages in queue |
+     * | `queue_receive` | message priority | queue | messages in queue |
+     * | `isr_enter` | irq number | - | - |
+     * | `isr_exit` | irq number | - | - |
+     * | `user` | application | application | application |
+     *
+     * @note Available only when `MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE`
+     * is defined. The ring size is configured with
+     * `MICRO_OS_PLUS_INTEGER_RTOS_EVENT_TRACE_RECORDS` (default 256,
+     * must be a power of 2).
+     */
+    namespace event_trace
+    {
+      /**
+       * @brief Type of the recorded events.
+       */
+      enum class event : uint8_t
+      {
+        none = 0,
+        thread_name = 1,
+        context_switch = 2,
+        thread_resume = 3,
+        thread_suspend = 4,
+        mutex_contention = 5,
+        queue_send = 6,
+        queue_receive = 7,
+        isr_enter = 8,
+        isr_exit = 9,
+        user = 10
+      };
+
+      /**
+       * @brief Binary event record.
+       */
+      struct record
+      {
+        // Low 32-bits of the high resolution clock.
+        uint32_t timestamp;
+        event type;
+        uint8_t arg;
+        // Low 16-bits of the record index, to detect gaps.
+        uint16_t sequence;
+        uint32_t object;
+        uint32_t value;
+      };
+
+      static_assert (sizeof (record) == 16, "record must be 16 bytes");
+
+      /**
+       * @brief Header of a trace dump.
+       */
+      struct dump_header
+      {
+        // Must be `dump_magic`.
+        uint32_t magic;
+        uint16_t version;
+        // Must be `sizeof (record)`.
+        uint16_t record_size;
+        // Number of records following the header.
+        uint32_t records;
+        // Timestamps frequency.
+        uint32_t clock_frequency_hz;
+      };
+
+      /**
+       * @brief Magic value identifying a dump ("uOSt").
+       */
+      constexpr uint32_t dump_magic = 0x74534f75;
+
+      /**
+       * @brief Dump format version.
+       */
+      constexpr uint16_t dump_version = 1;
+
+      /**
+       * @brief Store an event record.
+       * @param [in] type Event type.
+       * @param [in] arg Event specific small argument.
+       * @param [in] object Address of the object generating the event.
+       * @param [in] value Event specific value.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      record_event (event type, uint8_t arg, const void* object,
+                    uint32_t value) noexcept;
+
+      /**
+       * @brief Store the name of an object, in 4 characters chunks.
+       * @param [in] object Address of the object.
+       * @param [in] name Pointer to the name.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      record_name (const void* object, const char* name) noexcept;
+
+      /**
+       * @brief Store an interrupt handler entry event.
+       * @param [in] irq Interrupt number.
+       * @par Returns
+       *  Nothing.
+       * @details
+       * To be called by the port or by the application handlers.
+       */
+      void
+      isr_enter (uint8_t irq) noexcept;
+
+      /**
+       * @brief Store an interrupt handler exit event.
+       * @param [in] irq Interrupt number.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      isr_exit (uint8_t irq) noexcept;
+
+      /**
+       * @brief Enable or disable recording.
+       * @param [in] state New state.
+       * @return The previous state.
+       */
+      bool
+      enabled (bool state) noexcept;
+
+      /**
+       * @brief Check if recording is enabled.
+       * @par Parameters
+       *  None.
+       * @retval true Recording is enabled.
+       * @retval false Recording is disabled.
+       */
+      bool
+      enabled (void) noexcept;
+
+      /**
+       * @brief Discard all records.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      reset (void) noexcept;
+
+      /**
+       * @brief Get the number of records in the ring buffer.
+       * @par Parameters
+       *  None.
+       * @return Integer.
+       */
+      std::size_t
+      capacity (void) noexcept;
+
+      /**
+       * @brief Get the total number of records written since reset.
+       * @par Parameters
+       *  None.
+       * @return Integer, including the overwritten records.
+       */
+      uint32_t
+      written (void) noexcept;
+
+      /**
+       * @brief Write the trace in the dump format.
+       * @param [out] buffer Pointer to the destination buffer.
+       * @param [in] bytes Size of the destination buffer.
+       * @return Number of bytes written.
+       * @details
+       * The records in the ring buffer are followed by the names
+       * of the live threads. Records written concurrently with
+       * the dump are skipped, never copied partially.
+       */
+      std::size_t
+      dump (void* buffer, std::size_t bytes) noexcept;
+
+    } // namespace event_trace
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_RTOS_EVENT_TRACE_H_
+
+// ----------------------------------------------------------------------------
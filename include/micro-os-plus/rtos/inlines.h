@@ -159,6 +159,82 @@ namespace micro_os_plus
         operator delete (ptr, bytes);
       }
 
+#if defined(__cpp_aligned_new) || defined(__DOXYGEN__)
+
+      /**
+       * @details
+       * The allocation function called by a new-expression
+       * for objects with an alignment larger than
+       * `__STDCPP_DEFAULT_NEW_ALIGNMENT__`.
+       *
+       * The alignment is passed to the RTOS system allocator,
+       * so no extra space is used for padding.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      inline void*
+      object_named_system::operator new (std::size_t bytes,
+                                         std::align_val_t alignment)
+      {
+        assert (!interrupts::in_handler_mode ());
+
+        scheduler::critical_section scs;
+
+        return rtos::memory::get_default_resource ()->allocate (
+            bytes, static_cast<std::size_t> (alignment));
+      }
+
+      /**
+       * @details
+       * The allocation function called by the array form of a
+       * new-expression for over-aligned objects.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      inline void*
+      object_named_system::operator new[] (std::size_t bytes,
+                                           std::align_val_t alignment)
+      {
+        // Forward array allocation to single element allocation.
+        return operator new (bytes, alignment);
+      }
+
+      /**
+       * @details
+       * The deallocation function called by a delete-expression
+       * for over-aligned objects.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      inline void
+      object_named_system::operator delete (void* ptr, std::size_t bytes,
+                                            std::align_val_t alignment)
+      {
+        assert (!interrupts::in_handler_mode ());
+
+        scheduler::critical_section scs;
+
+        rtos::memory::get_default_resource ()->deallocate (
+            ptr, bytes, static_cast<std::size_t> (alignment));
+      }
+
+      /**
+       * @details
+       * The deallocation function called by the array form of
+       * a delete-expression for over-aligned objects.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      inline void
+      object_named_system::operator delete[] (void* ptr, std::size_t bytes,
+                                              std::align_val_t alignment)
+      {
+        // Forward array deallocation to single element deallocation.
+        operator delete (ptr, bytes, alignment);
+      }
+
+#endif // defined(__cpp_aligned_new)
+
     } // namespace internal
   } // namespace rtos
 } // namespace micro_os_plus
@@ -823,7 +823,9 @@ namespace micro_os_plus
 
       void
       internal_link_node (internal::waiting_threads_list& list,
-                          internal::waiting_thread_node& node);
+                          internal::waiting_thread_node& node,
+                          rtos::statistics::wait_reason reason,
+                          const void* object);
 
       void
       internal_unlink_node (internal::waiting_thread_node& node);
@@ -832,7 +834,9 @@ namespace micro_os_plus
       internal_link_node (internal::waiting_threads_list& list,
                           internal::waiting_thread_node& node,
                           internal::clock_timestamps_list& timeout_list,
-                          internal::timeout_thread_node& timeout_node);
+                          internal::timeout_thread_node& timeout_node,
+                          rtos::statistics::wait_reason reason,
+                          const void* object);
 
       void
       internal_unlink_node (internal::waiting_thread_node& node,
@@ -0,0 +1,339 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MICRO_OS_PLUS_RTOS_MEMORY_HEAP_ARENA_H_
+#define MICRO_OS_PLUS_RTOS_MEMORY_HEAP_ARENA_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/rtos.h>
+#include <micro-os-plus/rtos/memory-tlsf.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wsuggest-final-methods"
+#pragma GCC diagnostic ignored "-Wsuggest-final-types"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace memory
+    {
+
+      // ======================================================================
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+      /**
+       * @brief Memory resource private to a thread.
+       * @headerfile memory-heap-arena.h <micro-os-plus/rtos/memory-heap-arena.h>
+       */
+      class heap_arena : public tlsf
+      {
+      public:
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a heap arena object instance.
+         * @param [in] name Pointer to name.
+         * @param [in] addr Begin of allocator arena.
+         * @param [in] bytes Size of allocator arena, in bytes.
+         * @param [in] owner Reference to the thread owning the arena.
+         */
+        heap_arena (const char* name, void* addr, std::size_t bytes,
+                    rtos::thread& owner);
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        heap_arena (const heap_arena&) = delete;
+        heap_arena (heap_arena&&) = delete;
+        heap_arena&
+        operator= (const heap_arena&)
+            = delete;
+        heap_arena&
+        operator= (heap_arena&&)
+            = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the heap arena object instance.
+         */
+        virtual ~heap_arena () override;
+
+        /**
+         * @}
+         */
+
+      public:
+        /**
+         * @name Public Static Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Get the arena of the current thread.
+         * @par Parameters
+         *  None.
+         * @return Pointer to the arena, or `nullptr` if the current
+         *  thread has no arena, or if not running in a thread.
+         */
+        static heap_arena*
+        current (void) noexcept;
+
+        /**
+         * @brief Find the arena a block belongs to.
+         * @param [in] addr Address of a previously allocated block,
+         *  from any memory resource.
+         * @return Pointer to the arena, or `nullptr` if the block
+         *  does not belong to any arena.
+         */
+        static heap_arena*
+        find (void* addr) noexcept;
+
+        /**
+         * @}
+         */
+
+      public:
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Get the thread owning the arena.
+         * @par Parameters
+         *  None.
+         * @return Reference to the thread.
+         */
+        rtos::thread&
+        owner (void) const;
+
+        /**
+         * @brief Check if a block belongs to the arena.
+         * @param [in] addr Address of a block.
+         * @retval true The address is inside the arena.
+         * @retval false The address is outside the arena.
+         */
+        bool
+        owns (void* addr) const noexcept;
+
+        /**
+         * @brief Queue a block to be freed by the owner thread.
+         * @param [in] addr Address of a previously allocated block.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        remote_free (void* addr) noexcept;
+
+        /**
+         * @brief Free the blocks queued by other threads.
+         * @par Parameters
+         *  None.
+         * @return The number of freed blocks.
+         */
+        std::size_t
+        drain (void) noexcept;
+
+        /**
+         * @brief Get the number of blocks queued by other threads.
+         * @par Parameters
+         *  None.
+         * @return Integer.
+         */
+        std::size_t
+        remote_frees (void) const;
+
+        /**
+         * @}
+         */
+
+      protected:
+        /**
+         * @name Private Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Implementation of the memory allocator.
+         * @param [in] bytes Number of bytes to allocate.
+         * @param [in] alignment Alignment constraint (power of 2).
+         * @return Pointer to newly allocated block, or `nullptr`.
+         */
+        virtual void*
+        do_allocate (std::size_t bytes, std::size_t alignment) override;
+
+        /**
+         * @brief Implementation of the memory deallocator.
+         * @param [in] addr Address of a previously allocated block to free.
+         * @param [in] bytes Number of bytes to deallocate (may be 0 if
+         *  unknown).
+         * @param [in] alignment Alignment constraint (power of 2).
+         * @par Returns
+         *  Nothing.
+         */
+        virtual void
+        do_deallocate (void* addr, std::size_t bytes,
+                       std::size_t alignment) noexcept override;
+
+        /**
+         * @brief Implementation of the function to reset the memory manager.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        virtual void
+        do_reset (void) noexcept override;
+
+        /**
+         * @brief Implementation of the function to resize a block in place.
+         * @param [in] addr Address of a previously allocated block.
+         * @param [in] bytes New size, in bytes.
+         * @retval true if the block was resized.
+         * @retval false if the operation was ineffective.
+         */
+        virtual bool
+        do_resize (void* addr, std::size_t bytes) noexcept override;
+
+        /**
+         * @brief Implementation of the function to get max size.
+         * @par Parameters
+         *  None.
+         * @return Integer with size in bytes, or 0 if unknown.
+         */
+        virtual std::size_t
+        do_max_size (void) const noexcept override;
+
+        /**
+         * @brief Implementation of the function to get the usable size.
+         * @param [in] addr Address of a previously allocated block.
+         * @return Number of bytes or 0 if unknown.
+         */
+        virtual std::size_t
+        do_usable_size (void* addr) noexcept override;
+
+        /**
+         * @}
+         */
+
+      protected:
+        /**
+         * @cond ignore
+         */
+
+        rtos::thread* owner_;
+
+        // Single linked list of blocks freed by other threads,
+        // linked via the first word of the payload.
+        void* volatile remote_list_ = nullptr;
+        std::size_t volatile remote_count_ = 0;
+
+        // Index in the table of all arenas, stored in the block tags.
+        std::size_t index_ = 0;
+
+        /**
+         * @endcond
+         */
+      };
+
+#pragma GCC diagnostic pop
+
+    } // namespace memory
+  } // namespace rtos
+} // namespace micro_os_plus
+
+// ===== Inline & template implementations ====================================
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace memory
+    {
+
+      // ======================================================================
+
+      inline rtos::thread&
+      heap_arena::owner (void) const
+      {
+        return *owner_;
+      }
+
+      inline bool
+      heap_arena::owns (void* addr) const noexcept
+      {
+        return (static_cast<char*> (addr)
+                >= static_cast<char*> (arena_address_))
+               && (static_cast<char*> (addr)
+                   < static_cast<char*> (arena_address_) + arena_size_bytes_);
+      }
+
+      inline std::size_t
+      heap_arena::remote_frees (void) const
+      {
+        return remote_count_;
+      }
+
+    } // namespace memory
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_RTOS_MEMORY_HEAP_ARENA_H_
+
+// ----------------------------------------------------------------------------
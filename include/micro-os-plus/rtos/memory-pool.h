@@ -39,6 +39,10 @@
 
 #include <micro-os-plus/diag/trace.h>
 
+#if defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+#include <atomic>
+#endif
+
 // ----------------------------------------------------------------------------
 
 #pragma GCC diagnostic push
@@ -196,6 +200,368 @@ namespace micro_os_plus
 
       // ======================================================================
 
+      /**
+       * @brief Private cache of free blocks, in front of a memory pool.
+       * @headerfile os.h <micro-os-plus/rtos.h>
+       * @ingroup micro-os-plus-rtos-mempool
+       *
+       * @details
+       * A magazine belongs to a single thread and keeps a small stack
+       * of free blocks; most allocations and deallocations are
+       * served locally, without entering a critical section.
+       * The magazine is refilled from, and flushed to, the shared
+       * pool in batches of half its capacity.
+       *
+       * @warning Not thread safe; each thread must use its own magazine.
+       */
+      class magazine
+      {
+      public:
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a magazine object instance.
+         * @param [in] pool Reference to the shared memory pool.
+         * @param [in] storage Pointer to an array of block pointers.
+         * @param [in] size Number of elements in the array.
+         */
+        magazine (memory_pool& pool, void** storage, std::size_t size);
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        magazine (const magazine&) = delete;
+        magazine (magazine&&) = delete;
+        magazine&
+        operator= (const magazine&)
+            = delete;
+        magazine&
+        operator= (magazine&&)
+            = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the magazine object instance.
+         * @details
+         * The cached blocks are returned to the pool.
+         */
+        ~magazine ();
+
+        /**
+         * @}
+         */
+
+      public:
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Allocate a memory block.
+         * @par Parameters
+         *  None.
+         * @return Pointer to memory block, or `nullptr` if interrupted.
+         */
+        void*
+        alloc (void);
+
+        /**
+         * @brief Try to allocate a memory block.
+         * @par Parameters
+         *  None.
+         * @return Pointer to memory block, or `nullptr` if no memory
+         *  available.
+         */
+        void*
+        try_alloc (void);
+
+        /**
+         * @brief Free the memory block.
+         * @param [in] block Pointer to memory block to free.
+         * @retval result::ok The memory block was released.
+         * @retval EINVAL The block does not belong to the memory pool.
+         */
+        result_t
+        free (void* block);
+
+        /**
+         * @brief Return all cached blocks to the pool.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        flush (void);
+
+        /**
+         * @brief Get the magazine capacity.
+         * @par Parameters
+         *  None.
+         * @return The max number of cached blocks.
+         */
+        std::size_t
+        capacity (void) const;
+
+        /**
+         * @brief Get the number of cached blocks.
+         * @par Parameters
+         *  None.
+         * @return The number of cached free blocks.
+         */
+        std::size_t
+        length (void) const;
+
+        /**
+         * @brief Get the number of allocations served from the cache.
+         * @par Parameters
+         *  None.
+         * @return Integer.
+         */
+        rtos::statistics::counter_t
+        hits (void) const;
+
+        /**
+         * @brief Get the number of allocations that required
+         * access to the shared pool.
+         * @par Parameters
+         *  None.
+         * @return Integer.
+         */
+        rtos::statistics::counter_t
+        misses (void) const;
+
+        /**
+         * @brief Get the shared memory pool.
+         * @par Parameters
+         *  None.
+         * @return A reference to the memory pool.
+         */
+        memory_pool&
+        pool (void);
+
+        /**
+         * @}
+         */
+
+      protected:
+        /**
+         * @cond ignore
+         */
+
+        memory_pool* pool_;
+        void** storage_;
+        std::size_t size_;
+        std::size_t count_ = 0;
+
+        rtos::statistics::counter_t hits_ = 0;
+        rtos::statistics::counter_t misses_ = 0;
+
+        /**
+         * @endcond
+         */
+      }; /* class magazine */
+
+      /**
+       * @brief Magazine with inclusive storage.
+       * @headerfile os.h <micro-os-plus/rtos.h>
+       * @ingroup micro-os-plus-rtos-mempool
+       */
+      template <std::size_t N>
+      class magazine_inclusive : public magazine
+      {
+      public:
+        /**
+         * @brief Construct a magazine object instance.
+         * @param [in] pool Reference to the shared memory pool.
+         */
+        magazine_inclusive (memory_pool& pool)
+            : magazine{ pool, storage_, N }
+        {
+          ;
+        }
+
+      protected:
+        /**
+         * @cond ignore
+         */
+
+        void* storage_[N];
+
+        /**
+         * @endcond
+         */
+      };
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL) \
+    || defined(__DOXYGEN__)
+
+      // ======================================================================
+
+      /**
+       * @brief Memory pool statistics.
+       * @headerfile os.h <micro-os-plus/rtos.h>
+       * @ingroup micro-os-plus-rtos-mempool
+       *
+       * @note Available only when
+       * @ref MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL is defined.
+       */
+      class statistics
+      {
+      public:
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a memory pool statistics object instance.
+         * @par Parameters
+         *  None.
+         */
+        statistics () = default;
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        statistics (const statistics&) = delete;
+        statistics (statistics&&) = delete;
+        statistics&
+        operator= (const statistics&)
+            = delete;
+        statistics&
+        operator= (statistics&&)
+            = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the memory pool statistics object instance.
+         */
+        ~statistics () = default;
+
+        /**
+         * @}
+         */
+
+      public:
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Get the number of blocks allocated.
+         * @par Parameters
+         *  None.
+         * @return A long integer.
+         */
+        rtos::statistics::counter_t
+        allocations (void) const;
+
+        /**
+         * @brief Get the number of blocks freed.
+         * @par Parameters
+         *  None.
+         * @return A long integer.
+         */
+        rtos::statistics::counter_t
+        frees (void) const;
+
+        /**
+         * @brief Get the high-water mark.
+         * @par Parameters
+         *  None.
+         * @return The largest number of blocks allocated at the same time.
+         */
+        std::size_t
+        count_max (void) const;
+
+        /**
+         * @brief Get the number of allocations that had to wait.
+         * @par Parameters
+         *  None.
+         * @return A long integer.
+         */
+        rtos::statistics::counter_t
+        blocked_allocations (void) const;
+
+        /**
+         * @brief Get the number of timed allocations that timed out.
+         * @par Parameters
+         *  None.
+         * @return A long integer.
+         */
+        rtos::statistics::counter_t
+        timeouts (void) const;
+
+        /**
+         * @brief Get the time spent with all blocks allocated.
+         * @par Parameters
+         *  None.
+         * @return Number of CPU cycles.
+         */
+        rtos::statistics::duration_t
+        full_cycles (void);
+
+        /**
+         * @brief Get the time spent with no blocks allocated.
+         * @par Parameters
+         *  None.
+         * @return Number of CPU cycles.
+         */
+        rtos::statistics::duration_t
+        empty_cycles (void);
+
+        /**
+         * @brief Clear the measurements.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        clear (void);
+
+        /**
+         * @}
+         */
+
+      protected:
+        /**
+         * @cond ignore
+         */
+
+        friend class memory_pool;
+
+        rtos::statistics::counter_t allocations_ = 0;
+        rtos::statistics::counter_t frees_ = 0;
+        rtos::statistics::counter_t blocked_allocations_ = 0;
+        rtos::statistics::counter_t timeouts_ = 0;
+        rtos::statistics::occupancy occupancy_;
+
+        /**
+         * @endcond
+         */
+      };
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+
+      // ======================================================================
+
       /**
        * @brief Default RTOS allocator.
        */
@@ -390,6 +756,19 @@ namespace micro_os_plus
       result_t
       reset (void);
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+
+      /**
+       * @brief Get the memory pool statistics.
+       * @par Parameters
+       *  None.
+       * @return A reference to the statistics object instance.
+       */
+      memory_pool::statistics&
+      statistics (void);
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+
       /**
        * @brief Get the pool storage address.
        * @par Parameters
@@ -437,7 +816,8 @@ namespace micro_os_plus
       internal_init_ (void);
 
       /**
-       * @brief Internal function used to get the first linked block.
+       * @brief Internal function used to get the first linked block,
+       * or the next never used block.
        * @par Parameters
        *  None.
        * @return Pointer to block or `nullptr` if no more blocks available.
@@ -445,6 +825,20 @@ namespace micro_os_plus
       void*
       internal_try_first_ (void);
 
+      /**
+       * @brief Internal function used to push a block to the free list.
+       * @param [in] block Pointer to the block.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_push_ (void* block);
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+      void
+      internal_update_statistics_ (bool allocated);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+
       /**
        * @endcond
        */
@@ -489,6 +883,10 @@ namespace micro_os_plus
        */
       const void* allocator_ = nullptr;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      friend class object_registry;
+#endif
+
 #if defined(MICRO_OS_PLUS_USE_RTOS_PORT_MEMORY_POOL)
       friend class port::memory_pool;
       micro_os_plus_memory_pool_port_data_t port_;
@@ -514,15 +912,45 @@ namespace micro_os_plus
        */
       memory_pool::size_t block_size_bytes_ = 0;
 
+#if defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+      /**
+       * @brief The current number of blocks allocated from the pool.
+       */
+      std::atomic<memory_pool::size_t> count_{ 0 };
+
+      /**
+       * @brief The number of blocks ever taken from the arena;
+       * the blocks above it were never used and are not linked.
+       */
+      std::atomic<memory_pool::size_t> watermark_{ 0 };
+
+      /**
+       * @brief The tagged head of the free (recycled) blocks list;
+       * the index of the first block plus 1 (0 if empty) in the low
+       * half, a generation count in the high half.
+       */
+      std::atomic<uint32_t> head_{ 0 };
+#else
       /**
        * @brief The current number of blocks allocated from the pool.
        */
       volatile memory_pool::size_t count_ = 0;
 
       /**
-       * @brief Pointer to the first free block, or nullptr.
+       * @brief The number of blocks ever taken from the arena;
+       * the blocks above it were never used and are not linked.
+       */
+      volatile memory_pool::size_t watermark_ = 0;
+
+      /**
+       * @brief Pointer to the first free (recycled) block, or nullptr.
        */
       void* volatile first_ = nullptr;
+#endif
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+      class statistics statistics_;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
 
       /**
        * @endcond
@@ -954,6 +1382,140 @@ namespace micro_os_plus
       return pool_arena_address_;
     }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+
+    /**
+     * @note This function is available only when
+     * @ref MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL
+     * is defined.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline class memory_pool::statistics&
+    memory_pool::statistics (void)
+    {
+      return statistics_;
+    }
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @details
+     * Blocks taken by magazines to refill their cache are
+     * also counted.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    memory_pool::statistics::allocations (void) const
+    {
+      return allocations_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    memory_pool::statistics::frees (void) const
+    {
+      return frees_;
+    }
+
+    /**
+     * @details
+     * Compare it with `capacity()` to size the pool; a value
+     * always below the capacity means the pool can be shrunk.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    memory_pool::statistics::count_max (void) const
+    {
+      return occupancy_.count_max ();
+    }
+
+    /**
+     * @details
+     * The counter is incremented once for each `alloc()` or
+     * `timed_alloc()` call that found no free blocks.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    memory_pool::statistics::blocked_allocations (void) const
+    {
+      return blocked_allocations_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    memory_pool::statistics::timeouts (void) const
+    {
+      return timeouts_;
+    }
+
+    /**
+     * @details
+     * If all blocks are currently allocated, the ongoing interval
+     * is included.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    memory_pool::statistics::full_cycles (void)
+    {
+      return occupancy_.full_cycles ();
+    }
+
+    /**
+     * @details
+     * If no blocks are currently allocated, the ongoing interval
+     * is included.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    memory_pool::statistics::empty_cycles (void)
+    {
+      return occupancy_.empty_cycles ();
+    }
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+
+    // ------------------------------------------------------------------------
+
+    inline std::size_t
+    memory_pool::magazine::capacity (void) const
+    {
+      return size_;
+    }
+
+    inline std::size_t
+    memory_pool::magazine::length (void) const
+    {
+      return count_;
+    }
+
+    inline rtos::statistics::counter_t
+    memory_pool::magazine::hits (void) const
+    {
+      return hits_;
+    }
+
+    inline rtos::statistics::counter_t
+    memory_pool::magazine::misses (void) const
+    {
+      return misses_;
+    }
+
+    inline memory_pool&
+    memory_pool::magazine::pool (void)
+    {
+      return *pool_;
+    }
+
     // ========================================================================
 
     /**
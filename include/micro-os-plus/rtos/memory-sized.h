@@ -0,0 +1,271 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MICRO_OS_PLUS_RTOS_MEMORY_SIZED_H_
+#define MICRO_OS_PLUS_RTOS_MEMORY_SIZED_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/rtos.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wsuggest-final-methods"
+#pragma GCC diagnostic ignored "-Wsuggest-final-types"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace memory
+    {
+
+      // ======================================================================
+
+      /**
+       * @brief Memory resource adapter which keeps the size of
+       * each block.
+       * @headerfile memory-sized.h <micro-os-plus/rtos/memory-sized.h>
+       * @tparam T Type of the memory resource to adapt.
+       *
+       * @details
+       * Some allocators, like `first_fit_top` or `lifo`, do not
+       * keep the block sizes in a form usable by `usable_size()`,
+       * which is required by `realloc()`, `malloc_usable_size()` and
+       * the live size histogram.
+       *
+       * The adapter stores the usable size and the offset from
+       * the adapted block in a two words header just below each
+       * block, rounded up to the maximum alignment; with 4 bytes
+       * words and 8 bytes maximum alignment, this is 8 bytes per
+       * block. Blocks with larger alignments get the header inside
+       * the alignment slack, so they cost only the slack and the
+       * header, not one full alignment.
+       *
+       * Blocks are resized in place when the new size fits the
+       * block; shrinking keeps the usable size. Larger sizes are
+       * forwarded to the adapted resource.
+       */
+      template <typename T>
+      class sized_blocks : public T
+      {
+      public:
+        using T::T;
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        sized_blocks (const sized_blocks&) = delete;
+        sized_blocks (sized_blocks&&) = delete;
+        sized_blocks&
+        operator= (const sized_blocks&)
+            = delete;
+        sized_blocks&
+        operator= (sized_blocks&&)
+            = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the memory resource object instance.
+         */
+        virtual ~sized_blocks () override = default;
+
+      protected:
+        /**
+         * @name Private Member Functions
+         * @{
+         */
+
+        virtual void*
+        do_allocate (std::size_t bytes, std::size_t alignment) override;
+
+        virtual void
+        do_deallocate (void* addr, std::size_t bytes,
+                       std::size_t alignment) noexcept override;
+
+        virtual std::size_t
+        do_max_size (void) const noexcept override;
+
+        virtual bool
+        do_resize (void* addr, std::size_t bytes) noexcept override;
+
+        virtual std::size_t
+        do_usable_size (void* addr) noexcept override;
+
+        /**
+         * @}
+         */
+
+        /**
+         * @cond ignore
+         */
+
+        static constexpr std::size_t internal_header_size_
+            = align_size (2 * sizeof (std::size_t),
+                          memory_resource::max_align);
+
+        /**
+         * @endcond
+         */
+      };
+
+    } // namespace memory
+  } // namespace rtos
+} // namespace micro_os_plus
+
+// ===== Inline & template implementations ====================================
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace memory
+    {
+
+      // ======================================================================
+
+      /*
+       * The adapted block is allocated with the maximum alignment
+       * and the header ends just below the block. Larger alignments
+       * are obtained by moving the block up, inside the slack; the
+       * header keeps the offset from the adapted block and the
+       * usable size, which includes the unused part of the slack.
+       */
+      template <typename T>
+      void*
+      sized_blocks<T>::do_allocate (std::size_t bytes, std::size_t alignment)
+      {
+        alignment = max (alignment, memory_resource::max_align);
+        std::size_t total_bytes = internal_header_size_ + bytes
+                                  + (alignment - memory_resource::max_align);
+
+        char* mem = static_cast<char*> (
+            T::do_allocate (total_bytes, memory_resource::max_align));
+        if (mem == nullptr)
+          {
+            return nullptr;
+          }
+
+        std::uintptr_t first
+            = reinterpret_cast<std::uintptr_t> (mem + internal_header_size_);
+        std::size_t offset = internal_header_size_
+                             + ((alignment - (first & (alignment - 1)))
+                                & (alignment - 1));
+
+        std::size_t* block = reinterpret_cast<std::size_t*> (mem + offset);
+        block[-1] = total_bytes - offset;
+        block[-2] = offset;
+
+        return block;
+      }
+
+      template <typename T>
+      void
+      sized_blocks<T>::do_deallocate (void* addr,
+                                      std::size_t bytes
+                                      __attribute__ ((unused)),
+                                      std::size_t alignment
+                                      __attribute__ ((unused))) noexcept
+      {
+        std::size_t* block = static_cast<std::size_t*> (addr);
+        std::size_t offset = block[-2];
+
+        // The size of the adapted block is known, even if the
+        // caller does not know it.
+        T::do_deallocate (static_cast<char*> (addr) - offset,
+                          offset + block[-1], memory_resource::max_align);
+      }
+
+      template <typename T>
+      std::size_t
+      sized_blocks<T>::do_max_size (void) const noexcept
+      {
+        std::size_t bytes = T::do_max_size ();
+
+        return (bytes > internal_header_size_) ? bytes - internal_header_size_
+                                               : 0;
+      }
+
+      template <typename T>
+      bool
+      sized_blocks<T>::do_resize (void* addr, std::size_t bytes) noexcept
+      {
+        std::size_t* block = static_cast<std::size_t*> (addr);
+        if (bytes <= block[-1])
+          {
+            // Fits; the usable size is kept, so the block can
+            // grow back later.
+            return true;
+          }
+
+        std::size_t offset = block[-2];
+        if (T::do_resize (static_cast<char*> (addr) - offset, offset + bytes))
+          {
+            block[-1] = bytes;
+            return true;
+          }
+        return false;
+      }
+
+      template <typename T>
+      std::size_t
+      sized_blocks<T>::do_usable_size (void* addr) noexcept
+      {
+        return static_cast<std::size_t*> (addr)[-1];
+      }
+
+    } // namespace memory
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_RTOS_MEMORY_SIZED_H_
+
+// ----------------------------------------------------------------------------
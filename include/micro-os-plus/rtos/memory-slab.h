@@ -0,0 +1,418 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MICRO_OS_PLUS_RTOS_MEMORY_SLAB_H_
+#define MICRO_OS_PLUS_RTOS_MEMORY_SLAB_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/rtos.h>
+#include <micro-os-plus/memory/first-fit-top.h>
+#include <micro-os-plus/rtos/memory-sized.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wsuggest-final-methods"
+#pragma GCC diagnostic ignored "-Wsuggest-final-types"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace memory
+    {
+
+      // ======================================================================
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+      /**
+       * @brief Memory resource with size classes,
+       * backed by a general allocator for large requests.
+       * @headerfile memory-slab.h <micro-os-plus/rtos/memory-slab.h>
+       */
+      class slab : public memory_resource
+      {
+      public:
+        /**
+         * @brief Maximum number of size classes.
+         */
+        static constexpr std::size_t max_classes = 8;
+
+        /**
+         * @brief Default size of a slab page, in bytes.
+         */
+        static constexpr std::size_t default_page_size_bytes = 1024;
+
+        /**
+         * @brief Default size classes, in bytes.
+         */
+        static const std::size_t default_class_sizes[5];
+
+        // --------------------------------------------------------------------
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a slab memory resource object instance,
+         * with the default configuration.
+         * @param [in] name Pointer to name.
+         * @param [in] addr Begin of allocator arena.
+         * @param [in] bytes Size of allocator arena, in bytes.
+         */
+        slab (const char* name, void* addr, std::size_t bytes);
+
+        /**
+         * @brief Construct a slab memory resource object instance.
+         * @param [in] name Pointer to name.
+         * @param [in] addr Begin of allocator arena.
+         * @param [in] bytes Size of allocator arena, in bytes.
+         * @param [in] slab_bytes Size of the arena part reserved for
+         *  the size classes, in bytes.
+         * @param [in] class_sizes Pointer to an array of block sizes,
+         *  in ascending order.
+         * @param [in] classes Number of elements in the array.
+         * @param [in] page_size_bytes Size of a slab page, in bytes.
+         */
+        slab (const char* name, void* addr, std::size_t bytes,
+              std::size_t slab_bytes, const std::size_t* class_sizes,
+              std::size_t classes,
+              std::size_t page_size_bytes = default_page_size_bytes);
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        slab (const slab&) = delete;
+        slab (slab&&) = delete;
+        slab&
+        operator= (const slab&)
+            = delete;
+        slab&
+        operator= (slab&&)
+            = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the memory resource object instance.
+         */
+        virtual ~slab () override;
+
+        /**
+         * @}
+         */
+
+      public:
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Get the number of size classes.
+         * @par Parameters
+         *  None.
+         * @return Integer.
+         */
+        std::size_t
+        classes (void) const;
+
+        /**
+         * @brief Get the block size of a size class.
+         * @param [in] index Index of the size class.
+         * @return The size in bytes.
+         */
+        std::size_t
+        class_size (std::size_t index) const;
+
+        /**
+         * @brief Get the number of blocks allocated from a size class.
+         * @param [in] index Index of the size class.
+         * @return Integer.
+         */
+        std::size_t
+        class_allocated_chunks (std::size_t index) const;
+
+        /**
+         * @brief Get the number of slab pages in use.
+         * @par Parameters
+         *  None.
+         * @return Integer.
+         */
+        std::size_t
+        pages_used (void) const;
+
+        /**
+         * @brief Get the total number of slab pages.
+         * @par Parameters
+         *  None.
+         * @return Integer.
+         */
+        std::size_t
+        pages (void) const;
+
+        /**
+         * @}
+         */
+
+      protected:
+        /**
+         * @name Private Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Implementation of the memory allocator.
+         * @param [in] bytes Number of bytes to allocate.
+         * @param [in] alignment Alignment constraint (power of 2).
+         * @return Pointer to newly allocated block, or `nullptr`.
+         */
+        virtual void*
+        do_allocate (std::size_t bytes, std::size_t alignment) override;
+
+        /**
+         * @brief Implementation of the memory deallocator.
+         * @param [in] addr Address of a previously allocated block to free.
+         * @param [in] bytes Number of bytes to deallocate (may be 0 if
+         *  unknown).
+         * @param [in] alignment Alignment constraint (power of 2).
+         * @par Returns
+         *  Nothing.
+         */
+        virtual void
+        do_deallocate (void* addr, std::size_t bytes,
+                       std::size_t alignment) noexcept override;
+
+        /**
+         * @brief Implementation of the function to get max size.
+         * @par Parameters
+         *  None.
+         * @return Integer with size in bytes, or 0 if unknown.
+         */
+        virtual std::size_t
+        do_max_size (void) const noexcept override;
+
+        /**
+         * @brief Implementation of the function to reset the memory manager.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        virtual void
+        do_reset (void) noexcept override;
+
+        /**
+         * @brief Implementation of the function to resize a block in place.
+         * @param [in] addr Address of a previously allocated block.
+         * @param [in] bytes New size, in bytes.
+         * @retval true if the block was resized.
+         * @retval false if the operation was ineffective.
+         */
+        virtual bool
+        do_resize (void* addr, std::size_t bytes) noexcept override;
+
+        /**
+         * @brief Implementation of the function to get the usable size.
+         * @param [in] addr Address of a previously allocated block.
+         * @return Number of bytes or 0 if unknown.
+         */
+        virtual std::size_t
+        do_usable_size (void* addr) noexcept override;
+
+        /**
+         * @cond ignore
+         */
+
+        class size_class;
+
+        size_class*
+        internal_class_of_ (void* addr) noexcept;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @cond ignore
+         */
+
+        void
+        internal_construct_ (void* addr, std::size_t bytes,
+                             std::size_t slab_bytes,
+                             const std::size_t* class_sizes,
+                             std::size_t classes,
+                             std::size_t page_size_bytes);
+
+        void
+        internal_reset_ (void) noexcept;
+
+        void*
+        internal_class_allocate_ (std::size_t index) noexcept;
+
+        void
+        internal_update_statistics_ (void) noexcept;
+
+        static void*
+        internal_fallback_address_ (void* addr, std::size_t slab_bytes);
+
+        static std::size_t
+        internal_fallback_size_bytes_ (std::size_t bytes,
+                                       std::size_t slab_bytes);
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @}
+         */
+
+      protected:
+        /**
+         * @cond ignore
+         */
+
+        class size_class
+        {
+        public:
+          // Block size, multiple of the max alignment.
+          std::size_t size_bytes;
+          // Single linked list of freed blocks.
+          void* free_list;
+          // Never used blocks in the current page.
+          char* bump;
+          char* bump_end;
+          std::size_t allocated_chunks;
+        };
+
+        size_class classes_[max_classes];
+        std::size_t classes_count_ = 0;
+
+        // Pages are assigned to size classes on demand.
+        char* pages_address_ = nullptr;
+        uint8_t* page_classes_ = nullptr;
+        std::size_t pages_ = 0;
+        std::size_t pages_used_ = 0;
+        std::size_t page_size_bytes_ = 0;
+
+        std::size_t slab_allocated_bytes_ = 0;
+        std::size_t slab_allocated_chunks_ = 0;
+
+        // Large requests go to a general allocator, which
+        // manages the rest of the arena; the block sizes are kept
+        // for usable_size().
+        sized_blocks<micro_os_plus::memory::first_fit_top> fallback_;
+
+        /**
+         * @endcond
+         */
+      };
+
+#pragma GCC diagnostic pop
+
+    } // namespace memory
+  } // namespace rtos
+} // namespace micro_os_plus
+
+// ===== Inline & template implementations ====================================
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace memory
+    {
+
+      // ======================================================================
+
+      inline std::size_t
+      slab::classes (void) const
+      {
+        return classes_count_;
+      }
+
+      inline std::size_t
+      slab::class_size (std::size_t index) const
+      {
+        assert (index < classes_count_);
+        return classes_[index].size_bytes;
+      }
+
+      inline std::size_t
+      slab::class_allocated_chunks (std::size_t index) const
+      {
+        assert (index < classes_count_);
+        return classes_[index].allocated_chunks;
+      }
+
+      inline std::size_t
+      slab::pages_used (void) const
+      {
+        return pages_used_;
+      }
+
+      inline std::size_t
+      slab::pages (void) const
+      {
+        return pages_;
+      }
+
+    } // namespace memory
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_RTOS_MEMORY_SLAB_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,514 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MICRO_OS_PLUS_RTOS_MEMORY_TIERED_H_
+#define MICRO_OS_PLUS_RTOS_MEMORY_TIERED_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/rtos.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wsuggest-final-methods"
+#pragma GCC diagnostic ignored "-Wsuggest-final-types"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace memory
+    {
+
+      // ======================================================================
+
+      /**
+       * @brief Placement hints for tiered allocations.
+       */
+      enum class placement : uint8_t
+      {
+        /**
+         * @brief No preference; the tiers are tried in order.
+         */
+        any = 0,
+
+        /**
+         * @brief Fast memory, for stacks and frequently used data.
+         */
+        hot = 1,
+
+        /**
+         * @brief Slow memory, for bulk buffers.
+         */
+        cold = 2,
+
+        /**
+         * @brief Memory reachable by DMA; no fallback.
+         */
+        dma = 3,
+      };
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+      /**
+       * @brief Memory resource spanning several memory regions,
+       * with placement hints.
+       * @headerfile memory-tiered.h <micro-os-plus/rtos/memory-tiered.h>
+       */
+      class tiered : public memory_resource
+      {
+      public:
+        /**
+         * @brief Maximum number of tiers.
+         */
+        static constexpr std::size_t max_tiers = 4;
+
+        /**
+         * @brief Number of placement hints.
+         */
+        static constexpr std::size_t placements = 4;
+
+        /**
+         * @brief Type of placement masks.
+         */
+        using placement_mask_t = uint8_t;
+
+        /**
+         * @brief Compute the mask of a placement.
+         * @param [in] hint The placement hint.
+         * @return The bit mask.
+         */
+        static constexpr placement_mask_t
+        mask (placement hint)
+        {
+          return static_cast<placement_mask_t> (
+              1u << static_cast<unsigned> (hint));
+        }
+
+        /**
+         * @brief Tier descriptor.
+         */
+        struct tier
+        {
+          /**
+           * @brief Pointer to the memory resource managing the region.
+           */
+          memory_resource* resource;
+
+          /**
+           * @brief Begin of the region.
+           */
+          void* address;
+
+          /**
+           * @brief Size of the region, in bytes.
+           */
+          std::size_t size_bytes;
+
+          /**
+           * @brief OR-ed masks of the placements the region is
+           * preferred for.
+           */
+          placement_mask_t placements;
+        };
+
+        /**
+         * @brief Memory resource forwarding to a tiered resource
+         * with a fixed placement hint.
+         */
+        class view : public memory_resource
+        {
+        public:
+          /**
+           * @name Constructors & Destructor
+           * @{
+           */
+
+          /**
+           * @brief Construct a view object instance.
+           */
+          view () = default;
+
+          /**
+           * @cond ignore
+           */
+
+          // The rule of five.
+          view (const view&) = delete;
+          view (view&&) = delete;
+          view&
+          operator= (const view&)
+              = delete;
+          view&
+          operator= (view&&)
+              = delete;
+
+          /**
+           * @endcond
+           */
+
+          /**
+           * @brief Destruct the view object instance.
+           */
+          virtual ~view () override = default;
+
+          /**
+           * @}
+           */
+
+          /**
+           * @brief Get the placement hint of the view.
+           * @par Parameters
+           *  None.
+           * @return The placement hint.
+           */
+          memory::placement
+          placement (void) const;
+
+        protected:
+          friend class tiered;
+
+          /**
+           * @name Private Member Functions
+           * @{
+           */
+
+          virtual void*
+          do_allocate (std::size_t bytes, std::size_t alignment) override;
+
+          virtual void
+          do_deallocate (void* addr, std::size_t bytes,
+                         std::size_t alignment) noexcept override;
+
+          virtual std::size_t
+          do_max_size (void) const noexcept override;
+
+          virtual bool
+          do_resize (void* addr, std::size_t bytes) noexcept override;
+
+          virtual std::size_t
+          do_usable_size (void* addr) noexcept override;
+
+          /**
+           * @}
+           */
+
+          /**
+           * @cond ignore
+           */
+
+          tiered* parent_ = nullptr;
+          memory::placement placement_ = memory::placement::any;
+
+          /**
+           * @endcond
+           */
+        };
+
+        // --------------------------------------------------------------------
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a tiered memory resource object instance.
+         * @param [in] name Pointer to name.
+         * @param [in] tiers Pointer to an array of tier descriptors,
+         *  in fallback order.
+         * @param [in] count Number of elements in the array.
+         */
+        tiered (const char* name, const tier* tiers, std::size_t count);
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        tiered (const tiered&) = delete;
+        tiered (tiered&&) = delete;
+        tiered&
+        operator= (const tiered&)
+            = delete;
+        tiered&
+        operator= (tiered&&)
+            = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the memory resource object instance.
+         */
+        virtual ~tiered () override;
+
+        /**
+         * @}
+         */
+
+      public:
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Allocate a memory block with a placement hint.
+         * @param [in] bytes Number of bytes to allocate.
+         * @param [in] hint Placement hint.
+         * @param [in] alignment Alignment constraint (power of 2).
+         * @return Pointer to newly allocated block, or `nullptr`.
+         */
+        void*
+        allocate (std::size_t bytes, memory::placement hint,
+                  std::size_t alignment = max_align);
+
+        using memory_resource::allocate;
+
+        /**
+         * @brief Get a memory resource with a fixed placement hint.
+         * @param [in] hint Placement hint.
+         * @return Reference to a memory resource.
+         */
+        memory_resource&
+        resource (memory::placement hint);
+
+        /**
+         * @brief Get the number of tiers.
+         * @par Parameters
+         *  None.
+         * @return Integer.
+         */
+        std::size_t
+        tiers (void) const;
+
+        /**
+         * @brief Get the memory resource of a tier.
+         * @param [in] index Index of the tier.
+         * @return Pointer to a memory resource.
+         */
+        memory_resource*
+        tier_resource (std::size_t index) const;
+
+        /**
+         * @brief Find the tier a block belongs to.
+         * @param [in] addr Address of a block.
+         * @return Index of the tier, or `tiers()` if not found.
+         */
+        std::size_t
+        tier_of (void* addr) const noexcept;
+
+        /**
+         * @}
+         */
+
+      protected:
+        /**
+         * @name Private Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Implementation of the memory allocator.
+         * @param [in] bytes Number of bytes to allocate.
+         * @param [in] alignment Alignment constraint (power of 2).
+         * @return Pointer to newly allocated block, or `nullptr`.
+         */
+        virtual void*
+        do_allocate (std::size_t bytes, std::size_t alignment) override;
+
+        /**
+         * @brief Implementation of the memory deallocator.
+         * @param [in] addr Address of a previously allocated block to free.
+         * @param [in] bytes Number of bytes to deallocate (may be 0 if
+         *  unknown).
+         * @param [in] alignment Alignment constraint (power of 2).
+         * @par Returns
+         *  Nothing.
+         */
+        virtual void
+        do_deallocate (void* addr, std::size_t bytes,
+                       std::size_t alignment) noexcept override;
+
+        /**
+         * @brief Implementation of the function to get max size.
+         * @par Parameters
+         *  None.
+         * @return Integer with size in bytes, or 0 if unknown.
+         */
+        virtual std::size_t
+        do_max_size (void) const noexcept override;
+
+        /**
+         * @brief Implementation of the function to reset the memory manager.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        virtual void
+        do_reset (void) noexcept override;
+
+        /**
+         * @brief Implementation of the function to coalesce free blocks.
+         * @par Parameters
+         *  None.
+         * @retval true if the operation resulted in larger blocks.
+         * @retval false if the operation was ineffective.
+         */
+        virtual bool
+        do_coalesce (void) noexcept override;
+
+        /**
+         * @brief Implementation of the function to resize a block in place.
+         * @param [in] addr Address of a previously allocated block.
+         * @param [in] bytes New size, in bytes.
+         * @retval true if the block was resized.
+         * @retval false if the operation was ineffective.
+         */
+        virtual bool
+        do_resize (void* addr, std::size_t bytes) noexcept override;
+
+        /**
+         * @brief Implementation of the function to get the usable size.
+         * @param [in] addr Address of a previously allocated block.
+         * @return Number of bytes or 0 if unknown.
+         */
+        virtual std::size_t
+        do_usable_size (void* addr) noexcept override;
+
+        /**
+         * @cond ignore
+         */
+
+        void*
+        internal_allocate_ (std::size_t bytes, memory::placement hint,
+                            std::size_t alignment) noexcept;
+
+        std::size_t
+        internal_max_size_ (memory::placement hint) const noexcept;
+
+        void
+        internal_update_statistics_ (void) noexcept;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @}
+         */
+
+      protected:
+        /**
+         * @cond ignore
+         */
+
+        tier tiers_[max_tiers];
+        std::size_t tiers_count_ = 0;
+
+        view views_[placements];
+
+        /**
+         * @endcond
+         */
+      };
+
+#pragma GCC diagnostic pop
+
+    } // namespace memory
+  } // namespace rtos
+} // namespace micro_os_plus
+
+// ===== Inline & template implementations ====================================
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace memory
+    {
+
+      // ======================================================================
+
+      inline memory::placement
+      tiered::view::placement (void) const
+      {
+        return placement_;
+      }
+
+      // ======================================================================
+
+      inline memory_resource&
+      tiered::resource (memory::placement hint)
+      {
+        assert (static_cast<std::size_t> (hint) < placements);
+        return views_[static_cast<std::size_t> (hint)];
+      }
+
+      inline std::size_t
+      tiered::tiers (void) const
+      {
+        return tiers_count_;
+      }
+
+      inline memory_resource*
+      tiered::tier_resource (std::size_t index) const
+      {
+        assert (index < tiers_count_);
+        return tiers_[index].resource;
+      }
+
+    } // namespace memory
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_RTOS_MEMORY_TIERED_H_
+
+// ----------------------------------------------------------------------------
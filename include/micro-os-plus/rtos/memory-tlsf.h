@@ -0,0 +1,316 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MICRO_OS_PLUS_RTOS_MEMORY_TLSF_H_
+#define MICRO_OS_PLUS_RTOS_MEMORY_TLSF_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/rtos.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wsuggest-final-methods"
+#pragma GCC diagnostic ignored "-Wsuggest-final-types"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace memory
+    {
+
+      // ======================================================================
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+      /**
+       * @brief Two-Level Segregated Fit memory resource.
+       * @headerfile memory-tlsf.h <micro-os-plus/rtos/memory-tlsf.h>
+       */
+      class tlsf : public memory_resource
+      {
+      public:
+        /**
+         * @brief Log2 of the number of second level lists.
+         */
+        static constexpr std::size_t sl_index_count_log2 = 4;
+
+        /**
+         * @brief Number of second level lists for each first level.
+         */
+        static constexpr std::size_t sl_index_count = 1u
+                                                      << sl_index_count_log2;
+
+        /**
+         * @brief Log2 of the block size granularity.
+         */
+        static constexpr std::size_t align_size_log2
+            = (memory_resource::max_align >= 16)  ? 4
+              : (memory_resource::max_align >= 8) ? 3
+                                                  : 2;
+
+        /**
+         * @brief Log2 of the limit of the block size.
+         */
+        static constexpr std::size_t fl_index_max
+            = (sizeof (std::size_t) >= 8) ? 32 : 30;
+
+        /**
+         * @brief Log2 of the size below which blocks are kept in
+         * linearly spaced lists.
+         */
+        static constexpr std::size_t fl_index_shift
+            = sl_index_count_log2 + align_size_log2;
+
+        /**
+         * @brief Number of first level lists.
+         */
+        static constexpr std::size_t fl_index_count
+            = fl_index_max - fl_index_shift + 1;
+
+        /**
+         * @brief Size of the block header, in bytes.
+         */
+        static constexpr std::size_t header_size_bytes
+            = align_size (2 * sizeof (void*), memory_resource::max_align);
+
+        /**
+         * @brief Minimum size of a block payload, in bytes.
+         */
+        static constexpr std::size_t min_block_size_bytes
+            = align_size (2 * sizeof (void*), memory_resource::max_align);
+
+        // --------------------------------------------------------------------
+
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a memory resource object instance.
+         * @param [in] addr Begin of allocator arena.
+         * @param [in] bytes Size of allocator arena, in bytes.
+         */
+        tlsf (void* addr, std::size_t bytes);
+
+        /**
+         * @brief Construct a named memory resource object instance.
+         * @param [in] name Pointer to name.
+         * @param [in] addr Begin of allocator arena.
+         * @param [in] bytes Size of allocator arena, in bytes.
+         */
+        tlsf (const char* name, void* addr, std::size_t bytes);
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        tlsf (const tlsf&) = delete;
+        tlsf (tlsf&&) = delete;
+        tlsf&
+        operator= (const tlsf&)
+            = delete;
+        tlsf&
+        operator= (tlsf&&)
+            = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the memory resource object instance.
+         */
+        virtual ~tlsf () override;
+
+        /**
+         * @}
+         */
+
+      protected:
+        /**
+         * @name Private Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Implementation of the memory allocator.
+         * @param [in] bytes Number of bytes to allocate.
+         * @param [in] alignment Alignment constraint (power of 2).
+         * @return Pointer to newly allocated block, or `nullptr`.
+         */
+        virtual void*
+        do_allocate (std::size_t bytes, std::size_t alignment) override;
+
+        /**
+         * @brief Implementation of the memory deallocator.
+         * @param [in] addr Address of a previously allocated block to free.
+         * @param [in] bytes Number of bytes to deallocate (may be 0 if
+         *  unknown).
+         * @param [in] alignment Alignment constraint (power of 2).
+         * @par Returns
+         *  Nothing.
+         */
+        virtual void
+        do_deallocate (void* addr, std::size_t bytes,
+                       std::size_t alignment) noexcept override;
+
+        /**
+         * @brief Implementation of the function to get max size.
+         * @par Parameters
+         *  None.
+         * @return Integer with size in bytes, or 0 if unknown.
+         */
+        virtual std::size_t
+        do_max_size (void) const noexcept override;
+
+        /**
+         * @brief Implementation of the function to reset the memory manager.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        virtual void
+        do_reset (void) noexcept override;
+
+        /**
+         * @brief Implementation of the function to resize a block in place.
+         * @param [in] addr Address of a previously allocated block.
+         * @param [in] bytes New size, in bytes.
+         * @retval true if the block was resized.
+         * @retval false if the operation was ineffective.
+         */
+        virtual bool
+        do_resize (void* addr, std::size_t bytes) noexcept override;
+
+        /**
+         * @brief Implementation of the function to get the usable size.
+         * @param [in] addr Address of a previously allocated block.
+         * @return Number of bytes.
+         */
+        virtual std::size_t
+        do_usable_size (void* addr) noexcept override;
+
+        /**
+         * @cond ignore
+         */
+
+        class block;
+
+        void
+        internal_construct_ (void* addr, std::size_t bytes);
+
+        void
+        internal_reset_ (void) noexcept;
+
+        static void
+        internal_mapping_insert_ (std::size_t size, std::size_t& fl,
+                                  std::size_t& sl) noexcept;
+
+        static bool
+        internal_mapping_search_ (std::size_t size, std::size_t& fl,
+                                  std::size_t& sl) noexcept;
+
+        block*
+        internal_find_suitable_ (std::size_t& fl, std::size_t& sl) noexcept;
+
+        void
+        internal_insert_ (block* blk) noexcept;
+
+        void
+        internal_remove_ (block* blk, std::size_t fl, std::size_t sl) noexcept;
+
+        void
+        internal_remove_ (block* blk) noexcept;
+
+        void
+        internal_split_ (block* blk, std::size_t size) noexcept;
+
+        block*
+        internal_merge_ (block* blk) noexcept;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @}
+         */
+
+      protected:
+        /**
+         * @cond ignore
+         */
+
+        void* arena_address_ = nullptr;
+        std::size_t arena_size_bytes_ = 0;
+
+        // Bitmaps of non empty lists.
+        uint32_t fl_bitmap_ = 0;
+        uint32_t sl_bitmap_[fl_index_count];
+
+        // Heads of the segregated free lists.
+        block* blocks_[fl_index_count][sl_index_count];
+
+        /**
+         * @endcond
+         */
+      };
+
+#pragma GCC diagnostic pop
+
+    } // namespace memory
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_RTOS_MEMORY_TLSF_H_
+
+// ----------------------------------------------------------------------------
@@ -147,6 +147,144 @@ namespace micro_os_plus
        * @}
        */
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER) || defined(__DOXYGEN__)
+
+      /**
+       * @brief Sampling heap profiler.
+       *
+       * @details
+       * On average, one allocation is sampled for every
+       * `sampling_interval()` bytes allocated via
+       * `memory_resource::allocate()`. The address, the size
+       * and the return address of the caller of the sampled blocks
+       * are kept in a fixed size table, until the blocks are freed.
+       *
+       * @note
+       *  Available only when
+       * `MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER` is defined.
+       */
+      namespace heap_profiler
+      {
+        /**
+         * @brief A live sampled allocation.
+         */
+        struct sample
+        {
+          /**
+           * @brief Address of the block.
+           */
+          void* address;
+
+          /**
+           * @brief Requested size of the block, in bytes.
+           */
+          std::size_t bytes;
+
+          /**
+           * @brief Return address of the allocating function.
+           */
+          void* caller;
+        };
+
+        /**
+         * @name Heap Profiler Functions
+         * @{
+         */
+
+        /**
+         * @brief Set the mean number of bytes between samples.
+         * @param [in] bytes Number of bytes; 0 disables sampling.
+         * @return The previous interval.
+         */
+        std::size_t
+        sampling_interval (std::size_t bytes) noexcept;
+
+        /**
+         * @brief Get the mean number of bytes between samples.
+         * @par Parameters
+         *  None.
+         * @return Number of bytes.
+         */
+        std::size_t
+        sampling_interval (void) noexcept;
+
+        /**
+         * @brief Possibly sample a new allocation.
+         * @param [in] addr Address of the allocated block.
+         * @param [in] bytes Requested size of the block.
+         * @param [in] caller Return address of the allocating function.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        record_allocation (void* addr, std::size_t bytes,
+                           void* caller) noexcept;
+
+        /**
+         * @brief Forget a sampled allocation, if any.
+         * @param [in] addr Address of the block being freed.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        record_deallocation (void* addr) noexcept;
+
+        /**
+         * @brief Update the size of a sampled allocation, if any.
+         * @param [in] addr Address of the resized block.
+         * @param [in] bytes New size of the block.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        record_resize (void* addr, std::size_t bytes) noexcept;
+
+        /**
+         * @brief Get the number of live sampled allocations.
+         * @par Parameters
+         *  None.
+         * @return Integer.
+         */
+        std::size_t
+        samples (void) noexcept;
+
+        /**
+         * @brief Get the number of samples lost because the table
+         * was full.
+         * @par Parameters
+         *  None.
+         * @return Integer.
+         */
+        std::size_t
+        dropped (void) noexcept;
+
+        /**
+         * @brief Copy the live sampled allocations.
+         * @param [out] buffer Pointer to an array of samples.
+         * @param [in] count Number of elements in the array.
+         * @return Number of samples copied.
+         */
+        std::size_t
+        snapshot (sample* buffer, std::size_t count) noexcept;
+
+        /**
+         * @brief Print the live sampled allocations, grouped
+         * by call site.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        trace_print (void);
+
+        /**
+         * @}
+         */
+      } // namespace heap_profiler
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
+
       // ======================================================================
       /**
        * @brief Type of out of memory handler.
@@ -281,6 +419,25 @@ namespace micro_os_plus
         std::size_t
         max_size (void) const noexcept;
 
+        /**
+         * @brief Resize a block in place.
+         * @param [in] addr Address of a previously allocated block.
+         * @param [in] bytes New size, in bytes.
+         * @retval true if the block now holds at least _bytes_ bytes,
+         *  at the same address.
+         * @retval false if the block cannot be resized in place.
+         */
+        bool
+        resize (void* addr, std::size_t bytes) noexcept;
+
+        /**
+         * @brief Get the number of bytes usable in a block.
+         * @param [in] addr Address of a previously allocated block.
+         * @return Number of bytes or 0 if unknown.
+         */
+        std::size_t
+        usable_size (void* addr) noexcept;
+
         /**
          * @brief Set the out of memory handler.
          * @param handler Pointer to new handler.
@@ -382,6 +539,101 @@ namespace micro_os_plus
          * @}
          */
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE) \
+    || defined(__DOXYGEN__)
+
+        /**
+         * @brief Number of buckets in the size histograms.
+         */
+        static constexpr std::size_t histogram_buckets = 12;
+
+        /**
+         * @brief Log2 of the upper limit of the first bucket.
+         */
+        static constexpr std::size_t histogram_min_size_log2 = 4;
+
+        /**
+         * @name Public Statistics Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Get the histogram bucket of a size.
+         * @param [in] bytes Number of bytes.
+         * @return The bucket index.
+         */
+        static std::size_t
+        histogram_bucket (std::size_t bytes) noexcept;
+
+        /**
+         * @brief Get the upper limit of a histogram bucket.
+         * @param [in] index The bucket index.
+         * @return Number of bytes, or 0 for the last, unlimited, bucket.
+         */
+        static std::size_t
+        histogram_bucket_size (std::size_t index) noexcept;
+
+        /**
+         * @brief Get the number of live blocks in a size bucket.
+         * @param [in] index The bucket index.
+         * @return Number of blocks.
+         */
+        std::size_t
+        histogram_live (std::size_t index);
+
+        /**
+         * @brief Get the number of allocations in a size bucket,
+         * since the memory resource was created.
+         * @param [in] index The bucket index.
+         * @return Number of allocations.
+         */
+        std::size_t
+        histogram_total (std::size_t index);
+
+        /**
+         * @brief Get the size of the largest free block.
+         * @par Parameters
+         *  None.
+         * @return Number of bytes or 0 if unknown.
+         */
+        std::size_t
+        largest_free_block (void) const noexcept;
+
+        /**
+         * @brief Get the fragmentation index.
+         * @par Parameters
+         *  None.
+         * @return Percent of the free memory not usable
+         *  for a single allocation, 0-100.
+         */
+        std::size_t
+        fragmentation (void) const noexcept;
+
+        /**
+         * @brief Get the number of failed allocations.
+         * @par Parameters
+         *  None.
+         * @return Number of allocations.
+         */
+        std::size_t
+        allocation_failures (void);
+
+        /**
+         * @brief Get the number of allocations that failed
+         * although there was enough free memory.
+         * @par Parameters
+         *  None.
+         * @return Number of allocations.
+         */
+        std::size_t
+        fragmentation_failures (void);
+
+        /**
+         * @}
+         */
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+
       protected:
         /**
          * @name Private Member Functions
@@ -448,6 +700,24 @@ namespace micro_os_plus
         virtual bool
         do_coalesce (void) noexcept;
 
+        /**
+         * @brief Implementation of the function to resize a block in place.
+         * @param [in] addr Address of a previously allocated block.
+         * @param [in] bytes New size, in bytes.
+         * @retval true if the block was resized.
+         * @retval false if the operation was ineffective.
+         */
+        virtual bool
+        do_resize (void* addr, std::size_t bytes) noexcept;
+
+        /**
+         * @brief Implementation of the function to get the usable size.
+         * @param [in] addr Address of a previously allocated block.
+         * @return Number of bytes or 0 if unknown.
+         */
+        virtual std::size_t
+        do_usable_size (void* addr) noexcept;
+
         /**
          * @brief Update statistics after allocation.
          * @param [in] bytes Number of allocated bytes.
@@ -466,6 +736,81 @@ namespace micro_os_plus
         void
         internal_decrease_allocated_statistics (std::size_t bytes) noexcept;
 
+        /**
+         * @brief Allocate from a nested memory resource.
+         * @param [in] mr Reference to the nested memory resource.
+         * @param bytes Number of bytes to allocate.
+         * @param alignment Alignment constraint (power of 2).
+         * @return Pointer to newly allocated block, or `nullptr`.
+         * @details
+         * Memory resources built on top of other memory resources
+         * call the nested implementation directly, so each block
+         * is counted and profiled only once, by the outer resource.
+         */
+        static void*
+        internal_forward_allocate (memory_resource& mr, std::size_t bytes,
+                                   std::size_t alignment);
+
+        /**
+         * @brief Deallocate to a nested memory resource.
+         * @param [in] mr Reference to the nested memory resource.
+         * @param addr Address of a previously allocated block to free.
+         * @param bytes Number of bytes to deallocate (may be 0 if unknown).
+         * @param alignment Alignment constraint (power of 2).
+         * @par Returns
+         *  Nothing.
+         */
+        static void
+        internal_forward_deallocate (memory_resource& mr, void* addr,
+                                     std::size_t bytes,
+                                     std::size_t alignment) noexcept;
+
+        /**
+         * @brief Resize a block of a nested memory resource in place.
+         * @param [in] mr Reference to the nested memory resource.
+         * @param [in] addr Address of a previously allocated block.
+         * @param [in] bytes New size, in bytes.
+         * @retval true if the block was resized.
+         * @retval false if the operation was ineffective.
+         */
+        static bool
+        internal_forward_resize (memory_resource& mr, void* addr,
+                                 std::size_t bytes) noexcept;
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+
+        /**
+         * @brief Update the histograms after allocation.
+         * @param [in] addr Address of the allocated block, or `nullptr`.
+         * @param [in] bytes Number of requested bytes.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        internal_record_allocation (void* addr, std::size_t bytes) noexcept;
+
+        /**
+         * @brief Update the histograms before deallocation.
+         * @param [in] addr Address of the block to deallocate.
+         * @param [in] bytes Number of bytes (may be 0 if unknown).
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        internal_record_deallocation (void* addr, std::size_t bytes) noexcept;
+
+        /**
+         * @brief Move the block to its new live bucket after resize.
+         * @param [in] addr Address of the resized block.
+         * @param [in] old_size Usable size before resize.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        internal_record_resize (void* addr, std::size_t old_size) noexcept;
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+
         /**
          * @}
          */
@@ -486,6 +831,15 @@ namespace micro_os_plus
         std::size_t allocations_ = 0;
         std::size_t deallocations_ = 0;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+        std::size_t histogram_live_[histogram_buckets] = {};
+        std::size_t histogram_total_[histogram_buckets] = {};
+        std::size_t allocation_failures_ = 0;
+        std::size_t fragmentation_failures_ = 0;
+        // Set when the memory resource cannot report block sizes.
+        bool histogram_live_unknown_ = false;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+
         /**
          * @endcond
          */
@@ -1290,11 +1644,36 @@ namespace micro_os_plus
        *
        * @see do_allocate();
        */
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
+      // Must be inlined even without optimisations, since the
+      // return address identifies the caller of the allocating
+      // function.
+      inline __attribute__ ((always_inline)) void*
+#else
       inline void*
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
       memory_resource::allocate (std::size_t bytes, std::size_t alignment)
       {
         ++allocations_;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
+        void* mem = do_allocate (bytes, alignment);
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+        internal_record_allocation (mem, bytes);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
+        if (mem != nullptr)
+          {
+            // Being always inlined, this is the caller of the
+            // allocating function, like `malloc()` or `operator new`.
+            heap_profiler::record_allocation (mem, bytes,
+                                              __builtin_return_address (0));
+          }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
+        return mem;
+#else
         return do_allocate (bytes, alignment);
+#endif
       }
 
       /**
@@ -1317,6 +1696,12 @@ namespace micro_os_plus
                                    std::size_t alignment) noexcept
       {
         ++deallocations_;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+        internal_record_deallocation (addr, bytes);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
+        heap_profiler::record_deallocation (addr);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
         do_deallocate (addr, bytes, alignment);
       }
 
@@ -1371,6 +1756,83 @@ namespace micro_os_plus
         return do_coalesce ();
       }
 
+      /**
+       * @details
+       * Try to grow or shrink the block without moving it, for example
+       * by merging it with the free block that follows. When
+       * shrinking, the released space is returned to the free store.
+       *
+       * @par Standard compliance
+       *   Extension to standard.
+       *
+       * @see do_resize();
+       */
+      inline bool
+      memory_resource::resize (void* addr, std::size_t bytes) noexcept
+      {
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+        // The live bucket depends on the usable size, which may change.
+        std::size_t old_size
+            = histogram_live_unknown_ ? 0 : do_usable_size (addr);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+        if (!do_resize (addr, bytes))
+          {
+            return false;
+          }
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+        internal_record_resize (addr, old_size);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
+        heap_profiler::record_resize (addr, bytes);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
+        return true;
+#else
+        return do_resize (addr, bytes);
+#endif
+      }
+
+      /**
+       * @details
+       * The usable size may be larger than the size requested when
+       * the block was allocated.
+       *
+       * @par Standard compliance
+       *   Extension to standard.
+       *
+       * @see do_usable_size();
+       */
+      inline std::size_t
+      memory_resource::usable_size (void* addr) noexcept
+      {
+        return do_usable_size (addr);
+      }
+
+      inline void*
+      memory_resource::internal_forward_allocate (memory_resource& mr,
+                                                  std::size_t bytes,
+                                                  std::size_t alignment)
+      {
+        return mr.do_allocate (bytes, alignment);
+      }
+
+      inline void
+      memory_resource::internal_forward_deallocate (
+          memory_resource& mr, void* addr, std::size_t bytes,
+          std::size_t alignment) noexcept
+      {
+        mr.do_deallocate (addr, bytes, alignment);
+      }
+
+      inline bool
+      memory_resource::internal_forward_resize (memory_resource& mr,
+                                                void* addr,
+                                                std::size_t bytes) noexcept
+      {
+        return mr.do_resize (addr, bytes);
+      }
+
       /**
        * @par Standard compliance
        *   Extension to standard.
@@ -1458,9 +1920,147 @@ namespace micro_os_plus
                        allocated_chunks (), free_bytes (), free_chunks (),
                        max_allocated_bytes (), allocations (),
                        deallocations ());
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+        trace::printf ("\tlargest free: %u bytes, fragmentation: %u%%, \n"
+                       "\tfailures: %u allocs, %u fragmented\n",
+                       largest_free_block (), fragmentation (),
+                       allocation_failures (), fragmentation_failures ());
+        if (histogram_live_unknown_)
+          {
+            trace::printf ("\tlive blocks unknown, sizes not reported\n");
+          }
+        for (std::size_t i = 0; i < histogram_buckets; ++i)
+          {
+            if (histogram_total_[i] == 0)
+              {
+                continue;
+              }
+            if (histogram_bucket_size (i) != 0)
+              {
+                trace::printf ("\t<= %u: %u live, %u total\n",
+                               histogram_bucket_size (i), histogram_live (i),
+                               histogram_total_[i]);
+              }
+            else
+              {
+                trace::printf ("\t>  %u: %u live, %u total\n",
+                               histogram_bucket_size (i - 1),
+                               histogram_live (i), histogram_total_[i]);
+              }
+          }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
 #endif // defined(TRACE)
       }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+
+      /**
+       * @details
+       * Bucket 0 holds sizes up to 16 bytes, and each following bucket
+       * doubles the limit; the last bucket holds all larger sizes.
+       *
+       * @par Standard compliance
+       *   Extension to standard.
+       */
+      inline std::size_t
+      memory_resource::histogram_bucket (std::size_t bytes) noexcept
+      {
+        if (bytes <= (static_cast<std::size_t> (1) << histogram_min_size_log2))
+          {
+            return 0;
+          }
+
+        // Number of bits needed to represent (bytes - 1).
+        std::size_t width
+            = sizeof (unsigned long) * 8
+              - static_cast<std::size_t> (__builtin_clzl (
+                  static_cast<unsigned long> (bytes - 1)));
+        std::size_t index = width - histogram_min_size_log2;
+
+        return (index < histogram_buckets) ? index : histogram_buckets - 1;
+      }
+
+      /**
+       * @par Standard compliance
+       *   Extension to standard.
+       */
+      inline std::size_t
+      memory_resource::histogram_bucket_size (std::size_t index) noexcept
+      {
+        if (index >= histogram_buckets - 1)
+          {
+            return 0;
+          }
+
+        return static_cast<std::size_t> (1)
+               << (histogram_min_size_log2 + index);
+      }
+
+      /**
+       * @details
+       * The blocks are counted by their usable size. If the memory
+       * resource cannot report the block sizes (for example
+       * `first_fit_top`, unless adapted with `sized_blocks<>`), the
+       * live blocks cannot be accounted when freed, and 0 is returned.
+       *
+       * @par Standard compliance
+       *   Extension to standard.
+       */
+      inline std::size_t
+      memory_resource::histogram_live (std::size_t index)
+      {
+        assert (index < histogram_buckets);
+        return histogram_live_unknown_ ? 0 : histogram_live_[index];
+      }
+
+      /**
+       * @details
+       * The allocations are counted by the requested size.
+       *
+       * @par Standard compliance
+       *   Extension to standard.
+       */
+      inline std::size_t
+      memory_resource::histogram_total (std::size_t index)
+      {
+        assert (index < histogram_buckets);
+        return histogram_total_[index];
+      }
+
+      /**
+       * @par Standard compliance
+       *   Extension to standard.
+       *
+       * @see do_max_size();
+       */
+      inline std::size_t
+      memory_resource::largest_free_block (void) const noexcept
+      {
+        return do_max_size ();
+      }
+
+      /**
+       * @par Standard compliance
+       *   Extension to standard.
+       */
+      inline std::size_t
+      memory_resource::allocation_failures (void)
+      {
+        return allocation_failures_;
+      }
+
+      /**
+       * @par Standard compliance
+       *   Extension to standard.
+       */
+      inline std::size_t
+      memory_resource::fragmentation_failures (void)
+      {
+        return fragmentation_failures_;
+      }
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+
       // ======================================================================
 
       inline bool
@@ -267,6 +267,184 @@ namespace micro_os_plus
                   & ~(sizeof (T) - 1));
       }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE) \
+    || defined(__DOXYGEN__)
+
+      // ======================================================================
+
+      /**
+       * @brief Message queue statistics.
+       * @headerfile os.h <micro-os-plus/rtos.h>
+       * @ingroup micro-os-plus-rtos-mqueue
+       *
+       * @note Available only when
+       * @ref MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE is defined.
+       */
+      class statistics
+      {
+      public:
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a message queue statistics object instance.
+         * @par Parameters
+         *  None.
+         */
+        statistics () = default;
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        statistics (const statistics&) = delete;
+        statistics (statistics&&) = delete;
+        statistics&
+        operator= (const statistics&)
+            = delete;
+        statistics&
+        operator= (statistics&&)
+            = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the message queue statistics object instance.
+         */
+        ~statistics () = default;
+
+        /**
+         * @}
+         */
+
+      public:
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Get the number of messages sent.
+         * @par Parameters
+         *  None.
+         * @return A long integer.
+         */
+        rtos::statistics::counter_t
+        sends (void) const;
+
+        /**
+         * @brief Get the number of messages received.
+         * @par Parameters
+         *  None.
+         * @return A long integer.
+         */
+        rtos::statistics::counter_t
+        receives (void) const;
+
+        /**
+         * @brief Get the high-water mark.
+         * @par Parameters
+         *  None.
+         * @return The largest number of messages that were in the queue.
+         */
+        std::size_t
+        length_max (void) const;
+
+        /**
+         * @brief Get the number of senders that had to wait.
+         * @par Parameters
+         *  None.
+         * @return A long integer.
+         */
+        rtos::statistics::counter_t
+        blocked_senders (void) const;
+
+        /**
+         * @brief Get the number of receivers that had to wait.
+         * @par Parameters
+         *  None.
+         * @return A long integer.
+         */
+        rtos::statistics::counter_t
+        blocked_receivers (void) const;
+
+        /**
+         * @brief Get the number of timed sends that timed out.
+         * @par Parameters
+         *  None.
+         * @return A long integer.
+         */
+        rtos::statistics::counter_t
+        send_timeouts (void) const;
+
+        /**
+         * @brief Get the number of timed receives that timed out.
+         * @par Parameters
+         *  None.
+         * @return A long integer.
+         */
+        rtos::statistics::counter_t
+        receive_timeouts (void) const;
+
+        /**
+         * @brief Get the time spent with the queue full.
+         * @par Parameters
+         *  None.
+         * @return Number of CPU cycles.
+         */
+        rtos::statistics::duration_t
+        full_cycles (void);
+
+        /**
+         * @brief Get the time spent with the queue empty.
+         * @par Parameters
+         *  None.
+         * @return Number of CPU cycles.
+         */
+        rtos::statistics::duration_t
+        empty_cycles (void);
+
+        /**
+         * @brief Clear the measurements.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        clear (void);
+
+        /**
+         * @}
+         */
+
+      protected:
+        /**
+         * @cond ignore
+         */
+
+        friend class message_queue;
+
+        rtos::statistics::counter_t sends_ = 0;
+        rtos::statistics::counter_t receives_ = 0;
+        rtos::statistics::counter_t blocked_senders_ = 0;
+        rtos::statistics::counter_t blocked_receivers_ = 0;
+        rtos::statistics::counter_t send_timeouts_ = 0;
+        rtos::statistics::counter_t receive_timeouts_ = 0;
+        rtos::statistics::occupancy occupancy_;
+
+        /**
+         * @endcond
+         */
+      };
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
       // ======================================================================
 
       /**
@@ -552,6 +730,19 @@ namespace micro_os_plus
       result_t
       reset (void);
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
+      /**
+       * @brief Get the message queue statistics.
+       * @par Parameters
+       *  None.
+       * @return A reference to the statistics object instance.
+       */
+      message_queue::statistics&
+      statistics (void);
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
       /**
        * @}
        */
@@ -698,6 +889,10 @@ namespace micro_os_plus
        */
       const void* allocator_ = nullptr;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      friend class object_registry;
+#endif
+
 #if defined(MICRO_OS_PLUS_USE_RTOS_PORT_MESSAGE_QUEUE)
       friend class port::message_queue;
       micro_os_plus_message_queue_port_data_t port_;
@@ -733,6 +928,10 @@ namespace micro_os_plus
       index_t head_ = 0;
 #endif // !defined(MICRO_OS_PLUS_USE_RTOS_PORT_MESSAGE_QUEUE)
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+      class statistics statistics_;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
       /**
        * @endcond
        */
@@ -1348,6 +1547,124 @@ namespace micro_os_plus
       return (length () == capacity ());
     }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
+    /**
+     * @note This function is available only when
+     * @ref MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE
+     * is defined.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline class message_queue::statistics&
+    message_queue::statistics (void)
+    {
+      return statistics_;
+    }
+
+    // ========================================================================
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    message_queue::statistics::sends (void) const
+    {
+      return sends_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    message_queue::statistics::receives (void) const
+    {
+      return receives_;
+    }
+
+    /**
+     * @details
+     * Compare it with `capacity()` to size the queue; a value
+     * always below the capacity means the queue can be shortened.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    message_queue::statistics::length_max (void) const
+    {
+      return occupancy_.count_max ();
+    }
+
+    /**
+     * @details
+     * The counter is incremented once for each `send()` or
+     * `timed_send()` call that found the queue full.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    message_queue::statistics::blocked_senders (void) const
+    {
+      return blocked_senders_;
+    }
+
+    /**
+     * @details
+     * The counter is incremented once for each `receive()` or
+     * `timed_receive()` call that found the queue empty.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    message_queue::statistics::blocked_receivers (void) const
+    {
+      return blocked_receivers_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    message_queue::statistics::send_timeouts (void) const
+    {
+      return send_timeouts_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    message_queue::statistics::receive_timeouts (void) const
+    {
+      return receive_timeouts_;
+    }
+
+    /**
+     * @details
+     * If the queue is currently full, the ongoing interval is included.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    message_queue::statistics::full_cycles (void)
+    {
+      return occupancy_.full_cycles ();
+    }
+
+    /**
+     * @details
+     * If the queue is currently empty, the ongoing interval is included.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    message_queue::statistics::empty_cycles (void)
+    {
+      return occupancy_.empty_cycles ();
+    }
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
     // ========================================================================
 
     /**
@@ -350,6 +350,219 @@ namespace micro_os_plus
        */
       static const attributes_recursive initializer_recursive;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX) \
+    || defined(__DOXYGEN__)
+
+      // ======================================================================
+
+      /**
+       * @brief Mutex statistics.
+       * @headerfile os.h <micro-os-plus/rtos.h>
+       * @ingroup micro-os-plus-rtos-mutex
+       *
+       * @note Available only when
+       * @ref MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX is defined.
+       */
+      class statistics
+      {
+      public:
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a mutex statistics object instance.
+         * @par Parameters
+         *  None.
+         */
+        statistics () = default;
+
+        /**
+         * @cond ignore
+         */
+
+        // The rule of five.
+        statistics (const statistics&) = delete;
+        statistics (statistics&&) = delete;
+        statistics&
+        operator= (const statistics&)
+            = delete;
+        statistics&
+        operator= (statistics&&)
+            = delete;
+
+        /**
+         * @endcond
+         */
+
+        /**
+         * @brief Destruct the mutex statistics object instance.
+         */
+        ~statistics () = default;
+
+        /**
+         * @}
+         */
+
+      public:
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Get the number of times the mutex was acquired.
+         * @par Parameters
+         *  None.
+         * @return A long integer; recursive relocks are not counted.
+         */
+        rtos::statistics::counter_t
+        acquisitions (void);
+
+        /**
+         * @brief Get the number of times a thread had to wait.
+         * @par Parameters
+         *  None.
+         * @return A long integer.
+         */
+        rtos::statistics::counter_t
+        contentions (void);
+
+        /**
+         * @brief Get the accumulated wait time.
+         * @par Parameters
+         *  None.
+         * @return Number of CPU cycles.
+         */
+        rtos::statistics::duration_t
+        wait_cycles_total (void);
+
+        /**
+         * @brief Get the longest wait time.
+         * @par Parameters
+         *  None.
+         * @return Number of CPU cycles.
+         */
+        rtos::statistics::duration_t
+        wait_cycles_max (void);
+
+        /**
+         * @brief Get the accumulated hold time.
+         * @par Parameters
+         *  None.
+         * @return Number of CPU cycles.
+         */
+        rtos::statistics::duration_t
+        hold_cycles_total (void);
+
+        /**
+         * @brief Get the longest hold time.
+         * @par Parameters
+         *  None.
+         * @return Number of CPU cycles.
+         */
+        rtos::statistics::duration_t
+        hold_cycles_max (void);
+
+        /**
+         * @brief Get the name of the thread that waited longest.
+         * @par Parameters
+         *  None.
+         * @return Pointer to name, or `nullptr` if no thread waited.
+         */
+        const char*
+        longest_waiter (void);
+
+        /**
+         * @brief Get the address of the thread that waited longest.
+         * @par Parameters
+         *  None.
+         * @return Address of the thread, or `nullptr` if no thread waited.
+         */
+        const void*
+        longest_waiter_address (void);
+
+        /**
+         * @brief Clear the measurements.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        clear (void);
+
+        /**
+         * @}
+         */
+
+        /**
+         * @name Public Static Functions
+         * @{
+         */
+
+        /**
+         * @brief Rank the existing mutexes by contention.
+         * @param [out] mutexes Pointer to an array of mutex pointers.
+         * @param [in] count Number of elements in the array.
+         * @return The number of pointers stored in the array.
+         */
+        static std::size_t
+        rank (mutex** mutexes, std::size_t count);
+
+        /**
+         * @brief Print the statistics of all mutexes on the trace channel.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        static void
+        trace_print (void);
+
+        /**
+         * @}
+         */
+
+      protected:
+        /**
+         * @cond ignore
+         */
+
+        friend class mutex;
+
+        void
+        internal_record_acquisition_ (void);
+
+        void
+        internal_record_release_ (void);
+
+        void
+        internal_record_wait_ (thread& th,
+                               rtos::statistics::duration_t timestamp);
+
+        rtos::statistics::counter_t acquisitions_ = 0;
+        rtos::statistics::counter_t contentions_ = 0;
+        rtos::statistics::duration_t wait_cycles_total_ = 0;
+        rtos::statistics::duration_t wait_cycles_max_ = 0;
+        rtos::statistics::duration_t hold_cycles_total_ = 0;
+        rtos::statistics::duration_t hold_cycles_max_ = 0;
+        // Timestamp of the last acquisition.
+        rtos::statistics::duration_t hold_timestamp_ = 0;
+        // Only identifies the thread, it is never dereferenced.
+        const void* longest_waiter_ = nullptr;
+        char longest_waiter_name_
+            [MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_MUTEX_WAITER_NAME_SIZE]
+            = {};
+
+        /**
+         * @endcond
+         */
+      };
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
       /**
        * @name Constructors & Destructor
        * @{
@@ -595,6 +808,19 @@ namespace micro_os_plus
       result_t
       reset (void);
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
+      /**
+       * @brief Get the mutex statistics.
+       * @par Parameters
+       *  None.
+       * @return A reference to the statistics object instance.
+       */
+      mutex::statistics&
+      statistics (void);
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
       /**
        * @}
        */
@@ -671,6 +897,10 @@ namespace micro_os_plus
       utils::double_list_links owner_links_;
 
     protected:
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      friend class object_registry;
+#endif
+
 #if defined(MICRO_OS_PLUS_USE_RTOS_PORT_MUTEX)
       friend class port::mutex;
       micro_os_plus_mutex_port_data_t port_;
@@ -696,6 +926,19 @@ namespace micro_os_plus
       const robustness_t robustness_; // stalled, robust
       const count_t max_count_;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+#if !defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+    public:
+      // Intrusive node used to link this mutex to the list of
+      // mutexes with statistics; with the object registry, its
+      // list of mutexes is used instead.
+      utils::double_list_links statistics_links_;
+
+    protected:
+#endif // !defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      class statistics statistics_;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
       // Add more internal data.
 
       /**
@@ -865,6 +1108,124 @@ namespace micro_os_plus
       return robustness_;
     }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
+    /**
+     * @note This function is available only when
+     * @ref MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX
+     * is defined.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline class mutex::statistics&
+    mutex::statistics (void)
+    {
+      return statistics_;
+    }
+
+    // ========================================================================
+
+    /**
+     * @details
+     * The counter is incremented when a thread becomes the owner
+     * of an unlocked mutex, regardless of whether it had to wait.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    mutex::statistics::acquisitions (void)
+    {
+      return acquisitions_;
+    }
+
+    /**
+     * @details
+     * The counter is incremented when `lock()` or `timed_lock()`
+     * find the mutex owned by another thread; failed `try_lock()`
+     * calls are not counted.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    mutex::statistics::contentions (void)
+    {
+      return contentions_;
+    }
+
+    /**
+     * @details
+     * Waits that end with a timeout or an interruption are
+     * also accumulated.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    mutex::statistics::wait_cycles_total (void)
+    {
+      return wait_cycles_total_;
+    }
+
+    /**
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    mutex::statistics::wait_cycles_max (void)
+    {
+      return wait_cycles_max_;
+    }
+
+    /**
+     * @details
+     * The hold time is measured from the first lock to the final
+     * unlock; recursive relocks do not restart it.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    mutex::statistics::hold_cycles_total (void)
+    {
+      return hold_cycles_total_;
+    }
+
+    /**
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    mutex::statistics::hold_cycles_max (void)
+    {
+      return hold_cycles_max_;
+    }
+
+    /**
+     * @details
+     * A copy of the name is kept, so it remains valid after the
+     * thread is destroyed; it is truncated to
+     * `MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_MUTEX_WAITER_NAME_SIZE` - 1
+     * characters.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline const char*
+    mutex::statistics::longest_waiter (void)
+    {
+      return (longest_waiter_ != nullptr) ? longest_waiter_name_ : nullptr;
+    }
+
+    /**
+     * @details
+     * The address tells apart threads with the same name; the
+     * thread may have been destroyed, so it must not be dereferenced.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline const void*
+    mutex::statistics::longest_waiter_address (void)
+    {
+      return longest_waiter_;
+    }
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
     // ========================================================================
 
     inline mutex_recursive::mutex_recursive (const attributes& _attributes)
@@ -0,0 +1,268 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MICRO_OS_PLUS_RTOS_OBJECT_REGISTRY_H_
+#define MICRO_OS_PLUS_RTOS_OBJECT_REGISTRY_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY) || defined(__DOXYGEN__)
+
+// ----------------------------------------------------------------------------
+
+#include <cstdint>
+#include <cstddef>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    // ========================================================================
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+    /**
+     * @brief Registry of the system objects.
+     * @headerfile object-registry.h <micro-os-plus/rtos/object-registry.h>
+     * @ingroup micro-os-plus-rtos-core
+     *
+     * @details
+     * Threads, mutexes, condition variables, semaphores, event flags,
+     * message queues, memory pools and timers link themselves
+     * into the registry when constructed, and unlink when destroyed,
+     * via an intrusive node in `internal::object_named_system`,
+     * so no storage is allocated.
+     *
+     * The registry can be enumerated at run time with `snapshot()`,
+     * which copies the state of each object into a caller buffer,
+     * for example to be displayed on a console.
+     *
+     * @note Available only when
+     * `MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY` is defined.
+     */
+    class object_registry
+    {
+    public:
+      /**
+       * @brief Type of the registered objects.
+       */
+      enum class kind : uint8_t
+      {
+        thread = 0,
+        mutex = 1,
+        condition_variable = 2,
+        semaphore = 3,
+        event_flags = 4,
+        message_queue = 5,
+        memory_pool = 6,
+        timer = 7
+      };
+
+      /**
+       * @brief Number of object types.
+       */
+      static constexpr std::size_t kinds = 8;
+
+      /**
+       * @brief State of an object, as captured by `snapshot()`.
+       * @details
+       * The meaning of the generic members depends on the object type:
+       *
+       * - thread: `state` is the thread state, `count` the available
+       *   stack bytes, `capacity` the stack size, `events` the context
+       *   switches and `cycles` the CPU cycles;
+       * - mutex: `count` is the lock count, `capacity` the max count,
+       *   `events` the contentions and `cycles` the wait cycles;
+       * - semaphore: `count` is the value, `capacity` the max value;
+       * - event flags: `count` is the mask of raised flags;
+       * - message queue: `count` is the length, `capacity` the max
+       *   number of messages, `events` the sends and `cycles` the
+       *   time spent full;
+       * - memory pool: `count` is the number of allocated blocks,
+       *   `capacity` the number of blocks, `events` the allocations
+       *   and `cycles` the time spent full;
+       * - timer: `state` is the timer state, `count` the period.
+       *
+       * The statistics are zero when the corresponding
+       * `MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_*` option is not
+       * defined.
+       */
+      class entry
+      {
+      public:
+        const void* object;
+        const char* name;
+        // For mutexes, the owner thread.
+        const void* owner;
+        kind type;
+        uint8_t state;
+        // For threads, the priority.
+        uint8_t priority;
+        // Number of threads waiting for the object.
+        uint16_t waiters;
+        uint32_t count;
+        uint32_t capacity;
+        statistics::counter_t events;
+        statistics::duration_t cycles;
+      };
+
+      // ----------------------------------------------------------------------
+
+      /**
+       * @cond ignore
+       */
+
+      object_registry () = delete;
+
+      /**
+       * @endcond
+       */
+
+      // ----------------------------------------------------------------------
+
+      /**
+       * @name Public Static Functions
+       * @{
+       */
+
+      /**
+       * @brief Get the number of registered objects.
+       * @par Parameters
+       *  None.
+       * @return Integer.
+       */
+      static std::size_t
+      size (void);
+
+      /**
+       * @brief Get the registry change counter.
+       * @par Parameters
+       *  None.
+       * @return The number of objects linked or unlinked since startup.
+       */
+      static uint32_t
+      changes (void);
+
+      /**
+       * @brief Capture the state of the registered objects.
+       * @param [out] entries Pointer to an array of entries.
+       * @param [in] count Number of elements in the array.
+       * @param [in] first Number of objects to skip, to
+       *  enumerate the registry in pages.
+       * @return The number of entries stored in the array.
+       */
+      static std::size_t
+      snapshot (entry* entries, std::size_t count, std::size_t first = 0);
+
+      /**
+       * @brief Get the name of an object type.
+       * @param [in] type The object type.
+       * @return A null terminated string.
+       */
+      static const char*
+      kind_name (kind type);
+
+      /**
+       * @brief Print the registered objects on the trace channel.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      static void
+      trace_print (void);
+
+      /**
+       * @}
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      using objects_list = utils::intrusive_list<
+          internal::object_named_system, utils::double_list_links,
+          &internal::object_named_system::registry_links_>;
+
+      // Must be walked with the scheduler locked.
+      static objects_list&
+      internal_list_ (kind type);
+
+      static void
+      internal_link_ (internal::object_named_system& object, kind type);
+
+      static void
+      internal_unlink_ (internal::object_named_system& object);
+
+      /**
+       * @endcond
+       */
+
+    protected:
+      /**
+       * @cond ignore
+       */
+
+      static void
+      internal_capture_ (internal::object_named_system& object, kind type,
+                         entry& e);
+
+      /**
+       * @endcond
+       */
+    };
+
+#pragma GCC diagnostic pop
+
+    // ========================================================================
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_RTOS_OBJECT_REGISTRY_H_
+
+// ----------------------------------------------------------------------------
@@ -36,6 +36,7 @@
 
 #include <micro-os-plus/rtos/declarations.h>
 #include <micro-os-plus/rtos/clocks.h>
+#include <micro-os-plus/rtos/critical-section-profiler.h>
 
 // ----------------------------------------------------------------------------
 
@@ -917,11 +918,17 @@ namespace micro_os_plus
        *
        * @warning Cannot be invoked from Interrupt Service Routines.
        */
-      inline critical_section::critical_section () : state_ (lock ())
+      inline __attribute__ ((always_inline))
+      critical_section::critical_section ()
+          : state_ (lock ())
       {
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_SCHEDULER)
         trace::printf (" {c ");
 #endif
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_CRITICAL_SECTION_PROFILER)
+        critical_section_profiler::internal_enter_ (
+            critical_section_profiler::kind::scheduler);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_CRITICAL_SECTION_PROFILER)
       }
 
       /**
@@ -931,11 +938,16 @@ namespace micro_os_plus
        *
        * @warning Cannot be invoked from Interrupt Service Routines.
        */
-      inline critical_section::~critical_section ()
+      inline __attribute__ ((always_inline))
+      critical_section::~critical_section ()
       {
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_SCHEDULER)
         trace::printf (" c} ");
 #endif
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_CRITICAL_SECTION_PROFILER)
+        critical_section_profiler::internal_exit_ (
+            critical_section_profiler::kind::scheduler);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_CRITICAL_SECTION_PROFILER)
         locked (state_);
       }
 
@@ -1090,7 +1102,10 @@ namespace micro_os_plus
       critical_section::critical_section ()
           : state_ (enter ())
       {
-        ;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_CRITICAL_SECTION_PROFILER)
+        critical_section_profiler::internal_enter_ (
+            critical_section_profiler::kind::interrupts);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_CRITICAL_SECTION_PROFILER)
       }
 
       /**
@@ -1099,6 +1114,10 @@ namespace micro_os_plus
       inline __attribute__ ((always_inline))
       critical_section::~critical_section ()
       {
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_CRITICAL_SECTION_PROFILER)
+        critical_section_profiler::internal_exit_ (
+            critical_section_profiler::kind::interrupts);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_CRITICAL_SECTION_PROFILER)
         exit (state_);
       }
 
@@ -475,6 +475,10 @@ namespace micro_os_plus
       clock* clock_ = nullptr;
 #endif
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      friend class object_registry;
+#endif
+
 #if defined(MICRO_OS_PLUS_USE_RTOS_PORT_SEMAPHORE)
       friend class port::semaphore;
       micro_os_plus_semaphore_port_data_t port_;
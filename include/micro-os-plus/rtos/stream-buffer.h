@@ -0,0 +1,1216 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MICRO_OS_PLUS_RTOS_STREAM_BUFFER_H_
+#define MICRO_OS_PLUS_RTOS_STREAM_BUFFER_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/rtos/declarations.h>
+#include <micro-os-plus/rtos/memory.h>
+
+#include <micro-os-plus/diag/trace.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wsuggest-final-methods"
+#pragma GCC diagnostic ignored "-Wsuggest-final-types"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+
+    // ========================================================================
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+    /**
+     * @brief Synchronised **stream buffer** of variable length records,
+     * using the default RTOS allocator.
+     * @headerfile os.h <micro-os-plus/rtos.h>
+     * @ingroup micro-os-plus-rtos-sbuffer
+     */
+    class stream_buffer : public internal::object_named_system
+    {
+    public:
+      // ======================================================================
+
+      /**
+       * @brief Type of record size storage.
+       * @details
+       * Each record is prefixed by its length, stored on
+       * this type, usually a 16-bits unsigned value.
+       * @ingroup micro-os-plus-rtos-sbuffer
+       */
+      using record_size_t = uint16_t;
+
+      /**
+       * @brief Maximum record size.
+       * @ingroup micro-os-plus-rtos-sbuffer
+       */
+      static constexpr record_size_t max_record_size = 0xFFFF;
+
+      /**
+       * @brief Size of the record header.
+       * @ingroup micro-os-plus-rtos-sbuffer
+       */
+      static constexpr std::size_t record_header_size_bytes
+          = sizeof (record_size_t);
+
+      // ======================================================================
+
+      /**
+       * @brief Stream buffer attributes.
+       * @headerfile os.h <micro-os-plus/rtos.h>
+       * @ingroup micro-os-plus-rtos-sbuffer
+       */
+      class attributes : public internal::attributes_clocked
+      {
+      public:
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a stream buffer attributes object instance.
+         * @par Parameters
+         *  None.
+         */
+        constexpr attributes ();
+
+        // The rule of five.
+        attributes (const attributes&) = default;
+        attributes (attributes&&) = default;
+        attributes&
+        operator= (const attributes&)
+            = default;
+        attributes&
+        operator= (attributes&&)
+            = default;
+
+        /**
+         * @brief Destruct the stream buffer attributes object instance.
+         */
+        ~attributes () = default;
+
+        /**
+         * @}
+         */
+
+      public:
+        /**
+         * @name Public Member Variables
+         * @{
+         */
+
+        // Public members; no accessors and mutators required.
+
+        /**
+         * @brief Address of the user defined storage for the stream buffer.
+         */
+        void* arena_address = nullptr;
+
+        /**
+         * @brief Size of the user defined storage for the stream buffer.
+         */
+        std::size_t arena_size_bytes = 0;
+
+        /**
+         * @brief Number of buffered bytes required to wake a reader.
+         */
+        std::size_t trigger_level_bytes = 1;
+
+        // Add more attributes here.
+
+        /**
+         * @}
+         */
+
+      }; /* class attributes */
+
+      /**
+       * @brief Default stream buffer initialiser.
+       * @ingroup micro-os-plus-rtos-sbuffer
+       */
+      static const attributes initializer;
+
+      // ======================================================================
+
+      /**
+       * @brief Description of a record stored in the buffer.
+       * @headerfile os.h <micro-os-plus/rtos.h>
+       * @ingroup micro-os-plus-rtos-sbuffer
+       * @details
+       * Records are stored contiguously in a ring, thus the payload
+       * of a record may wrap around the end of the buffer. For
+       * zero-copy access, the payload is described by two spans;
+       * when the record does not wrap, the second span is empty.
+       */
+      class spans
+      {
+      public:
+        /**
+         * @name Public Member Variables
+         * @{
+         */
+
+        /**
+         * @brief Address of the first part of the record.
+         */
+        const void* first_address = nullptr;
+
+        /**
+         * @brief Size of the first part of the record.
+         */
+        std::size_t first_size_bytes = 0;
+
+        /**
+         * @brief Address of the second part of the record, if wrapped.
+         */
+        const void* second_address = nullptr;
+
+        /**
+         * @brief Size of the second part of the record, if wrapped.
+         */
+        std::size_t second_size_bytes = 0;
+
+        /**
+         * @}
+         */
+
+        /**
+         * @name Public Member Functions
+         * @{
+         */
+
+        /**
+         * @brief Get the total record size.
+         * @par Parameters
+         *  None.
+         * @return The sum of both spans, in bytes.
+         */
+        std::size_t
+        size_bytes (void) const;
+
+        /**
+         * @}
+         */
+      };
+
+      // ======================================================================
+
+      /**
+       * @brief Default RTOS allocator.
+       * @ingroup micro-os-plus-rtos-sbuffer
+       */
+      using allocator_type
+          = memory::allocator<thread::stack::allocation_element_t>;
+
+      /**
+       * @brief Storage for a stream buffer.
+       * @headerfile os.h <micro-os-plus/rtos.h>
+       * @details
+       * The records are stored in a ring of bytes, extended to a
+       * multiple of the storage type.
+       */
+      template <typename T, std::size_t size_bytes>
+      class arena
+      {
+      public:
+        T buffer[(size_bytes + sizeof (T) - 1) / sizeof (T)];
+      };
+
+      /**
+       * @brief Calculator for buffer storage requirements.
+       * @param size_bytes Size of the buffer, in bytes.
+       * @return Total required storage in bytes, including
+       * internal alignment.
+       */
+      template <typename T>
+      constexpr std::size_t
+      compute_allocated_size_bytes (std::size_t size_bytes)
+      {
+        return ((size_bytes + (sizeof (T) - 1)) & ~(sizeof (T) - 1));
+      }
+
+      // ======================================================================
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+      /**
+       * @brief Construct a stream buffer object instance.
+       * @param [in] size_bytes The size of the buffer, in bytes.
+       * @param [in] attributes Reference to attributes.
+       * @param [in] allocator Reference to allocator. Default a
+       * local temporary instance.
+       */
+      stream_buffer (std::size_t size_bytes,
+                     const attributes& attributes = initializer,
+                     const allocator_type& allocator = allocator_type ());
+
+      /**
+       * @brief Construct a named stream buffer object instance.
+       * @param [in] name Pointer to name.
+       * @param [in] size_bytes The size of the buffer, in bytes.
+       * @param [in] attributes Reference to attributes.
+       * @param [in] allocator Reference to allocator. Default a
+       * local temporary instance.
+       */
+      stream_buffer (const char* name, std::size_t size_bytes,
+                     const attributes& attributes = initializer,
+                     const allocator_type& allocator = allocator_type ());
+
+    protected:
+      /**
+       * @cond ignore
+       */
+
+      // Internal constructors, used from templates.
+      stream_buffer ();
+      stream_buffer (const char* name);
+
+      /**
+       * @endcond
+       */
+
+    public:
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      stream_buffer (const stream_buffer&) = delete;
+      stream_buffer (stream_buffer&&) = delete;
+      stream_buffer&
+      operator= (const stream_buffer&)
+          = delete;
+      stream_buffer&
+      operator= (stream_buffer&&)
+          = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the stream buffer object instance.
+       */
+      virtual ~stream_buffer ();
+
+      /**
+       * @}
+       */
+
+      /**
+       * @name Operators
+       * @{
+       */
+
+      /**
+       * @brief Compare stream buffers.
+       * @retval true The given stream buffer is the same as this one.
+       * @retval false The stream buffers are different.
+       */
+      bool
+      operator== (const stream_buffer& rhs) const;
+
+      /**
+       * @}
+       */
+
+    public:
+      /**
+       * @name Public Member Functions
+       * @{
+       */
+
+      /**
+       * @brief Send a record to the stream buffer.
+       * @param [in] record The address of the record to enqueue.
+       * @param [in] nbytes The length of the record.
+       * @retval result::ok The record was enqueued.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The record, including its header, cannot fit
+       *  in the buffer.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ENOTRECOVERABLE The record could not be enqueued.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      send (const void* record, std::size_t nbytes);
+
+      /**
+       * @brief Try to send a record to the stream buffer.
+       * @param [in] record The address of the record to enqueue.
+       * @param [in] nbytes The length of the record.
+       * @retval result::ok The record was enqueued.
+       * @retval EWOULDBLOCK There is not enough free space in the buffer.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The record, including its header, cannot fit
+       *  in the buffer.
+       */
+      result_t
+      try_send (const void* record, std::size_t nbytes);
+
+      /**
+       * @brief Send a record to the stream buffer with timeout.
+       * @param [in] record The address of the record to enqueue.
+       * @param [in] nbytes The length of the record.
+       * @param [in] timeout The timeout duration.
+       * @retval result::ok The record was enqueued.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The record, including its header, cannot fit
+       *  in the buffer.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ETIMEDOUT The timeout expired before the record
+       *  could be added to the buffer.
+       * @retval ENOTRECOVERABLE The record could not be enqueued.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      timed_send (const void* record, std::size_t nbytes,
+                  clock::duration_t timeout);
+
+      /**
+       * @brief Receive a record from the stream buffer.
+       * @param [out] record The address where to store the record.
+       * @param [in] nbytes The size of the destination buffer.
+       * @param [out] record_size_bytes The address where to store the
+       *  record length. The default is `nullptr`.
+       * @retval result::ok The record was received.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The destination buffer is smaller than
+       *  the oldest record; the record is left in the buffer.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ENOTRECOVERABLE The record could not be dequeued.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      receive (void* record, std::size_t nbytes,
+               std::size_t* record_size_bytes = nullptr);
+
+      /**
+       * @brief Try to receive a record from the stream buffer.
+       * @param [out] record The address where to store the record.
+       * @param [in] nbytes The size of the destination buffer.
+       * @param [out] record_size_bytes The address where to store the
+       *  record length. The default is `nullptr`.
+       * @retval result::ok The record was received.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The destination buffer is smaller than
+       *  the oldest record; the record is left in the buffer.
+       * @retval EWOULDBLOCK The stream buffer is empty.
+       */
+      result_t
+      try_receive (void* record, std::size_t nbytes,
+                   std::size_t* record_size_bytes = nullptr);
+
+      /**
+       * @brief Receive a record from the stream buffer with timeout.
+       * @param [out] record The address where to store the record.
+       * @param [in] nbytes The size of the destination buffer.
+       * @param [in] timeout The timeout duration.
+       * @param [out] record_size_bytes The address where to store the
+       *  record length. The default is `nullptr`.
+       * @retval result::ok The record was received.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The destination buffer is smaller than
+       *  the oldest record; the record is left in the buffer.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ENOTRECOVERABLE The record could not be dequeued.
+       * @retval EINTR The operation was interrupted.
+       * @retval ETIMEDOUT No record arrived before the
+       *  specified timeout expired.
+       */
+      result_t
+      timed_receive (void* record, std::size_t nbytes,
+                     clock::duration_t timeout,
+                     std::size_t* record_size_bytes = nullptr);
+
+      /**
+       * @brief Acquire the oldest record, without copying it.
+       * @param [out] record_spans Reference to the record description.
+       * @retval result::ok The record was acquired.
+       * @retval EBUSY Another record is already acquired.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ENOTRECOVERABLE The record could not be acquired.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      acquire (spans& record_spans);
+
+      /**
+       * @brief Try to acquire the oldest record, without copying it.
+       * @param [out] record_spans Reference to the record description.
+       * @retval result::ok The record was acquired.
+       * @retval EBUSY Another record is already acquired.
+       * @retval EWOULDBLOCK The stream buffer is empty.
+       */
+      result_t
+      try_acquire (spans& record_spans);
+
+      /**
+       * @brief Acquire the oldest record, without copying it, with timeout.
+       * @param [out] record_spans Reference to the record description.
+       * @param [in] timeout The timeout duration.
+       * @retval result::ok The record was acquired.
+       * @retval EBUSY Another record is already acquired.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ENOTRECOVERABLE The record could not be acquired.
+       * @retval EINTR The operation was interrupted.
+       * @retval ETIMEDOUT No record arrived before the
+       *  specified timeout expired.
+       */
+      result_t
+      timed_acquire (spans& record_spans, clock::duration_t timeout);
+
+      /**
+       * @brief Release the acquired record.
+       * @par Parameters
+       *  None.
+       * @retval result::ok The record was removed from the buffer.
+       * @retval EINVAL There is no acquired record.
+       */
+      result_t
+      release (void);
+
+      /**
+       * @brief Get the buffer capacity.
+       * @par Parameters
+       *  None.
+       * @return The size of the buffer, in bytes.
+       */
+      std::size_t
+      capacity (void) const;
+
+      /**
+       * @brief Get the buffer length.
+       * @par Parameters
+       *  None.
+       * @return The number of bytes used in the buffer,
+       *  including the record headers.
+       */
+      std::size_t
+      length (void) const;
+
+      /**
+       * @brief Get the free space.
+       * @par Parameters
+       *  None.
+       * @return The number of bytes available in the buffer.
+       */
+      std::size_t
+      available (void) const;
+
+      /**
+       * @brief Get the number of records.
+       * @par Parameters
+       *  None.
+       * @return The number of records stored in the buffer.
+       */
+      std::size_t
+      records (void) const;
+
+      /**
+       * @brief Check if the buffer is empty.
+       * @par Parameters
+       *  None.
+       * @retval true The buffer has no records.
+       * @retval false The buffer has some records.
+       */
+      bool
+      empty (void) const;
+
+      /**
+       * @brief Get the trigger level.
+       * @par Parameters
+       *  None.
+       * @return The number of bytes required to wake a reader.
+       */
+      std::size_t
+      trigger_level (void) const;
+
+      /**
+       * @brief Set the trigger level.
+       * @param [in] level_bytes The number of bytes required to
+       *  wake a reader.
+       * @return The previous trigger level.
+       */
+      std::size_t
+      trigger_level (std::size_t level_bytes);
+
+      /**
+       * @brief Reset the stream buffer.
+       * @par Parameters
+       *  None.
+       * @retval result::ok The buffer was reset.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       */
+      result_t
+      reset (void);
+
+      /**
+       * @}
+       */
+
+    protected:
+      /**
+       * @name Private Member Functions
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief Internal function used during stream buffer construction.
+       * @param [in] size_bytes The size of the buffer, in bytes.
+       * @param [in] attributes Reference to attributes.
+       * @param [in] arena_address Pointer to buffer storage.
+       * @param [in] arena_size_bytes Size of buffer storage.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_construct_ (std::size_t size_bytes,
+                           const attributes& attributes, void* arena_address,
+                           std::size_t arena_size_bytes);
+
+      /**
+       * @brief Internal function used to initialise the buffer to empty
+       * state.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_init_ (void);
+
+      /**
+       * @brief Internal function used to enqueue a record, if possible.
+       * @param [in] record The address of the record to enqueue.
+       * @param [in] nbytes The length of the record.
+       * @retval true The record was enqueued.
+       * @retval false There is not enough free space.
+       */
+      bool
+      internal_try_send_ (const void* record, std::size_t nbytes);
+
+      /**
+       * @brief Internal function used to check if a blocked reader
+       * can proceed.
+       * @par Parameters
+       *  None.
+       * @retval true There are records and the trigger level was
+       *  reached, or a sender is blocked.
+       * @retval false The reader must wait.
+       */
+      bool
+      internal_is_triggered_ (void) const;
+
+      /**
+       * @brief Internal function used to get the length of the oldest
+       * record.
+       * @par Parameters
+       *  None.
+       * @return The length of the payload, in bytes.
+       */
+      std::size_t
+      internal_head_record_size_ (void) const;
+
+      /**
+       * @brief Internal function used to dequeue a record.
+       * @param [out] record The address where to store the record.
+       * @param [in] nbytes The size of the destination buffer.
+       * @param [out] record_size_bytes The address where to store the
+       *  record length.
+       * @retval result::ok The record was dequeued.
+       * @retval EMSGSIZE The destination buffer is too small.
+       */
+      result_t
+      internal_receive_ (void* record, std::size_t nbytes,
+                         std::size_t* record_size_bytes);
+
+      /**
+       * @brief Internal function used to describe the oldest record.
+       * @param [out] record_spans Reference to the record description.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_acquire_ (spans& record_spans);
+
+      /**
+       * @brief Internal function used to copy bytes into the ring.
+       * @param [in] offset The offset where to start writing.
+       * @param [in] src The source address.
+       * @param [in] nbytes The number of bytes to copy.
+       * @return The offset following the copied bytes.
+       */
+      std::size_t
+      internal_copy_in_ (std::size_t offset, const void* src,
+                         std::size_t nbytes);
+
+      /**
+       * @brief Internal function used to copy bytes from the ring.
+       * @param [in] offset The offset where to start reading.
+       * @param [out] dest The destination address.
+       * @param [in] nbytes The number of bytes to copy.
+       * @return The offset following the copied bytes.
+       */
+      std::size_t
+      internal_copy_out_ (std::size_t offset, void* dest,
+                          std::size_t nbytes) const;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+
+    protected:
+      /**
+       * @name Private Member Variables
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief List of threads waiting to send.
+       */
+      internal::waiting_threads_list send_list_;
+
+      /**
+       * @brief List of threads waiting to receive.
+       */
+      internal::waiting_threads_list receive_list_;
+
+      /**
+       * @brief Pointer to clock to be used for timeouts.
+       */
+      clock* clock_ = nullptr;
+
+      /**
+       * @brief The static address where the buffer is stored
+       * (from `attributes.arena_address`).
+       */
+      void* arena_address_ = nullptr;
+
+      /**
+       * @brief The dynamic address if the buffer was allocated
+       * (and must be deallocated)
+       */
+      void* allocated_arena_address_ = nullptr;
+
+      /**
+       * @brief Pointer to allocator.
+       */
+      const void* allocator_ = nullptr;
+
+      /**
+       * @brief Total size of the statically allocated buffer storage
+       * (from `attributes.arena_size_bytes`).
+       */
+      std::size_t arena_size_bytes_ = 0;
+
+      /**
+       * @brief Total size of the dynamically allocated buffer storage.
+       */
+      std::size_t allocated_arena_size_elements_ = 0;
+
+      /**
+       * @brief The size of the ring, in bytes.
+       */
+      std::size_t size_bytes_ = 0;
+
+      /**
+       * @brief The number of bytes required to wake a reader.
+       */
+      std::size_t trigger_level_bytes_ = 1;
+
+      /**
+       * @brief Offset of the oldest record.
+       */
+      std::size_t head_ = 0;
+
+      /**
+       * @brief Offset where the next record will be written.
+       */
+      std::size_t tail_ = 0;
+
+      /**
+       * @brief Number of bytes used, including the record headers.
+       */
+      volatile std::size_t used_bytes_ = 0;
+
+      /**
+       * @brief Number of records in the buffer.
+       */
+      volatile std::size_t records_ = 0;
+
+      /**
+       * @brief Number of bytes of the acquired record, including the
+       * header, or 0 if no record is acquired.
+       */
+      std::size_t acquired_bytes_ = 0;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+    };
+
+    // ========================================================================
+
+    /**
+     * @brief Template of a synchronised **stream buffer** with allocator.
+     * @headerfile os.h <micro-os-plus/rtos.h>
+     * @ingroup micro-os-plus-rtos-sbuffer
+     */
+    template <typename Allocator = memory::allocator<void*>>
+    class stream_buffer_allocated : public stream_buffer
+    {
+    public:
+      /**
+       * @brief Standard allocator type definition.
+       */
+      using allocator_type = Allocator;
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+      /**
+       * @brief Construct a stream buffer object instance.
+       * @param [in] size_bytes The size of the buffer, in bytes.
+       * @param [in] attributes Reference to attributes.
+       * @param [in] allocator Reference to allocator. Default a
+       * local temporary instance.
+       */
+      stream_buffer_allocated (std::size_t size_bytes,
+                               const attributes& attributes = initializer,
+                               const allocator_type& allocator
+                               = allocator_type ());
+
+      /**
+       * @brief Construct a named stream buffer object instance.
+       * @param [in] name Pointer to name.
+       * @param [in] size_bytes The size of the buffer, in bytes.
+       * @param [in] attributes Reference to attributes.
+       * @param [in] allocator Reference to allocator. Default a
+       * local temporary instance.
+       */
+      stream_buffer_allocated (const char* name, std::size_t size_bytes,
+                               const attributes& attributes = initializer,
+                               const allocator_type& allocator
+                               = allocator_type ());
+
+    public:
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      stream_buffer_allocated (const stream_buffer_allocated&) = delete;
+      stream_buffer_allocated (stream_buffer_allocated&&) = delete;
+      stream_buffer_allocated&
+      operator= (const stream_buffer_allocated&)
+          = delete;
+      stream_buffer_allocated&
+      operator= (stream_buffer_allocated&&)
+          = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the stream buffer object instance.
+       */
+      virtual ~stream_buffer_allocated ();
+
+      /**
+       * @}
+       */
+    };
+
+    // ========================================================================
+
+    /**
+     * @brief Template of a synchronised **stream buffer** with
+     * local storage.
+     * @headerfile os.h <micro-os-plus/rtos.h>
+     * @ingroup micro-os-plus-rtos-sbuffer
+     */
+    template <std::size_t N>
+    class stream_buffer_inclusive : public stream_buffer
+    {
+    public:
+      /**
+       * @brief Local constant based on template definition.
+       */
+      static const std::size_t size_bytes = N;
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+      /**
+       * @brief Construct a stream buffer object instance.
+       * @param [in] attributes Reference to attributes.
+       */
+      stream_buffer_inclusive (const attributes& attributes = initializer);
+
+      /**
+       * @brief Construct a named stream buffer object instance.
+       * @param [in] name Pointer to name.
+       * @param [in] attributes Reference to attributes.
+       */
+      stream_buffer_inclusive (const char* name,
+                               const attributes& attributes = initializer);
+
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      stream_buffer_inclusive (const stream_buffer_inclusive&) = delete;
+      stream_buffer_inclusive (stream_buffer_inclusive&&) = delete;
+      stream_buffer_inclusive&
+      operator= (const stream_buffer_inclusive&)
+          = delete;
+      stream_buffer_inclusive&
+      operator= (stream_buffer_inclusive&&)
+          = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the stream buffer object instance.
+       */
+      virtual ~stream_buffer_inclusive ();
+
+      /**
+       * @}
+       */
+
+    protected:
+      /**
+       * @name Private Member Variables
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief Local storage for the buffer.
+       */
+      arena<void*, size_bytes> arena_;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+    };
+
+#pragma GCC diagnostic pop
+
+  } // namespace rtos
+} // namespace micro_os_plus
+
+// ===== Inline & template implementations ====================================
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    constexpr stream_buffer::attributes::attributes ()
+    {
+      ;
+    }
+
+    // ========================================================================
+
+    inline std::size_t
+    stream_buffer::spans::size_bytes (void) const
+    {
+      return first_size_bytes + second_size_bytes;
+    }
+
+    // ========================================================================
+
+    /**
+     * @details
+     * Identical stream buffers should have the same memory address.
+     */
+    inline bool
+    stream_buffer::operator== (const stream_buffer& rhs) const
+    {
+      return this == &rhs;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    stream_buffer::capacity (void) const
+    {
+      return size_bytes_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    stream_buffer::length (void) const
+    {
+      return used_bytes_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    stream_buffer::available (void) const
+    {
+      return size_bytes_ - used_bytes_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    stream_buffer::records (void) const
+    {
+      return records_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline bool
+    stream_buffer::empty (void) const
+    {
+      return (records () == 0);
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    stream_buffer::trigger_level (void) const
+    {
+      return trigger_level_bytes_;
+    }
+
+    // ========================================================================
+
+    /**
+     * @details
+     * If the attributes define a storage area (via
+     * `arena_address` and `arena_size_bytes`), that
+     * storage is used, otherwise the storage is dynamically allocated using
+     * the given allocator.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template <typename Allocator>
+    inline stream_buffer_allocated<Allocator>::stream_buffer_allocated (
+        std::size_t size_bytes, const attributes& _attributes,
+        const allocator_type& allocator)
+        : stream_buffer_allocated{ nullptr, size_bytes, _attributes,
+                                   allocator }
+    {
+      ;
+    }
+
+    /**
+     * @details
+     * If the attributes define a storage area (via
+     * `arena_address` and `arena_size_bytes`), that
+     * storage is used, otherwise the storage is dynamically allocated using
+     * the given allocator.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template <typename Allocator>
+    stream_buffer_allocated<Allocator>::stream_buffer_allocated (
+        const char* name, std::size_t size_bytes,
+        const attributes& _attributes, const allocator_type& allocator)
+        : stream_buffer{ name }
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s() @%p %s %u\n", __func__, this, this->name (),
+                     size_bytes);
+#endif
+
+      if (_attributes.arena_address != nullptr)
+        {
+          // Do not use any allocator at all.
+          internal_construct_ (size_bytes, _attributes, nullptr, 0);
+        }
+      else
+        {
+          allocator_ = &allocator;
+
+          // If no user storage was provided via attributes,
+          // allocate it dynamically via the allocator.
+          allocated_arena_size_elements_
+              = (compute_allocated_size_bytes<
+                     typename allocator_type::value_type> (size_bytes)
+                 + sizeof (typename allocator_type::value_type) - 1)
+                / sizeof (typename allocator_type::value_type);
+
+          allocated_arena_address_
+              = const_cast<allocator_type&> (allocator).allocate (
+                  allocated_arena_size_elements_);
+
+          internal_construct_ (
+              size_bytes, _attributes, allocated_arena_address_,
+              allocated_arena_size_elements_
+                  * sizeof (typename allocator_type::value_type));
+        }
+    }
+
+    /**
+     * @details
+     * If the storage for the stream buffer was dynamically allocated,
+     * it is deallocated using the same allocator.
+     */
+    template <typename Allocator>
+    stream_buffer_allocated<Allocator>::~stream_buffer_allocated ()
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+      typedef typename std::allocator_traits<allocator_type>::pointer pointer;
+
+      if (allocated_arena_address_ != nullptr)
+        {
+          static_cast<allocator_type*> (const_cast<void*> (allocator_))
+              ->deallocate (static_cast<pointer> (allocated_arena_address_),
+                            allocated_arena_size_elements_);
+
+          allocated_arena_address_ = nullptr;
+        }
+    }
+
+    // ========================================================================
+
+    /**
+     * @details
+     * The storage shall be statically allocated inside the
+     * stream buffer object instance.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template <std::size_t N>
+    inline stream_buffer_inclusive<N>::stream_buffer_inclusive (
+        const attributes& _attributes)
+        : stream_buffer_inclusive{ nullptr, _attributes }
+    {
+      ;
+    }
+
+    /**
+     * @details
+     * The storage shall be statically allocated inside the
+     * stream buffer object instance.
+     *
+     * Passing a storage via the attributes is not allowed
+     * and might trigger an assert.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template <std::size_t N>
+    stream_buffer_inclusive<N>::stream_buffer_inclusive (
+        const char* name, const attributes& _attributes)
+        : stream_buffer{ name }
+    {
+      internal_construct_ (size_bytes, _attributes, &arena_, sizeof (arena_));
+    }
+
+    /**
+     * @details
+     * Implemented as a wrapper over the parent destructor.
+     */
+    template <std::size_t N>
+    stream_buffer_inclusive<N>::~stream_buffer_inclusive ()
+    {
+      ;
+    }
+
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_RTOS_STREAM_BUFFER_H_
+
+// ----------------------------------------------------------------------------
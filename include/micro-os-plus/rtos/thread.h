@@ -230,6 +230,21 @@ namespace micro_os_plus
 
     }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+    namespace cpu_load
+    {
+      void
+      internal_sample_ (thread* parent);
+    } // namespace cpu_load
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+    namespace wakeup_graph
+    {
+      struct edge;
+    } // namespace wakeup_graph
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+
     // ========================================================================
 
 #pragma GCC diagnostic push
@@ -510,6 +525,17 @@ namespace micro_os_plus
         void
         initialize (void);
 
+        /**
+         * @brief Align the pointers and initialise to a known pattern,
+         * except the bottom part known to hold the pattern.
+         * @param [in] intact_bytes Number of bytes at the bottom
+         *  which already hold the pattern.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        initialize (std::size_t intact_bytes);
+
         /**
          * @brief Get the stack lowest reserved address.
          * @par Parameters
@@ -566,6 +592,38 @@ namespace micro_os_plus
         std::size_t
         available (void);
 
+        /**
+         * @brief Estimate how much available stack remains.
+         * @par Parameters
+         *  None.
+         * @return Number of available bytes.
+         */
+        std::size_t
+        available_estimate (void);
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN) \
+    || defined(__DOXYGEN__)
+
+        /**
+         * @brief Advance the incremental scan of the available stack.
+         * @param [in] elements Maximum number of elements to check.
+         * @retval true The scan completed and the cached value was updated.
+         * @retval false The scan is still in progress.
+         */
+        bool
+        scan (std::size_t elements);
+
+        /**
+         * @brief Get the available stack computed by the last complete scan.
+         * @par Parameters
+         *  None.
+         * @return Number of available bytes.
+         */
+        std::size_t
+        available_cached (void);
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
         /**
          * @}
          */
@@ -624,6 +682,13 @@ namespace micro_os_plus
         stack::element_t* bottom_address_;
         std::size_t size_bytes_;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+        // Index of the next element to check.
+        std::size_t scan_elements_;
+        // Result of the last complete scan.
+        std::size_t available_bytes_;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
         static std::size_t min_size_bytes_;
         static std::size_t default_size_bytes_;
 
@@ -856,7 +921,9 @@ namespace micro_os_plus
       }; /* class attributes */
 
 #if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
-    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
 
       /**
        * @brief Thread statistics.
@@ -938,6 +1005,199 @@ namespace micro_os_plus
 
 #endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD) \
+    || defined(__DOXYGEN__)
+
+        /**
+         * @brief Get the thread CPU load during the last sample interval.
+         * @par Parameters
+         *  None.
+         * @return The load in hundredths of percent (0-10000).
+         */
+        uint32_t
+        cpu_load (void);
+
+        /**
+         * @brief Get the exponentially decayed thread CPU load.
+         * @par Parameters
+         *  None.
+         * @return The load in hundredths of percent (0-10000).
+         */
+        uint32_t
+        cpu_load_average (void);
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) \
+    || defined(__DOXYGEN__)
+
+        /**
+         * @brief Number of buckets in the wakeup latency histogram.
+         */
+        static constexpr std::size_t wakeup_histogram_buckets = 16;
+
+        /**
+         * @brief Offset of the histogram buckets, as log2 of cycles.
+         *
+         * @details
+         * Bucket 0 counts latencies below 2^(value + 1) cycles (128
+         * cycles with the value 6), and bucket _i_ > 0 starts at
+         * 2^(_i_ + value) cycles.
+         */
+        static constexpr std::size_t wakeup_histogram_min_cycles_log2 = 6;
+
+        /**
+         * @brief Get the number of measured wakeups.
+         * @par Parameters
+         *  None.
+         * @return A long integer with the number of times the thread
+         * was resumed and then scheduled for execution.
+         */
+        rtos::statistics::counter_t
+        wakeups (void);
+
+        /**
+         * @brief Get the shortest wakeup latency.
+         * @par Parameters
+         *  None.
+         * @return Number of CPU cycles, or 0 if there were no wakeups.
+         */
+        rtos::statistics::duration_t
+        wakeup_latency_min (void);
+
+        /**
+         * @brief Get the longest wakeup latency.
+         * @par Parameters
+         *  None.
+         * @return Number of CPU cycles.
+         */
+        rtos::statistics::duration_t
+        wakeup_latency_max (void);
+
+        /**
+         * @brief Get the average wakeup latency.
+         * @par Parameters
+         *  None.
+         * @return Number of CPU cycles, or 0 if there were no wakeups.
+         */
+        rtos::statistics::duration_t
+        wakeup_latency_mean (void);
+
+        /**
+         * @brief Get the number of wakeups in a histogram bucket.
+         * @param [in] index Index of the bucket.
+         * @return Integer.
+         */
+        uint32_t
+        wakeup_histogram (std::size_t index);
+
+        /**
+         * @brief Get the histogram bucket of a latency.
+         * @param [in] cycles Latency, in CPU cycles.
+         * @return Index of the bucket.
+         */
+        static std::size_t
+        wakeup_histogram_bucket (rtos::statistics::duration_t cycles);
+
+        /**
+         * @brief Get the lowest latency counted in a histogram bucket.
+         * @param [in] index Index of the bucket.
+         * @return Number of CPU cycles.
+         */
+        static rtos::statistics::duration_t
+        wakeup_histogram_bucket_cycles (std::size_t index);
+
+        /**
+         * @brief Clear the wakeup latency measurements.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        clear_wakeup_latency (void);
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT) \
+    || defined(__DOXYGEN__)
+
+        /**
+         * @brief Number of objects with separate wait accounting.
+         */
+        static constexpr std::size_t wait_objects_size
+            = MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_THREAD_WAIT_OBJECTS;
+
+        /**
+         * @brief Time blocked on an object.
+         */
+        class wait_object
+        {
+        public:
+          // The object, or `nullptr` for unused entries.
+          const void* object;
+          rtos::statistics::wait_reason reason;
+          rtos::statistics::counter_t waits;
+          rtos::statistics::duration_t cycles;
+        };
+
+        /**
+         * @brief Get the number of times the thread was blocked.
+         * @param [in] reason The reason to block.
+         * @return Integer.
+         */
+        rtos::statistics::counter_t
+        waits (rtos::statistics::wait_reason reason);
+
+        /**
+         * @brief Get the time the thread was blocked.
+         * @param [in] reason The reason to block.
+         * @return Number of CPU cycles.
+         */
+        rtos::statistics::duration_t
+        wait_cycles (rtos::statistics::wait_reason reason);
+
+#if (MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_THREAD_WAIT_OBJECTS > 0) \
+    || defined(__DOXYGEN__)
+
+        /**
+         * @brief Get the time blocked on each object.
+         * @par Parameters
+         *  None.
+         * @return Pointer to an array of `wait_objects_size` entries.
+         */
+        const wait_object*
+        wait_objects (void);
+
+#endif
+
+        /**
+         * @brief Clear the wait accounting.
+         * @par Parameters
+         *  None.
+         * @par Returns
+         *  Nothing.
+         */
+        void
+        clear_waits (void);
+
+        /**
+         * @cond ignore
+         */
+
+        void
+        internal_wait_begin_ (rtos::statistics::wait_reason reason,
+                              const void* object);
+
+        void
+        internal_wait_end_ (void);
+
+        /**
+         * @endcond
+         */
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+
         /**
          * @}
          */
@@ -950,6 +1210,13 @@ namespace micro_os_plus
         friend void
         rtos::scheduler::internal_switch_threads (void);
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+        friend class rtos::thread;
+
+        void
+        internal_record_wakeup_ (rtos::statistics::duration_t now);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
 #if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
         rtos::statistics::counter_t context_switches_ = 0;
 #endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
@@ -958,6 +1225,47 @@ namespace micro_os_plus
         rtos::statistics::duration_t cpu_cycles_ = 0;
 #endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+        friend void
+        rtos::cpu_load::internal_sample_ (thread* parent);
+
+        // The CPU cycles at the previous sample.
+        rtos::statistics::duration_t cpu_cycles_sampled_ = 0;
+        uint32_t cpu_load_ = 0;
+        uint32_t cpu_load_average_ = 0;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+        // Timestamp of the resume, or 0 if not waiting to run.
+        rtos::statistics::duration_t wakeup_timestamp_ = 0;
+        rtos::statistics::counter_t wakeups_ = 0;
+        rtos::statistics::duration_t wakeup_latency_total_ = 0;
+        rtos::statistics::duration_t wakeup_latency_min_ = 0;
+        rtos::statistics::duration_t wakeup_latency_max_ = 0;
+        uint32_t wakeup_histogram_[wakeup_histogram_buckets] = {};
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+        rtos::statistics::counter_t waits_[rtos::statistics::wait_reasons]
+            = {};
+        rtos::statistics::duration_t
+            wait_cycles_[rtos::statistics::wait_reasons]
+            = {};
+        // Timestamp of the current wait, or 0 if not blocked.
+        rtos::statistics::duration_t wait_timestamp_ = 0;
+        const void* wait_object_ = nullptr;
+        rtos::statistics::wait_reason wait_reason_
+            = rtos::statistics::wait_reason::other;
+#if MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_THREAD_WAIT_OBJECTS > 0
+        wait_object wait_objects_[wait_objects_size] = {};
+#endif
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+        // The graph edge of the pending resume, if any.
+        wakeup_graph::edge* wakeup_edge_ = nullptr;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+
         /**
          * @endcond
          */
@@ -965,7 +1273,12 @@ namespace micro_os_plus
 
 #endif /* defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
           || \
-          defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) */
+          defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+          || \
+          defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) \
+          || \
+          defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT) \
+        */
 
 #pragma GCC diagnostic pop
 
@@ -1066,6 +1379,33 @@ namespace micro_os_plus
       bool
       operator== (const thread& rhs) const;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE) || defined(__DOXYGEN__)
+
+      using object_named_system::operator new;
+      using object_named_system::operator delete;
+
+      /**
+       * @brief Allocate space for a new thread object instance,
+       * possibly reusing a cached one.
+       * @param bytes Number of bytes to allocate.
+       * @return Pointer to allocated object.
+       */
+      static void*
+      operator new (std::size_t bytes);
+
+      /**
+       * @brief Deallocate the thread object instance, possibly
+       * keeping it in the cache.
+       * @param ptr Pointer to object.
+       * @param bytes Number of bytes to deallocate.
+       * @par Returns
+       *  Nothing.
+       */
+      static void
+      operator delete (void* ptr, std::size_t bytes);
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE)
+
       /**
        * @}
        */
@@ -1222,6 +1562,21 @@ namespace micro_os_plus
 
 #endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_CUSTOM_THREAD_USER_STORAGE)
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA) \
+    || defined(__DOXYGEN__)
+
+      /**
+       * @brief Get the thread heap arena.
+       * @par Parameters
+       *  None.
+       * @return Pointer to the arena, or `nullptr` if the thread
+       *  allocates from the shared heap.
+       */
+      memory::heap_arena*
+      heap_arena (void);
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+
       /**
        * @brief Raise thread event flags.
        * @param [in] mask The OR-ed flags to raise.
@@ -1262,7 +1617,9 @@ namespace micro_os_plus
       stack (void);
 
 #if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
-    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
 
       thread::statistics&
       statistics (void);
@@ -1315,7 +1672,9 @@ namespace micro_os_plus
 
       friend void
       scheduler::internal_link_node (internal::waiting_threads_list& list,
-                                     internal::waiting_thread_node& node);
+                                     internal::waiting_thread_node& node,
+                                     rtos::statistics::wait_reason reason,
+                                     const void* object);
 
       friend void
       scheduler::internal_unlink_node (internal::waiting_thread_node& node);
@@ -1325,7 +1684,8 @@ namespace micro_os_plus
           internal::waiting_threads_list& list,
           internal::waiting_thread_node& node,
           internal::clock_timestamps_list& timeout_list,
-          internal::timeout_thread_node& timeout_node);
+          internal::timeout_thread_node& timeout_node,
+          rtos::statistics::wait_reason reason, const void* object);
 
       friend void
       scheduler::internal_unlink_node (
@@ -1344,6 +1704,10 @@ namespace micro_os_plus
       friend port::stack::element_t*
       port::scheduler::switch_stacks (port::stack::element_t* sp);
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+      friend class memory::heap_arena;
+#endif
+
       friend void ::micro_os_plus_rtos_idle_actions (void);
 
       friend class internal::ready_threads_list;
@@ -1385,7 +1749,8 @@ namespace micro_os_plus
       void
       internal_construct_ (function_t function, function_arguments_t arguments,
                            const attributes& attributes, void* stack_address,
-                           std::size_t stack_size_bytes);
+                           std::size_t stack_size_bytes,
+                           std::size_t stack_intact_bytes = 0);
 
       /**
        * @brief Suspend this thread and wait for an event.
@@ -1541,6 +1906,16 @@ namespace micro_os_plus
       void
       internal_check_stack_ (void);
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+      /**
+       * @brief Get the next thread in a depth first walk of the tree.
+       * @param [in] children If false, skip the children of this thread.
+       * @return Pointer to the next thread, or nullptr after the last.
+       */
+      thread*
+      internal_next_in_tree_ (bool children);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
       /**
        * @endcond
        */
@@ -1645,15 +2020,26 @@ namespace micro_os_plus
       micro_os_plus_thread_user_storage_t user_storage_;
 #endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_CUSTOM_THREAD_USER_STORAGE)
 
-#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+      memory::heap_arena* heap_arena_ = nullptr;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
 
       class statistics statistics_;
 
-#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
+#endif
 
       // Add other internal data
 
       // Implementation
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      friend class object_registry;
+#endif
+
 #if defined(MICRO_OS_PLUS_USE_RTOS_PORT_SCHEDULER)
       friend class port::thread;
       micro_os_plus_thread_port_data_t port_;
@@ -1851,6 +2237,83 @@ namespace micro_os_plus
 
 #pragma GCC diagnostic pop
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE) || defined(__DOXYGEN__)
+
+    /**
+     * @brief Cache of terminated thread objects and stacks.
+     * @ingroup micro-os-plus-rtos-thread
+     *
+     * @details
+     * Thread objects allocated with `new` and stacks allocated by the
+     * thread constructor are kept after the thread is destroyed,
+     * and reused by the next threads with similar needs.
+     *
+     * @note
+     *  Available only when
+     * `MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE` is defined.
+     */
+    namespace thread_cache
+    {
+      /**
+       * @name Thread Cache Functions
+       * @{
+       */
+
+      /**
+       * @brief Get the number of cached stacks.
+       * @par Parameters
+       *  None.
+       * @return Integer.
+       */
+      std::size_t
+      stacks (void);
+
+      /**
+       * @brief Get the number of cached thread objects.
+       * @par Parameters
+       *  None.
+       * @return Integer.
+       */
+      std::size_t
+      objects (void);
+
+      /**
+       * @brief Get the number of stacks and objects reused.
+       * @par Parameters
+       *  None.
+       * @return Integer.
+       */
+      std::size_t
+      hits (void);
+
+      /**
+       * @brief Get the number of stacks and objects not found
+       *  in the cache.
+       * @par Parameters
+       *  None.
+       * @return Integer.
+       */
+      std::size_t
+      misses (void);
+
+      /**
+       * @brief Return all cached stacks and objects to the
+       *  memory resource.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      flush (void);
+
+      /**
+       * @}
+       */
+    } // namespace thread_cache
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE)
+
   } // namespace rtos
 } // namespace micro_os_plus
 
@@ -2088,6 +2551,10 @@ namespace micro_os_plus
     {
       bottom_address_ = nullptr;
       size_bytes_ = 0;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+      scan_elements_ = 0;
+      available_bytes_ = 0;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
     }
 
     /**
@@ -2128,6 +2595,23 @@ namespace micro_os_plus
       return size_bytes_;
     }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
+    /**
+     * @details
+     * The value may be stale by at most one scan cycle; it is
+     * never lower than the actual available space.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    thread::stack::available_cached (void)
+    {
+      return available_bytes_;
+    }
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
     /**
      * @note Can be invoked from Interrupt Service Routines.
      */
@@ -2255,6 +2739,203 @@ namespace micro_os_plus
 
 #endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+    /**
+     * @details
+     * The load is the share of the last interval between two
+     * calls to `cpu_load::sample()` when the thread was running;
+     * before the second sample it is 0.
+     *
+     * @note This function is available only when
+     * `MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD`
+     * is defined.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline uint32_t
+    thread::statistics::cpu_load (void)
+    {
+      return cpu_load_;
+    }
+
+    /**
+     * @details
+     * The average is updated at each sample, so a short spike
+     * fades out after a number of intervals defined by
+     * `MICRO_OS_PLUS_INTEGER_RTOS_CPU_LOAD_DECAY_SHIFT`.
+     *
+     * @note This function is available only when
+     * `MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD`
+     * is defined.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline uint32_t
+    thread::statistics::cpu_load_average (void)
+    {
+      return cpu_load_average_;
+    }
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+    /**
+     * @details
+     * A wakeup is measured from the moment `resume()` makes the
+     * thread ready, to the moment the scheduler switches to it.
+     *
+     * @note This function is available only when
+     * @ref MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY
+     * is defined.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    thread::statistics::wakeups (void)
+    {
+      return wakeups_;
+    }
+
+    /**
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    thread::statistics::wakeup_latency_min (void)
+    {
+      return wakeup_latency_min_;
+    }
+
+    /**
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    thread::statistics::wakeup_latency_max (void)
+    {
+      return wakeup_latency_max_;
+    }
+
+    /**
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    thread::statistics::wakeup_latency_mean (void)
+    {
+      return (wakeups_ == 0) ? 0 : wakeup_latency_total_ / wakeups_;
+    }
+
+    /**
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline uint32_t
+    thread::statistics::wakeup_histogram (std::size_t index)
+    {
+      assert (index < wakeup_histogram_buckets);
+      return wakeup_histogram_[index];
+    }
+
+    /**
+     * @details
+     * Bucket 0 counts latencies below
+     * 2^(wakeup_histogram_min_cycles_log2 + 1) cycles, each following
+     * bucket doubles the limit, and the last bucket counts all
+     * longer latencies.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    thread::statistics::wakeup_histogram_bucket (
+        rtos::statistics::duration_t cycles)
+    {
+      if (cycles >> (wakeup_histogram_min_cycles_log2 + 1) == 0)
+        {
+          return 0;
+        }
+
+      // Position of the most significant bit.
+      std::size_t log2 = sizeof (unsigned long long) * 8 - 1
+                         - static_cast<std::size_t> (__builtin_clzll (
+                             static_cast<unsigned long long> (cycles)));
+      std::size_t index = log2 - wakeup_histogram_min_cycles_log2;
+
+      return (index < wakeup_histogram_buckets) ? index
+                                                : wakeup_histogram_buckets - 1;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    thread::statistics::wakeup_histogram_bucket_cycles (std::size_t index)
+    {
+      return (index == 0) ? 0
+                          : static_cast<rtos::statistics::duration_t> (1)
+                                << (index + wakeup_histogram_min_cycles_log2);
+    }
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+
+    /**
+     * @details
+     * The count is incremented when the thread is unblocked.
+     *
+     * @note This function is available only when
+     * `MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT`
+     * is defined.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::counter_t
+    thread::statistics::waits (rtos::statistics::wait_reason reason)
+    {
+      assert (static_cast<std::size_t> (reason)
+              < rtos::statistics::wait_reasons);
+      return waits_[static_cast<std::size_t> (reason)];
+    }
+
+    /**
+     * @details
+     * The time is measured with the high resolution clock, from
+     * the moment the thread is linked to the waiting list until
+     * it is removed, so it includes the wakeup latency.
+     *
+     * @note This function is available only when
+     * `MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT`
+     * is defined.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline rtos::statistics::duration_t
+    thread::statistics::wait_cycles (rtos::statistics::wait_reason reason)
+    {
+      assert (static_cast<std::size_t> (reason)
+              < rtos::statistics::wait_reasons);
+      return wait_cycles_[static_cast<std::size_t> (reason)];
+    }
+
+#if MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_THREAD_WAIT_OBJECTS > 0
+
+    /**
+     * @details
+     * Each entry accounts the waits for one object and one reason,
+     * in the order the objects were first waited for; when all
+     * entries are used, other objects are accounted only per reason.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    inline const thread::statistics::wait_object*
+    thread::statistics::wait_objects (void)
+    {
+      return wait_objects_;
+    }
+
+#endif
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+
     // ========================================================================
 
     /**
@@ -2325,6 +3006,28 @@ namespace micro_os_plus
 
 #endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_CUSTOM_THREAD_USER_STORAGE)
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA) \
+    || defined(__DOXYGEN__)
+
+    /**
+     * @details
+     * The arena is assigned when a `memory::heap_arena` is
+     * constructed for this thread.
+     *
+     * @note
+     *  Available only when
+     * `MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA` is defined.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline memory::heap_arena*
+    thread::heap_arena (void)
+    {
+      return heap_arena_;
+    }
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+
 #if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_SCHEDULER)
 
     /**
@@ -2366,7 +3069,10 @@ namespace micro_os_plus
       return context_.stack_;
     }
 
-#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
 
     /**
      * @warning Cannot be invoked from Interrupt Service Routines.
@@ -2377,7 +3083,7 @@ namespace micro_os_plus
       return statistics_;
     }
 
-#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
+#endif
 
 #if defined(MICRO_OS_PLUS_INCLUDE_RTMICRO_OS_PLUS_THREAD_PUBLIC_FLAGS_CLEAR)
 
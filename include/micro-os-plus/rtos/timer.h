@@ -416,6 +416,10 @@ namespace micro_os_plus
       clock::duration_t period_ = 0;
 #endif
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      friend class object_registry;
+#endif
+
 #if defined(MICRO_OS_PLUS_USE_RTOS_PORT_TIMER)
       friend class port::timer;
       micro_os_plus_timer_port_data_t port_;
@@ -0,0 +1,1205 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MICRO_OS_PLUS_RTOS_TOPIC_H_
+#define MICRO_OS_PLUS_RTOS_TOPIC_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/rtos/declarations.h>
+#include <micro-os-plus/rtos/memory.h>
+#include <micro-os-plus/rtos/memory-pool.h>
+
+#include <micro-os-plus/diag/trace.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wsuggest-final-methods"
+#pragma GCC diagnostic ignored "-Wsuggest-final-types"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+
+    // ========================================================================
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+    /**
+     * @brief Publish/subscribe **topic**, with zero-copy fan-out.
+     * @headerfile os.h <micro-os-plus/rtos.h>
+     * @ingroup micro-os-plus-rtos-topic
+     */
+    class topic : public internal::object_named_system
+    {
+    public:
+      // ======================================================================
+
+      /**
+       * @brief Type of variables holding overflow policies.
+       * @ingroup micro-os-plus-rtos-topic
+       */
+      using overflow_t = uint8_t;
+
+      /**
+       * @brief Subscriber overflow policies.
+       * @headerfile os.h <micro-os-plus/rtos.h>
+       * @ingroup micro-os-plus-rtos-topic
+       */
+      struct overflow
+      {
+        /**
+         * @brief Enumeration of overflow policies.
+         */
+        enum : overflow_t
+        {
+          /**
+           * @brief Discard the oldest queued message.
+           */
+          drop_oldest = 0,
+
+          /**
+           * @brief Discard the message being published.
+           */
+          drop_newest = 1,
+
+          /**
+           * @brief Block the publisher until there is room.
+           */
+          block = 2,
+
+          /**
+           * @brief Default value.
+           */
+          default_ = drop_oldest,
+
+          /**
+           * @brief Maximum value, for validation purposes.
+           */
+          max_ = block
+        };
+      };
+
+      // ======================================================================
+
+      /**
+       * @brief Topic attributes.
+       * @headerfile os.h <micro-os-plus/rtos.h>
+       * @ingroup micro-os-plus-rtos-topic
+       */
+      class attributes : public internal::attributes_clocked
+      {
+      public:
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a topic attributes object instance.
+         * @par Parameters
+         *  None.
+         */
+        constexpr attributes ();
+
+        // The rule of five.
+        attributes (const attributes&) = default;
+        attributes (attributes&&) = default;
+        attributes&
+        operator= (const attributes&)
+            = default;
+        attributes&
+        operator= (attributes&&)
+            = default;
+
+        /**
+         * @brief Destruct the topic attributes object instance.
+         */
+        ~attributes () = default;
+
+        /**
+         * @}
+         */
+
+        // Add more attributes here.
+
+      }; /* class attributes */
+
+      /**
+       * @brief Default topic initialiser.
+       * @ingroup micro-os-plus-rtos-topic
+       */
+      static const attributes initializer;
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief Header stored at the beginning of each pool block.
+       */
+      class message_header
+      {
+      public:
+        /**
+         * @brief Size of the payload, in bytes.
+         */
+        std::size_t size_bytes;
+
+        /**
+         * @brief Number of references to the message.
+         * @details
+         * The pool keeps its free list link in the first word
+         * of a free block, so the count is stored after it and
+         * is still 0 after the block is freed.
+         */
+        std::size_t references;
+      };
+
+      /**
+       * @brief References count of an allocated message which
+       * was not published yet.
+       */
+      static constexpr std::size_t unpublished_references
+          = static_cast<std::size_t> (-1);
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Size of the header preceding the payload in each block.
+       * @ingroup micro-os-plus-rtos-topic
+       */
+      static constexpr std::size_t header_size_bytes
+          = memory::align_size (sizeof (message_header),
+                                alignof (std::max_align_t));
+
+      // ======================================================================
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+      /**
+       * @brief Construct a topic object instance.
+       * @param [in] pool Reference to the memory pool used for messages.
+       * @param [in] attributes Reference to attributes.
+       */
+      topic (memory_pool& pool, const attributes& attributes = initializer);
+
+      /**
+       * @brief Construct a named topic object instance.
+       * @param [in] name Pointer to name.
+       * @param [in] pool Reference to the memory pool used for messages.
+       * @param [in] attributes Reference to attributes.
+       */
+      topic (const char* name, memory_pool& pool,
+             const attributes& attributes = initializer);
+
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      topic (const topic&) = delete;
+      topic (topic&&) = delete;
+      topic&
+      operator= (const topic&)
+          = delete;
+      topic&
+      operator= (topic&&)
+          = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the topic object instance.
+       */
+      virtual ~topic ();
+
+      /**
+       * @}
+       */
+
+      /**
+       * @name Operators
+       * @{
+       */
+
+      /**
+       * @brief Compare topics.
+       * @retval true The given topic is the same as this topic.
+       * @retval false The topics are different.
+       */
+      bool
+      operator== (const topic& rhs) const;
+
+      /**
+       * @}
+       */
+
+    public:
+      /**
+       * @name Public Member Functions
+       * @{
+       */
+
+      /**
+       * @brief Allocate a message.
+       * @par Parameters
+       *  None.
+       * @return Pointer to the message payload, or `nullptr` if interrupted.
+       */
+      void*
+      alloc (void);
+
+      /**
+       * @brief Try to allocate a message.
+       * @par Parameters
+       *  None.
+       * @return Pointer to the message payload, or `nullptr` if
+       *  the pool is exhausted.
+       */
+      void*
+      try_alloc (void);
+
+      /**
+       * @brief Allocate a message with timeout.
+       * @param [in] timeout Timeout to wait, in clock units (ticks or
+       * seconds).
+       * @return Pointer to the message payload, or `nullptr` if timeout.
+       */
+      void*
+      timed_alloc (clock::duration_t timeout);
+
+      /**
+       * @brief Publish a message to all subscribers.
+       * @param [in] payload Pointer to a payload obtained from `alloc()`.
+       * @param [in] nbytes The length of the payload.
+       * @retval result::ok The message was published.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The payload does not fit the pool block.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ENOTRECOVERABLE The message could not be published.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      publish (void* payload, std::size_t nbytes);
+
+      /**
+       * @brief Try to publish a message to all subscribers.
+       * @param [in] payload Pointer to a payload obtained from `alloc()`.
+       * @param [in] nbytes The length of the payload.
+       * @retval result::ok The message was published.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The payload does not fit the pool block.
+       * @retval EWOULDBLOCK A blocking subscriber is full.
+       */
+      result_t
+      try_publish (void* payload, std::size_t nbytes);
+
+      /**
+       * @brief Publish a message to all subscribers with timeout.
+       * @param [in] payload Pointer to a payload obtained from `alloc()`.
+       * @param [in] nbytes The length of the payload.
+       * @param [in] timeout The timeout duration.
+       * @retval result::ok The message was published.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EMSGSIZE The payload does not fit the pool block.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ETIMEDOUT The timeout expired before the message
+       *  could be published.
+       * @retval ENOTRECOVERABLE The message could not be published.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      timed_publish (void* payload, std::size_t nbytes,
+                     clock::duration_t timeout);
+
+      /**
+       * @brief Release a reference to a message.
+       * @param [in] payload Pointer to the message payload.
+       * @retval result::ok The reference was released.
+       * @retval EINVAL The payload does not belong to the topic pool,
+       *  or the message was already released.
+       */
+      result_t
+      release (const void* payload);
+
+      /**
+       * @brief Get the largest payload.
+       * @par Parameters
+       *  None.
+       * @return The number of bytes available in a message.
+       */
+      std::size_t
+      max_payload_size (void) const;
+
+      /**
+       * @brief Get the number of subscribers.
+       * @par Parameters
+       *  None.
+       * @return The number of subscribers.
+       */
+      std::size_t
+      subscribers (void) const;
+
+      /**
+       * @brief Get the memory pool.
+       * @par Parameters
+       *  None.
+       * @return Reference to the memory pool used for messages.
+       */
+      memory_pool&
+      pool (void);
+
+      /**
+       * @}
+       */
+
+    protected:
+      /**
+       * @name Private Member Functions
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      friend class topic_subscriber;
+
+      /**
+       * @brief Internal function used to prepare an allocated block.
+       * @param [in] block Pointer to pool block, or `nullptr`.
+       * @return Pointer to the payload, or `nullptr`.
+       */
+      void*
+      internal_payload_ (void* block);
+
+      /**
+       * @brief Internal function used to validate a payload.
+       * @param [in] payload Pointer to the message payload.
+       * @return Pointer to the message header, or `nullptr`.
+       */
+      message_header*
+      internal_header_ (const void* payload);
+
+      /**
+       * @brief Internal function used to deliver a message, if possible.
+       * @param [in] header Pointer to the message header.
+       * @retval true The message was delivered to all subscribers.
+       * @retval false A blocking subscriber is full.
+       */
+      bool
+      internal_try_publish_ (message_header* header);
+
+      /**
+       * @brief Internal function used to drop a reference.
+       * @param [in] header Pointer to the message header.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_release_ (message_header* header);
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+
+    protected:
+      /**
+       * @name Private Member Variables
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief List of threads waiting to publish.
+       */
+      internal::waiting_threads_list publish_list_;
+
+      /**
+       * @brief Pointer to clock to be used for timeouts.
+       */
+      clock* clock_ = nullptr;
+
+      /**
+       * @brief Pointer to the memory pool used for messages.
+       */
+      memory_pool* pool_ = nullptr;
+
+      /**
+       * @brief List of subscribers (topic_subscriber objects).
+       */
+      utils::double_list subscribers_;
+
+      /**
+       * @brief Number of subscribers.
+       */
+      std::size_t subscribers_count_ = 0;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+    };
+
+    // ========================================================================
+
+    /**
+     * @brief Subscriber of a **topic**, using the default RTOS allocator.
+     * @headerfile os.h <micro-os-plus/rtos.h>
+     * @ingroup micro-os-plus-rtos-topic
+     */
+    class topic_subscriber : public internal::object_named_system
+    {
+    public:
+      // ======================================================================
+
+      /**
+       * @brief Topic subscriber attributes.
+       * @headerfile os.h <micro-os-plus/rtos.h>
+       * @ingroup micro-os-plus-rtos-topic
+       */
+      class attributes : public internal::attributes_clocked
+      {
+      public:
+        /**
+         * @name Constructors & Destructor
+         * @{
+         */
+
+        /**
+         * @brief Construct a subscriber attributes object instance.
+         * @par Parameters
+         *  None.
+         */
+        constexpr attributes ();
+
+        // The rule of five.
+        attributes (const attributes&) = default;
+        attributes (attributes&&) = default;
+        attributes&
+        operator= (const attributes&)
+            = default;
+        attributes&
+        operator= (attributes&&)
+            = default;
+
+        /**
+         * @brief Destruct the subscriber attributes object instance.
+         */
+        ~attributes () = default;
+
+        /**
+         * @}
+         */
+
+      public:
+        /**
+         * @name Public Member Variables
+         * @{
+         */
+
+        // Public members; no accessors and mutators required.
+
+        /**
+         * @brief Address of the user defined storage for the queue.
+         */
+        void* arena_address = nullptr;
+
+        /**
+         * @brief Size of the user defined storage for the queue.
+         */
+        std::size_t arena_size_bytes = 0;
+
+        /**
+         * @brief Policy used when the queue is full.
+         */
+        rtos::topic::overflow_t overflow = rtos::topic::overflow::default_;
+
+        // Add more attributes here.
+
+        /**
+         * @}
+         */
+
+      }; /* class attributes */
+
+      /**
+       * @brief Default subscriber initialiser.
+       * @ingroup micro-os-plus-rtos-topic
+       */
+      static const attributes initializer;
+
+      /**
+       * @brief Default RTOS allocator.
+       * @ingroup micro-os-plus-rtos-topic
+       */
+      using allocator_type = memory::allocator<void*>;
+
+      // ======================================================================
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+      /**
+       * @brief Construct a subscriber object instance.
+       * @param [in] topic Reference to the topic.
+       * @param [in] depth The maximum number of queued messages.
+       * @param [in] attributes Reference to attributes.
+       * @param [in] allocator Reference to allocator. Default a
+       * local temporary instance.
+       */
+      topic_subscriber (rtos::topic& topic, std::size_t depth,
+                        const attributes& attributes = initializer,
+                        const allocator_type& allocator = allocator_type ());
+
+      /**
+       * @brief Construct a named subscriber object instance.
+       * @param [in] name Pointer to name.
+       * @param [in] topic Reference to the topic.
+       * @param [in] depth The maximum number of queued messages.
+       * @param [in] attributes Reference to attributes.
+       * @param [in] allocator Reference to allocator. Default a
+       * local temporary instance.
+       */
+      topic_subscriber (const char* name, rtos::topic& topic,
+                        std::size_t depth,
+                        const attributes& attributes = initializer,
+                        const allocator_type& allocator = allocator_type ());
+
+    protected:
+      /**
+       * @cond ignore
+       */
+
+      // Internal constructor, used from templates.
+      topic_subscriber (const char* name);
+
+      /**
+       * @endcond
+       */
+
+    public:
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      topic_subscriber (const topic_subscriber&) = delete;
+      topic_subscriber (topic_subscriber&&) = delete;
+      topic_subscriber&
+      operator= (const topic_subscriber&)
+          = delete;
+      topic_subscriber&
+      operator= (topic_subscriber&&)
+          = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the subscriber object instance.
+       */
+      virtual ~topic_subscriber ();
+
+      /**
+       * @}
+       */
+
+    public:
+      /**
+       * @name Public Member Functions
+       * @{
+       */
+
+      /**
+       * @brief Receive a message.
+       * @param [out] payload The address where to store the pointer to
+       *  the message payload.
+       * @param [out] nbytes The address where to store the payload
+       *  length. The default is `nullptr`.
+       * @retval result::ok The message was received.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ENOTRECOVERABLE The message could not be received.
+       * @retval EINTR The operation was interrupted.
+       */
+      result_t
+      receive (const void** payload, std::size_t* nbytes = nullptr);
+
+      /**
+       * @brief Try to receive a message.
+       * @param [out] payload The address where to store the pointer to
+       *  the message payload.
+       * @param [out] nbytes The address where to store the payload
+       *  length. The default is `nullptr`.
+       * @retval result::ok The message was received.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EWOULDBLOCK The queue is empty.
+       */
+      result_t
+      try_receive (const void** payload, std::size_t* nbytes = nullptr);
+
+      /**
+       * @brief Receive a message with timeout.
+       * @param [out] payload The address where to store the pointer to
+       *  the message payload.
+       * @param [in] timeout The timeout duration.
+       * @param [out] nbytes The address where to store the payload
+       *  length. The default is `nullptr`.
+       * @retval result::ok The message was received.
+       * @retval EINVAL A parameter is invalid or outside of a permitted range.
+       * @retval EPERM Cannot be invoked from an Interrupt Service Routines.
+       * @retval ENOTRECOVERABLE The message could not be received.
+       * @retval EINTR The operation was interrupted.
+       * @retval ETIMEDOUT No message arrived before the
+       *  specified timeout expired.
+       */
+      result_t
+      timed_receive (const void** payload, clock::duration_t timeout,
+                     std::size_t* nbytes = nullptr);
+
+      /**
+       * @brief Release a received message.
+       * @param [in] payload Pointer to the message payload.
+       * @retval result::ok The message was released.
+       * @retval EINVAL The payload does not belong to the topic pool.
+       */
+      result_t
+      release (const void* payload);
+
+      /**
+       * @brief Get the queue capacity.
+       * @par Parameters
+       *  None.
+       * @return The max number of queued messages.
+       */
+      std::size_t
+      capacity (void) const;
+
+      /**
+       * @brief Get the queue length.
+       * @par Parameters
+       *  None.
+       * @return The number of queued messages.
+       */
+      std::size_t
+      length (void) const;
+
+      /**
+       * @brief Get the number of dropped messages.
+       * @par Parameters
+       *  None.
+       * @return The number of messages dropped due to overflow.
+       */
+      std::size_t
+      dropped (void) const;
+
+      /**
+       * @brief Get the overflow policy.
+       * @par Parameters
+       *  None.
+       * @return The overflow policy.
+       */
+      rtos::topic::overflow_t
+      overflow (void) const;
+
+      /**
+       * @brief Get the topic.
+       * @par Parameters
+       *  None.
+       * @return Reference to the topic.
+       */
+      rtos::topic&
+      topic (void);
+
+      /**
+       * @}
+       */
+
+    protected:
+      /**
+       * @name Private Member Functions
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      friend class rtos::topic;
+
+      /**
+       * @brief Internal function used during subscriber construction.
+       * @param [in] topic Reference to the topic.
+       * @param [in] depth The maximum number of queued messages.
+       * @param [in] attributes Reference to attributes.
+       * @param [in] arena_address Pointer to queue storage.
+       * @param [in] arena_size_bytes Size of queue storage.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_construct_ (rtos::topic& topic, std::size_t depth,
+                           const attributes& attributes, void* arena_address,
+                           std::size_t arena_size_bytes);
+
+      /**
+       * @brief Internal function used to enqueue a message.
+       * @param [in] header Pointer to the message header.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      internal_push_ (rtos::topic::message_header* header);
+
+      /**
+       * @brief Internal function used to dequeue the oldest message.
+       * @par Parameters
+       *  None.
+       * @return Pointer to the message header, or `nullptr`.
+       */
+      rtos::topic::message_header*
+      internal_pop_ (void);
+
+      /**
+       * @brief Internal function used to dequeue a message, if available.
+       * @param [out] payload The address where to store the pointer to
+       *  the message payload.
+       * @param [out] nbytes The address where to store the payload length.
+       * @retval true The message was dequeued.
+       * @retval false The queue is empty.
+       */
+      bool
+      internal_try_receive_ (const void** payload, std::size_t* nbytes);
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+
+    public:
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief Intrusive node used to link this subscriber to the topic.
+       */
+      utils::double_list_links topic_links_;
+
+      /**
+       * @endcond
+       */
+
+    protected:
+      /**
+       * @name Private Member Variables
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief List of threads waiting to receive.
+       */
+      internal::waiting_threads_list receive_list_;
+
+      /**
+       * @brief Pointer to clock to be used for timeouts.
+       */
+      clock* clock_ = nullptr;
+
+      /**
+       * @brief Pointer to the topic.
+       */
+      rtos::topic* topic_ = nullptr;
+
+      /**
+       * @brief Array of pointers to queued message headers.
+       */
+      rtos::topic::message_header** queue_ = nullptr;
+
+      /**
+       * @brief The dynamic address if the queue was allocated
+       * (and must be deallocated)
+       */
+      void* allocated_arena_address_ = nullptr;
+
+      /**
+       * @brief Pointer to allocator.
+       */
+      const void* allocator_ = nullptr;
+
+      /**
+       * @brief Total size of the dynamically allocated queue storage.
+       */
+      std::size_t allocated_arena_size_elements_ = 0;
+
+      /**
+       * @brief The maximum number of queued messages.
+       */
+      std::size_t depth_ = 0;
+
+      /**
+       * @brief Index of the oldest message.
+       */
+      std::size_t head_ = 0;
+
+      /**
+       * @brief The current number of queued messages.
+       */
+      volatile std::size_t count_ = 0;
+
+      /**
+       * @brief The number of messages dropped due to overflow.
+       */
+      std::size_t dropped_ = 0;
+
+      /**
+       * @brief Policy used when the queue is full.
+       */
+      rtos::topic::overflow_t overflow_ = rtos::topic::overflow::default_;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+    };
+
+    // ========================================================================
+
+    /**
+     * @brief Template of a **topic** subscriber with local storage.
+     * @headerfile os.h <micro-os-plus/rtos.h>
+     * @ingroup micro-os-plus-rtos-topic
+     */
+    template <std::size_t N>
+    class topic_subscriber_inclusive : public topic_subscriber
+    {
+    public:
+      /**
+       * @brief Local constant based on template definition.
+       */
+      static const std::size_t depth = N;
+
+      /**
+       * @name Constructors & Destructor
+       * @{
+       */
+
+      /**
+       * @brief Construct a subscriber object instance.
+       * @param [in] topic Reference to the topic.
+       * @param [in] attributes Reference to attributes.
+       */
+      topic_subscriber_inclusive (rtos::topic& topic,
+                                  const attributes& attributes
+                                  = initializer);
+
+      /**
+       * @brief Construct a named subscriber object instance.
+       * @param [in] name Pointer to name.
+       * @param [in] topic Reference to the topic.
+       * @param [in] attributes Reference to attributes.
+       */
+      topic_subscriber_inclusive (const char* name, rtos::topic& topic,
+                                  const attributes& attributes
+                                  = initializer);
+
+      /**
+       * @cond ignore
+       */
+
+      // The rule of five.
+      topic_subscriber_inclusive (const topic_subscriber_inclusive&)
+          = delete;
+      topic_subscriber_inclusive (topic_subscriber_inclusive&&) = delete;
+      topic_subscriber_inclusive&
+      operator= (const topic_subscriber_inclusive&)
+          = delete;
+      topic_subscriber_inclusive&
+      operator= (topic_subscriber_inclusive&&)
+          = delete;
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @brief Destruct the subscriber object instance.
+       */
+      virtual ~topic_subscriber_inclusive ();
+
+      /**
+       * @}
+       */
+
+    protected:
+      /**
+       * @name Private Member Variables
+       * @{
+       */
+
+      /**
+       * @cond ignore
+       */
+
+      /**
+       * @brief Local storage for the queue.
+       */
+      rtos::topic::message_header* arena_[depth];
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @}
+       */
+    };
+
+#pragma GCC diagnostic pop
+
+  } // namespace rtos
+} // namespace micro_os_plus
+
+// ===== Inline & template implementations ====================================
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    constexpr topic::attributes::attributes ()
+    {
+      ;
+    }
+
+    // ========================================================================
+
+    /**
+     * @details
+     * Identical topics should have the same memory address.
+     */
+    inline bool
+    topic::operator== (const topic& rhs) const
+    {
+      return this == &rhs;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    topic::max_payload_size (void) const
+    {
+      return pool_->block_size () - header_size_bytes;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    topic::subscribers (void) const
+    {
+      return subscribers_count_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline memory_pool&
+    topic::pool (void)
+    {
+      return *pool_;
+    }
+
+    // ========================================================================
+
+    constexpr topic_subscriber::attributes::attributes ()
+    {
+      ;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    topic_subscriber::capacity (void) const
+    {
+      return depth_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    topic_subscriber::length (void) const
+    {
+      return count_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline std::size_t
+    topic_subscriber::dropped (void) const
+    {
+      return dropped_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::topic::overflow_t
+    topic_subscriber::overflow (void) const
+    {
+      return overflow_;
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline rtos::topic&
+    topic_subscriber::topic (void)
+    {
+      return *topic_;
+    }
+
+    /**
+     * @details
+     * Wrapper over the topic method.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    inline result_t
+    topic_subscriber::release (const void* payload)
+    {
+      return topic_->release (payload);
+    }
+
+    // ========================================================================
+
+    /**
+     * @details
+     * The queue storage is statically allocated inside the
+     * subscriber object instance.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template <std::size_t N>
+    inline topic_subscriber_inclusive<N>::topic_subscriber_inclusive (
+        rtos::topic& topic, const attributes& _attributes)
+        : topic_subscriber_inclusive{ nullptr, topic, _attributes }
+    {
+      ;
+    }
+
+    /**
+     * @details
+     * The queue storage is statically allocated inside the
+     * subscriber object instance.
+     *
+     * Passing a storage via the attributes is not allowed
+     * and might trigger an assert.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    template <std::size_t N>
+    topic_subscriber_inclusive<N>::topic_subscriber_inclusive (
+        const char* name, rtos::topic& topic, const attributes& _attributes)
+        : topic_subscriber{ name }
+    {
+      internal_construct_ (topic, depth, _attributes, &arena_,
+                           sizeof (arena_));
+    }
+
+    /**
+     * @details
+     * Implemented as a wrapper over the parent destructor.
+     */
+    template <std::size_t N>
+    topic_subscriber_inclusive<N>::~topic_subscriber_inclusive ()
+    {
+      ;
+    }
+
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_RTOS_TOPIC_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,182 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef MICRO_OS_PLUS_RTOS_WAKEUP_GRAPH_H_
+#define MICRO_OS_PLUS_RTOS_WAKEUP_GRAPH_H_
+
+// ----------------------------------------------------------------------------
+
+#if defined(__cplusplus)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH) || defined(__DOXYGEN__)
+
+// ----------------------------------------------------------------------------
+
+#include <micro-os-plus/rtos/declarations.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    /**
+     * @brief Causal wakeup graph.
+     * @ingroup micro-os-plus-rtos-core
+     * @details
+     * Each time a blocked thread is resumed, the waker (the running
+     * thread, or an interrupt), the resumed thread and the object
+     * it was waiting for identify an edge of the graph; when the
+     * resumed thread starts running, the edge counts the wakeup and
+     * accumulates the latency, in CPU cycles.
+     *
+     * Following the edges gives the chain of resumes in multi-stage
+     * pipelines; the table printed with `trace_print()` can be
+     * rendered with `scripts/wakeup-graph.py`, which also shows the
+     * critical path.
+     *
+     * Threads and names are identified by their addresses; the
+     * edges of a thread are removed when the thread is destroyed,
+     * so they never refer to released threads or names.
+     *
+     * @note Available only when
+     * `MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH` is defined; it also
+     * enables `MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT`
+     * and `MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY`.
+     * The number of edges is configured with
+     * `MICRO_OS_PLUS_INTEGER_RTOS_WAKEUP_GRAPH_EDGES`
+     * (default 32, must be a power of 2); when the table is full,
+     * new edges are only counted as dropped.
+     */
+    namespace wakeup_graph
+    {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpadded"
+
+      /**
+       * @brief Statistics of a wakeup edge.
+       */
+      struct edge
+      {
+        // The thread which called resume(), or nullptr for interrupts.
+        const thread* waker;
+        // The resumed thread; nullptr for empty entries.
+        const thread* wakee;
+        // The object the resumed thread was waiting for, if any.
+        const void* object;
+        const char* waker_name;
+        const char* wakee_name;
+        // Number of wakeups which reached the resumed thread.
+        uint32_t count;
+        rtos::statistics::wait_reason reason;
+        // From resume() to the resumed thread running.
+        rtos::statistics::duration_t total_latency_cycles;
+      };
+
+#pragma GCC diagnostic pop
+
+      /**
+       * @brief Get the edges, sorted by the total latency.
+       * @param [out] out Pointer to an array of edges.
+       * @param [in] count Number of elements in the array.
+       * @return Number of edges stored.
+       */
+      std::size_t
+      report (edge* out, std::size_t count) noexcept;
+
+      /**
+       * @brief Get the number of wakeups which did not fit in the table.
+       * @par Parameters
+       *  None.
+       * @return Integer.
+       */
+      uint32_t
+      dropped (void) noexcept;
+
+      /**
+       * @brief Clear all edges.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      clear (void) noexcept;
+
+      /**
+       * @brief Print the edges, using `trace::printf()`.
+       * @par Parameters
+       *  None.
+       * @par Returns
+       *  Nothing.
+       */
+      void
+      trace_print (void);
+
+      /**
+       * @cond ignore
+       */
+
+      edge*
+      internal_find_ (const thread* waker, const thread* wakee,
+                      const void* object,
+                      rtos::statistics::wait_reason reason) noexcept;
+
+      void
+      internal_record_ (edge* e, const thread* wakee,
+                        rtos::statistics::duration_t latency) noexcept;
+
+      void
+      internal_forget_ (const thread* th) noexcept;
+
+      /**
+       * @endcond
+       */
+
+    } // namespace wakeup_graph
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+
+#endif // __cplusplus
+
+// ----------------------------------------------------------------------------
+
+#endif // MICRO_OS_PLUS_RTOS_WAKEUP_GRAPH_H_
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+#
+# This file is part of the µOS++ distribution.
+#   (https://github.com/micro-os-plus)
+# Copyright (c) 2016 Liviu Ionescu.
+#
+# Permission is hereby granted, free of charge, to any person
+# obtaining a copy of this software and associated documentation
+# files (the "Software"), to deal in the Software without
+# restriction, including without limitation the rights to use,
+# copy, modify, merge, publish, distribute, sublicense, and/or
+# sell copies of the Software, and to permit persons to whom
+# the Software is furnished to do so, subject to the following
+# conditions:
+#
+# The above copyright notice and this permission notice shall be
+# included in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+# OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+# NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+# HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+# WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+# OTHER DEALINGS IN THE SOFTWARE.
+#
+
+"""
+Format a µOS++ deferred log dump on the host.
+
+The input is the buffer written by `rtos::deferred_log::dump()`,
+saved from the target, and the ELF file of the application, from
+which the format strings and the `%s` arguments are read.
+
+Usage:
+    deferred-log-decode.py log.bin app.elf [--timestamps]
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+DUMP_MAGIC = 0x6C534F75
+DUMP_VERSION = 1
+
+HEADER = struct.Struct("<IHHIIIB3x")
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+# %[flags][width][.precision][length]conversion
+SPEC = re.compile(
+    r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t|L)?([diouxXcspn%])")
+
+
+class Elf:
+    """
+    Minimal reader for the allocated sections of a little endian ELF.
+    """
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+
+        if data[:4] != b"\x7fELF":
+            raise ValueError("%s is not an ELF file" % path)
+        if data[5] != 1:
+            raise ValueError("only little endian ELF files are supported")
+
+        if data[4] == 1:
+            shoff, = struct.unpack_from("<I", data, 0x20)
+            shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+            layout = struct.Struct("<IIIIIIIIII")
+        else:
+            shoff, = struct.unpack_from("<Q", data, 0x28)
+            shentsize, shnum = struct.unpack_from("<HH", data, 0x3A)
+            layout = struct.Struct("<IIQQQQIIQQ")
+
+        self.sections = []
+        for i in range(shnum):
+            (_, sh_type, flags, addr, offset, size,
+             _, _, _, _) = layout.unpack_from(data, shoff + i * shentsize)
+            if flags & SHF_ALLOC and sh_type != SHT_NOBITS and size:
+                self.sections.append(
+                    (addr, data[offset:offset + size]))
+
+    def string(self, address):
+        for addr, content in self.sections:
+            if addr <= address < addr + len(content):
+                start = address - addr
+                end = content.find(b"\0", start)
+                if end < 0:
+                    end = len(content)
+                return content[start:end].decode("utf-8", "replace")
+        return None
+
+
+def parse(data):
+    if len(data) < HEADER.size:
+        raise ValueError("dump too short")
+
+    (magic, version, record_size, count, frequency, dropped,
+     word_size) = HEADER.unpack_from(data)
+    if magic != DUMP_MAGIC:
+        raise ValueError("bad magic 0x%08X" % magic)
+    if version != DUMP_VERSION:
+        raise ValueError("unsupported version %d" % version)
+    if word_size not in (4, 8):
+        raise ValueError("unexpected word size %d" % word_size)
+
+    # Index and timestamp, format and arguments.
+    nargs = (record_size - 8) // word_size - 1
+    record = struct.Struct("<II" + ("I" if word_size == 4 else "Q") *
+                           (1 + nargs))
+    if record.size != record_size:
+        raise ValueError("unexpected record size %d" % record_size)
+
+    available = (len(data) - HEADER.size) // record_size
+    if count > available:
+        print("warning: dump truncated, %d of %d records" %
+              (available, count), file=sys.stderr)
+        count = available
+
+    records = [record.unpack_from(data, HEADER.size + i * record_size)
+               for i in range(count)]
+    return frequency, dropped, word_size, records
+
+
+def format_record(elf, fmt, args, word_size):
+    """
+    Apply the C format to the raw argument words.
+    """
+    values = iter(args)
+    out = []
+    pos = 0
+    for m in SPEC.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, precision, length, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+
+        if width == "*":
+            width = str(_signed(next(values, 0), 32))
+        if precision == "*":
+            precision = str(_signed(next(values, 0), 32))
+        spec = "%" + flags + (width or "") + \
+            ("." + precision if precision is not None else "")
+
+        value = next(values, 0)
+        if conv == "p":
+            # Pointers use the full word.
+            out.append("0x%0*x" % (word_size * 2, value))
+            continue
+
+        if length in ("ll", "j", "L") or (length in ("l", "z", "t")
+                                          and word_size == 8):
+            size = 64
+        elif length == "hh":
+            size = 8
+        elif length == "h":
+            size = 16
+        else:
+            size = 32
+        value &= (1 << size) - 1
+
+        if conv in "di":
+            out.append((spec + "d") % _signed(value, size))
+        elif conv in "ouxX":
+            out.append((spec + conv) % value)
+        elif conv == "c":
+            out.append((spec + "c") % chr(value & 0xFF))
+        elif conv == "s":
+            text = elf.string(value)
+            if text is None:
+                text = "<0x%x>" % value
+            out.append((spec + "s") % text)
+        else:
+            out.append(m.group(0))
+
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+def _signed(value, bits):
+    if value & (1 << (bits - 1)):
+        return value - (1 << bits)
+    return value
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Format a µOS++ deferred log dump.")
+    parser.add_argument("dump", help="binary dump file")
+    parser.add_argument("elf", help="application ELF file")
+    parser.add_argument("-t", "--timestamps", action="store_true",
+                        help="prefix lines with the time, in seconds")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        data = f.read()
+
+    try:
+        frequency, dropped, word_size, records = parse(data)
+        elf = Elf(args.elf)
+    except ValueError as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+
+    if dropped:
+        print("warning: %d records dropped on the target" % dropped,
+              file=sys.stderr)
+
+    now = 0
+    prev = None
+    prev_index = None
+    for index, timestamp, fmt_address, *words in records:
+        if prev_index is not None and index != (prev_index + 1) & 0xFFFFFFFF:
+            sys.stdout.write("... %d records lost ...\n" %
+                             ((index - prev_index - 1) & 0xFFFFFFFF))
+        prev_index = index
+
+        if prev is not None:
+            delta = (timestamp - prev) & 0xFFFFFFFF
+            if delta >= 0x80000000:
+                delta -= 0x100000000
+            now += delta
+        prev = timestamp
+
+        fmt = elf.string(fmt_address)
+        if fmt is None:
+            text = "<format 0x%x> %s\n" % (
+                fmt_address, " ".join("0x%x" % w for w in words))
+        else:
+            text = format_record(elf, fmt, words, word_size)
+
+        if args.timestamps:
+            seconds = now / frequency if frequency else float(now)
+            text = "[%12.6f] %s" % (seconds, text)
+        sys.stdout.write(text)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
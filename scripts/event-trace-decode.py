@@ -0,0 +1,289 @@
+#!/usr/bin/env python3
+#
+# This file is part of the µOS++ distribution.
+#   (https://github.com/micro-os-plus)
+# Copyright (c) 2016 Liviu Ionescu.
+#
+# Permission is hereby granted, free of charge, to any person
+# obtaining a copy of this software and associated documentation
+# files (the "Software"), to deal in the Software without
+# restriction, including without limitation the rights to use,
+# copy, modify, merge, publish, distribute, sublicense, and/or
+# sell copies of the Software, and to permit persons to whom
+# the Software is furnished to do so, subject to the following
+# conditions:
+#
+# The above copyright notice and this permission notice shall be
+# included in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+# OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+# NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+# HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+# WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+# OTHER DEALINGS IN THE SOFTWARE.
+#
+
+"""
+Decode a µOS++ binary scheduler event trace.
+
+The input is the buffer written by `rtos::event_trace::dump()`,
+saved from the target (debugger memory dump, semihosting, etc).
+The output is a Chrome trace JSON timeline (open it with
+chrome://tracing or https://ui.perfetto.dev), and optionally
+a per-thread summary.
+
+Usage:
+    event-trace-decode.py trace.bin -o trace.json --summary
+"""
+
+import argparse
+import collections
+import json
+import struct
+import sys
+
+DUMP_MAGIC = 0x74534F75
+DUMP_VERSION = 1
+
+HEADER = struct.Struct("<IHHII")
+RECORD = struct.Struct("<IBBHII")
+
+THREAD_NAME = 1
+CONTEXT_SWITCH = 2
+THREAD_RESUME = 3
+THREAD_SUSPEND = 4
+MUTEX_CONTENTION = 5
+QUEUE_SEND = 6
+QUEUE_RECEIVE = 7
+ISR_ENTER = 8
+ISR_EXIT = 9
+USER = 10
+
+INSTANT_NAMES = {
+    THREAD_RESUME: "resume",
+    THREAD_SUSPEND: "suspend",
+    MUTEX_CONTENTION: "mutex contention",
+    QUEUE_SEND: "queue send",
+    QUEUE_RECEIVE: "queue receive",
+    USER: "user",
+}
+
+ISR_TID = 0
+
+
+def parse(data):
+    if len(data) < HEADER.size:
+        raise ValueError("dump too short")
+
+    magic, version, record_size, count, frequency = HEADER.unpack_from(data)
+    if magic != DUMP_MAGIC:
+        raise ValueError("bad magic 0x%08X" % magic)
+    if version != DUMP_VERSION:
+        raise ValueError("unsupported version %d" % version)
+    if record_size != RECORD.size:
+        raise ValueError("unexpected record size %d" % record_size)
+
+    available = (len(data) - HEADER.size) // RECORD.size
+    if count > available:
+        print("warning: dump truncated, %d of %d records" %
+              (available, count), file=sys.stderr)
+        count = available
+
+    records = [RECORD.unpack_from(data, HEADER.size + i * RECORD.size)
+               for i in range(count)]
+    return frequency, records
+
+
+def collect_names(records):
+    chunks = collections.defaultdict(dict)
+    for _, kind, arg, _, obj, value in records:
+        if kind == THREAD_NAME:
+            chunks[obj][arg] = struct.pack("<I", value)
+
+    names = {}
+    for obj, parts in chunks.items():
+        raw = b"".join(parts[i] for i in sorted(parts))
+        names[obj] = raw.split(b"\0", 1)[0].decode("utf-8", "replace")
+    return names
+
+
+def unwrap(records):
+    """
+    Yield (time, kind, arg, obj, value) with 64-bit timestamps.
+    Small negative deltas are kept, since a record may be
+    timestamped after a record reserved later by an interrupt.
+    """
+    now = 0
+    prev = None
+    prev_seq = None
+    gaps = 0
+    for raw, kind, arg, seq, obj, value in records:
+        if kind == THREAD_NAME:
+            continue
+        if prev is not None:
+            delta = (raw - prev) & 0xFFFFFFFF
+            if delta >= 0x80000000:
+                delta -= 0x100000000
+            now += delta
+            if (seq - prev_seq) & 0xFFFF != 1:
+                gaps += 1
+        prev = raw
+        prev_seq = seq
+        yield now, kind, arg, obj, value
+
+    if gaps:
+        print("warning: %d gaps in the record sequence" % gaps,
+              file=sys.stderr)
+
+
+def decode(frequency, records):
+    names = collect_names(records)
+
+    def label(obj):
+        return names.get(obj, "0x%08X" % obj)
+
+    def usec(ticks):
+        return ticks * 1e6 / frequency if frequency else float(ticks)
+
+    events = []
+    stats = collections.defaultdict(collections.Counter)
+    run_time = collections.Counter()
+    isr_time = collections.Counter()
+    isr_stack = []
+    contention = collections.Counter()
+
+    running = None
+    since = None
+    start = None
+    end = None
+
+    for now, kind, arg, obj, value in unwrap(records):
+        if start is None:
+            start = now
+        end = now
+
+        if kind == CONTEXT_SWITCH:
+            old = running if running is not None else value
+            if since is not None:
+                run_time[old] += now - since
+                events.append({
+                    "name": label(old), "ph": "X", "pid": 0, "tid": old,
+                    "ts": usec(since), "dur": usec(now - since),
+                })
+            running = obj
+            since = now
+            stats[obj]["switches"] += 1
+        elif kind == ISR_ENTER:
+            isr_stack.append((arg, now))
+            events.append({"name": "irq %d" % arg, "ph": "B", "pid": 0,
+                           "tid": ISR_TID, "ts": usec(now)})
+        elif kind == ISR_EXIT:
+            if isr_stack:
+                irq, begin = isr_stack.pop()
+                isr_time[irq] += now - begin
+            events.append({"name": "irq %d" % arg, "ph": "E", "pid": 0,
+                           "tid": ISR_TID, "ts": usec(now)})
+        elif kind in INSTANT_NAMES:
+            if kind in (THREAD_RESUME, THREAD_SUSPEND):
+                tid = obj
+                stats[obj][INSTANT_NAMES[kind]] += 1
+                args = {"priority": arg}
+            else:
+                tid = running if running is not None else ISR_TID
+                args = {"object": label(obj), "arg": arg, "value": value}
+                if kind == MUTEX_CONTENTION:
+                    contention[obj] += 1
+                    if running is not None:
+                        stats[running]["contentions"] += 1
+                    args["owner"] = label(value)
+            events.append({"name": INSTANT_NAMES[kind], "ph": "i",
+                           "s": "t", "pid": 0, "tid": tid,
+                           "ts": usec(now), "args": args})
+
+    if running is not None and since is not None:
+        run_time[running] += end - since
+        events.append({"name": label(running), "ph": "X", "pid": 0,
+                       "tid": running, "ts": usec(since),
+                       "dur": usec(end - since)})
+
+    tids = set(stats) | set(run_time)
+    for tid in sorted(tids):
+        events.append({"name": "thread_name", "ph": "M", "pid": 0,
+                       "tid": tid, "args": {"name": label(tid)}})
+    events.append({"name": "thread_name", "ph": "M", "pid": 0,
+                   "tid": ISR_TID, "args": {"name": "interrupts"}})
+
+    summary = {
+        "duration": (end - start) if start is not None else 0,
+        "threads": {tid: (run_time[tid], stats[tid]) for tid in tids},
+        "isr": isr_time,
+        "contention": contention,
+    }
+    return {"traceEvents": events, "displayTimeUnit": "ns"}, summary, label
+
+
+def print_summary(summary, label, frequency, out):
+    total = summary["duration"] or 1
+
+    def usec(ticks):
+        return ticks * 1e6 / frequency if frequency else float(ticks)
+
+    out.write("%-16s %12s %7s %9s %8s %8s %8s\n" %
+              ("thread", "run [us]", "cpu %", "switches", "resumes",
+               "suspends", "contend"))
+    threads = summary["threads"]
+    for tid in sorted(threads, key=lambda t: -threads[t][0]):
+        run, counters = threads[tid]
+        out.write("%-16s %12.1f %7.2f %9d %8d %8d %8d\n" % (
+            label(tid)[:16], usec(run), 100.0 * run / total,
+            counters["switches"], counters["resume"],
+            counters["suspend"], counters["contentions"]))
+
+    for irq in sorted(summary["isr"]):
+        out.write("irq %-12d %12.1f %7.2f\n" % (
+            irq, usec(summary["isr"][irq]),
+            100.0 * summary["isr"][irq] / total))
+
+    for mutex, count in summary["contention"].most_common():
+        out.write("mutex %-10s contended %d times\n" % (label(mutex), count))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decode a µOS++ binary scheduler event trace.")
+    parser.add_argument("dump", help="binary dump file")
+    parser.add_argument("-o", "--output",
+                        help="Chrome trace JSON file (default: stdout)")
+    parser.add_argument("-s", "--summary", action="store_true",
+                        help="print per-thread summary to stderr")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        data = f.read()
+
+    try:
+        frequency, records = parse(data)
+    except ValueError as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+
+    trace, summary, label = decode(frequency, records)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+        sys.stdout.write("\n")
+
+    if args.summary:
+        print_summary(summary, label, frequency, sys.stderr)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
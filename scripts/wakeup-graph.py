@@ -0,0 +1,221 @@
+#!/usr/bin/env python3
+#
+# This file is part of the µOS++ distribution.
+#   (https://github.com/micro-os-plus)
+# Copyright (c) 2016 Liviu Ionescu.
+#
+# Permission is hereby granted, free of charge, to any person
+# obtaining a copy of this software and associated documentation
+# files (the "Software"), to deal in the Software without
+# restriction, including without limitation the rights to use,
+# copy, modify, merge, publish, distribute, sublicense, and/or
+# sell copies of the Software, and to permit persons to whom
+# the Software is furnished to do so, subject to the following
+# conditions:
+#
+# The above copyright notice and this permission notice shall be
+# included in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+# OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+# NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+# HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+# WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+# OTHER DEALINGS IN THE SOFTWARE.
+#
+
+"""
+Render the µOS++ causal wakeup graph.
+
+The input is the trace output of `rtos::wakeup_graph::trace_print()`,
+captured from the target (semihosting, SWO, UART, etc). If the log
+contains several reports, the last one is used.
+
+The output is a Graphviz DOT graph (render it with
+`dot -Tsvg graph.dot -o graph.svg`), with one node per thread,
+plus one for the interrupts, and one arrow per waker/wakee/object,
+labelled with the wait reason, the number of wakeups and the
+average latency. The critical path, the chain of wakeups with the
+largest sum of average latencies, is highlighted and also
+printed as text.
+
+Usage:
+    wakeup-graph.py trace.log -o graph.dot [--from ISR] [--hz 168000000]
+"""
+
+import argparse
+import re
+import sys
+
+HEADER = re.compile(r"Wakeup graph, (\d+) edges, (\d+) dropped")
+EDGE = re.compile(r"^\s*(.+?) -> (.+?), (\w+) (\S+), (\d+) times, "
+                  r"avg (\d+) cycles\s*$")
+
+
+class Edge:
+    def __init__(self, waker, wakee, reason, obj, count, latency):
+        self.waker = waker
+        self.wakee = wakee
+        self.reason = reason
+        self.obj = obj
+        self.count = count
+        self.latency = latency
+
+
+def parse(lines):
+    """Return the edges and dropped count of the last report."""
+    edges = None
+    dropped = 0
+    for line in lines:
+        m = HEADER.search(line)
+        if m:
+            edges = []
+            dropped = int(m.group(2))
+            continue
+        if edges is None:
+            continue
+        m = EDGE.match(line)
+        if m:
+            edges.append(Edge(m.group(1), m.group(2), m.group(3),
+                              m.group(4), int(m.group(5)), int(m.group(6))))
+    if edges is None:
+        raise ValueError("no wakeup graph report found")
+    return edges, dropped
+
+
+def critical_path(edges, start=None):
+    """
+    Return the simple path with the largest sum of average
+    latencies, as a list of edges.
+    """
+    # Between two threads keep the slowest edge.
+    adjacency = {}
+    for e in edges:
+        if e.count == 0:
+            continue
+        out = adjacency.setdefault(e.waker, {})
+        if e.wakee not in out or out[e.wakee].latency < e.latency:
+            out[e.wakee] = e
+
+    best = (0, [])
+
+    def walk(node, visited, total, path):
+        nonlocal best
+        if total > best[0]:
+            best = (total, list(path))
+        for wakee, e in adjacency.get(node, {}).items():
+            if wakee in visited:
+                continue
+            visited.add(wakee)
+            path.append(e)
+            walk(wakee, visited, total + e.latency, path)
+            path.pop()
+            visited.remove(wakee)
+
+    starts = [start] if start is not None else list(adjacency)
+    for node in starts:
+        walk(node, {node}, 0, [])
+
+    return best[1]
+
+
+def format_latency(cycles, hz):
+    if hz:
+        return "%.1f us" % (cycles * 1e6 / hz)
+    return "%d cycles" % cycles
+
+
+def quote(name):
+    name = name.replace("\\", "\\\\").replace('"', '\\"')
+    return '"%s"' % name.replace("\n", "\\n")
+
+
+def render(edges, path, hz, out):
+    on_path = set(id(e) for e in path)
+    nodes = set()
+    for e in edges:
+        nodes.add(e.waker)
+        nodes.add(e.wakee)
+
+    out.write("digraph wakeups {\n")
+    out.write("    rankdir=LR;\n")
+    out.write("    node [shape=ellipse];\n")
+    for node in sorted(nodes):
+        attrs = ""
+        if node == "ISR":
+            attrs = " [shape=box]"
+        out.write("    %s%s;\n" % (quote(node), attrs))
+
+    for e in edges:
+        label = "%s %s\n%d x, avg %s" % (e.reason, e.obj, e.count,
+                                          format_latency(e.latency, hz))
+        attrs = "label=%s" % quote(label)
+        if id(e) in on_path:
+            attrs += ", color=red, penwidth=2"
+        out.write("    %s -> %s [%s];\n" % (quote(e.waker), quote(e.wakee),
+                                            attrs))
+    out.write("}\n")
+
+
+def print_path(path, hz, out):
+    if not path:
+        print("No critical path.", file=out)
+        return
+
+    total = sum(e.latency for e in path)
+    print("Critical path, %s:" % format_latency(total, hz), file=out)
+    print("  %s" % path[0].waker, file=out)
+    for e in path:
+        print("  -> %s (%s %s, %d x, avg %s)"
+              % (e.wakee, e.reason, e.obj, e.count,
+                 format_latency(e.latency, hz)), file=out)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Render the µOS++ causal wakeup graph.")
+    parser.add_argument("log", nargs="?",
+                        help="trace log (default: stdin)")
+    parser.add_argument("-o", "--output",
+                        help="Graphviz DOT file (default: stdout)")
+    parser.add_argument("-f", "--from", dest="start",
+                        help="start the critical path from this thread "
+                        "(or ISR)")
+    parser.add_argument("--hz", type=int, default=0,
+                        help="CPU clock frequency, to show microseconds")
+    args = parser.parse_args()
+
+    if args.log:
+        with open(args.log, "r", errors="replace") as f:
+            lines = f.readlines()
+    else:
+        lines = sys.stdin.readlines()
+
+    try:
+        edges, dropped = parse(lines)
+    except ValueError as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+
+    if dropped:
+        print("warning: %d wakeups dropped, increase "
+              "MICRO_OS_PLUS_INTEGER_RTOS_WAKEUP_GRAPH_EDGES" % dropped,
+              file=sys.stderr)
+
+    path = critical_path(edges, args.start)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            render(edges, path, args.hz, f)
+    else:
+        render(edges, path, args.hz, sys.stdout)
+
+    print_path(path, args.hz, sys.stderr)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
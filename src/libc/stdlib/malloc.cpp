@@ -32,6 +32,9 @@
 
 #include <micro-os-plus/rtos.h>
 #include <micro-os-plus/estd/memory_resource>
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+#include <micro-os-plus/rtos/memory-heap-arena.h>
+#endif
 
 #include <malloc.h>
 
@@ -41,6 +44,40 @@ using namespace micro_os_plus;
 
 // ----------------------------------------------------------------------------
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+
+/**
+ * @cond ignore
+ */
+
+namespace
+{
+  // Allocate from the arena of the current thread, if any,
+  // without locking the scheduler. Always inlined, so the heap
+  // profiler records the caller of `malloc()`.
+  inline __attribute__ ((always_inline)) void*
+  arena_allocate (
+      std::size_t bytes,
+      std::size_t alignment = rtos::memory::memory_resource::max_align)
+  {
+    rtos::memory::heap_arena* arena = rtos::memory::heap_arena::current ();
+    if (arena == nullptr)
+      {
+        return nullptr;
+      }
+
+    return arena->allocate (bytes, alignment);
+  }
+} // namespace
+
+/**
+ * @endcond
+ */
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+
+// ----------------------------------------------------------------------------
+
 /**
  * @addtogroup micro-os-plus-rtos-c-memres
  * @{
@@ -83,7 +120,9 @@ using namespace micro_os_plus;
  * null pointer and set `errno` to indicate the error.
  *
  * @note In µOS++ this function uses a scheduler critical section
- * and is thread safe.
+ * and is thread safe. When thread heap arenas are enabled, blocks
+ * belonging to the arena of the current thread are processed
+ * without locking the scheduler.
  *
  * @par POSIX compatibility
  *  Inspired by
@@ -99,6 +138,19 @@ malloc (size_t bytes)
   assert (!rtos::interrupts::in_handler_mode ());
 
   void* mem;
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+  mem = arena_allocate (bytes);
+  if (mem != nullptr)
+    {
+      errno = 0;
+#if defined(MICRO_OS_PLUS_TRACE_LIBC_MALLOC)
+      trace::printf ("::%s(%d)=%p\n", __func__, bytes, mem);
+#endif
+      return mem;
+    }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+
   {
     // ----- Begin of critical section --------------------------------------
     rtos::scheduler::critical_section scs;
@@ -152,7 +204,9 @@ malloc (size_t bytes)
  * to indicate the error.
  *
  * @note In µOS++ this function uses a scheduler critical section
- * and is thread safe.
+ * and is thread safe. When thread heap arenas are enabled, blocks
+ * belonging to the arena of the current thread are processed
+ * without locking the scheduler.
  *
  * @par POSIX compatibility
  *  Inspired by
@@ -173,18 +227,24 @@ calloc (size_t nelem, size_t elbytes)
       return nullptr;
     }
 
-  void* mem;
-  {
-    // ----- Begin of critical section --------------------------------------
-    rtos::scheduler::critical_section scs;
+  void* mem = nullptr;
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+  mem = arena_allocate (nelem * elbytes);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
 
-    mem = estd::pmr::get_default_resource ()->allocate (nelem * elbytes);
+  if (mem == nullptr)
+    {
+      // ----- Begin of critical section ------------------------------------
+      rtos::scheduler::critical_section scs;
+
+      mem = estd::pmr::get_default_resource ()->allocate (nelem * elbytes);
+      // ----- End of critical section --------------------------------------
+    }
 
 #if defined(MICRO_OS_PLUS_TRACE_LIBC_MALLOC)
-    trace::printf ("::%s(%u,%u)=%p\n", __func__, nelem, elbytes, mem);
+  trace::printf ("::%s(%u,%u)=%p\n", __func__, nelem, elbytes, mem);
 #endif
-    // ----- End of critical section ----------------------------------------
-  }
 
   if (mem != nullptr)
     {
@@ -253,7 +313,14 @@ calloc (size_t nelem, size_t elbytes)
  * the memory referenced by _ptr_ shall not be changed.
  *
  * @note In µOS++ this function uses a scheduler critical section
- * and is thread safe.
+ * and is thread safe. When thread heap arenas are enabled, blocks
+ * belonging to the arena of the current thread are processed
+ * without locking the scheduler.
+ *
+ * @note If the memory resource supports it, the block is grown
+ * or shrunk in place; otherwise only the content of the old block
+ * is copied. The memory resource must report the block sizes via
+ * `usable_size()`; the default application free store does.
  *
  * @par POSIX compatibility
  *  Inspired by
@@ -270,6 +337,50 @@ realloc (void* ptr, size_t bytes)
 
   void* mem;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+  if (ptr == nullptr)
+    {
+      // Prefer the arena of the current thread.
+      return malloc (bytes);
+    }
+
+  rtos::memory::heap_arena* arena = rtos::memory::heap_arena::find (ptr);
+  if (arena != nullptr)
+    {
+      errno = 0;
+      if (bytes == 0)
+        {
+          free (ptr);
+          return nullptr;
+        }
+
+      // Only the owner thread can resize the block.
+      if (arena == rtos::memory::heap_arena::current ()
+          && arena->resize (ptr, bytes))
+        {
+#if defined(MICRO_OS_PLUS_TRACE_LIBC_MALLOC)
+          trace::printf ("::%s(%p,%u)=%p\n", __func__, ptr, bytes, ptr);
+#endif
+          return ptr;
+        }
+
+      std::size_t old_bytes = arena->usable_size (ptr);
+      if (old_bytes > bytes)
+        {
+          old_bytes = bytes;
+        }
+
+      mem = malloc (bytes);
+      if (mem != nullptr)
+        {
+          memcpy (mem, ptr, old_bytes);
+          free (ptr);
+        }
+
+      return mem;
+    }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+
   {
     // ----- Begin of critical section --------------------------------------
     rtos::scheduler::critical_section scs;
@@ -297,18 +408,35 @@ realloc (void* ptr, size_t bytes)
         return nullptr;
       }
 
-#if 0
-      /* TODO: There is chance to shrink the chunk if newly requested
-       * size is much small */
-      if (nano_malloc_usable_size (RCALL ptr) >= bytes)
-      return ptr;
+    rtos::memory::memory_resource* mr
+        = static_cast<rtos::memory::memory_resource*> (
+            estd::pmr::get_default_resource ());
+
+    // Try to grow or shrink the block without moving it.
+    if (mr->resize (ptr, bytes))
+      {
+#if defined(MICRO_OS_PLUS_TRACE_LIBC_MALLOC)
+        trace::printf ("::%s(%p,%u)=%p\n", __func__, ptr, bytes, ptr);
 #endif
+        return ptr;
+      }
 
-    mem = estd::pmr::get_default_resource ()->allocate (bytes);
+    // Copy only the content of the old block. The size must be
+    // known, otherwise the copy might read past the old block;
+    // resources which do not keep it must be adapted with
+    // `rtos::memory::sized_blocks<>`.
+    std::size_t old_bytes = mr->usable_size (ptr);
+    assert (old_bytes != 0);
+    if (old_bytes == 0 || old_bytes > bytes)
+      {
+        old_bytes = bytes;
+      }
+
+    mem = mr->allocate (bytes);
     if (mem != nullptr)
       {
-        memcpy (mem, ptr, bytes);
-        estd::pmr::get_default_resource ()->deallocate (ptr, 0);
+        memcpy (mem, ptr, old_bytes);
+        mr->deallocate (ptr, 0);
       }
     else
       {
@@ -346,7 +474,9 @@ realloc (void* ptr, size_t bytes)
  * The `free()` function shall not return a value.
  *
  * @note In µOS++ this function uses a scheduler critical section
- * and is thread safe.
+ * and is thread safe. When thread heap arenas are enabled, blocks
+ * belonging to the arena of the current thread are processed
+ * without locking the scheduler.
  *
  * @par POSIX compatibility
  *  Inspired by
@@ -366,18 +496,250 @@ free (void* ptr)
       return;
     }
 
-  // ----- Begin of critical section ------------------------------------------
-  rtos::scheduler::critical_section scs;
-
 #if defined(MICRO_OS_PLUS_TRACE_LIBC_MALLOC)
   trace::printf ("::%s(%p)\n", __func__, ptr);
 #endif
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+  rtos::memory::heap_arena* arena = rtos::memory::heap_arena::find (ptr);
+  if (arena != nullptr)
+    {
+      if (arena == rtos::memory::heap_arena::current ())
+        {
+          arena->deallocate (ptr, 0);
+        }
+      else
+        {
+          // Blocks of other threads are queued to the owner.
+          arena->remote_free (ptr);
+        }
+      return;
+    }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+
+  // ----- Begin of critical section ------------------------------------------
+  rtos::scheduler::critical_section scs;
+
   // Size unknown, pass 0.
   estd::pmr::get_default_resource ()->deallocate (ptr, 0);
   // ----- End of critical section --------------------------------------------
 }
 
+/**
+ * @brief Get the usable size of an allocated memory block.
+ * @headerfile malloc.h <malloc.h>
+ * @param ptr Pointer to previously allocated block.
+ * @return The number of bytes usable in the block, or 0 if unknown.
+ *
+ * @details
+ * The `malloc_usable_size()` function returns the number of usable
+ * bytes in the block pointed to by _ptr_, which may be larger than
+ * the size requested when the block was allocated.
+ *
+ * If _ptr_ is a null pointer, 0 is returned.
+ *
+ * @note In µOS++ this function uses a scheduler critical section
+ * and is thread safe. When thread heap arenas are enabled, blocks
+ * belonging to the arena of the current thread are processed
+ * without locking the scheduler.
+ *
+ * @par POSIX compatibility
+ *  Not in POSIX; GNU extension.
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ */
+size_t
+malloc_usable_size (void* ptr)
+{
+  assert (!rtos::interrupts::in_handler_mode ());
+
+  if (ptr == nullptr)
+    {
+      return 0;
+    }
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+  rtos::memory::heap_arena* arena = rtos::memory::heap_arena::find (ptr);
+  if (arena != nullptr)
+    {
+      return arena->usable_size (ptr);
+    }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+
+  // ----- Begin of critical section ------------------------------------------
+  rtos::scheduler::critical_section scs;
+
+  return static_cast<rtos::memory::memory_resource*> (
+             estd::pmr::get_default_resource ())
+      ->usable_size (ptr);
+  // ----- End of critical section --------------------------------------------
+}
+
+/**
+ * @brief Allocate an aligned memory block (non-initialised).
+ * @headerfile malloc.h <malloc.h>
+ * @param alignment Alignment of the block, a power of 2.
+ * @param bytes Number of bytes to allocate.
+ * @return A pointer to the allocated memory or null and `ENOMEM`
+ *  or `EINVAL`.
+ *
+ * @details
+ * The `memalign()` function allocates _bytes_ bytes and returns
+ * a pointer to the allocated memory, whose address is a multiple
+ * of _alignment_.
+ *
+ * The alignment is passed to the memory resource, which
+ * is expected to honour it without allocating extra space.
+ * Alignments smaller than the maximum alignment are increased,
+ * since all blocks must be usable with `realloc()` and `free()`.
+ *
+ * @note In µOS++ this function uses a scheduler critical section
+ * and is thread safe.
+ *
+ * @par POSIX compatibility
+ *  Not in POSIX; obsolete, but still used by older code.
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ */
+void*
+memalign (size_t alignment, size_t bytes)
+{
+  assert (!rtos::interrupts::in_handler_mode ());
+
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+      errno = EINVAL;
+      return nullptr;
+    }
+
+  if (alignment < rtos::memory::memory_resource::max_align)
+    {
+      alignment = rtos::memory::memory_resource::max_align;
+    }
+
+  void* mem;
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+  mem = arena_allocate (bytes, alignment);
+  if (mem != nullptr)
+    {
+      errno = 0;
+#if defined(MICRO_OS_PLUS_TRACE_LIBC_MALLOC)
+      trace::printf ("::%s(%u,%u)=%p\n", __func__, alignment, bytes, mem);
+#endif
+      return mem;
+    }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+
+  {
+    // ----- Begin of critical section --------------------------------------
+    rtos::scheduler::critical_section scs;
+
+    errno = 0;
+    mem = estd::pmr::get_default_resource ()->allocate (bytes, alignment);
+    if (mem == nullptr)
+      {
+        errno = ENOMEM;
+      }
+
+#if defined(MICRO_OS_PLUS_TRACE_LIBC_MALLOC)
+    trace::printf ("::%s(%u,%u)=%p\n", __func__, alignment, bytes, mem);
+#endif
+    // ----- End of critical section ----------------------------------------
+  }
+
+  return mem;
+}
+
+/**
+ * @brief Allocate an aligned memory block (non-initialised).
+ * @headerfile stdlib.h <stdlib.h>
+ * @param alignment Alignment of the block, a power of 2.
+ * @param bytes Number of bytes to allocate.
+ * @return A pointer to the allocated memory or null and `ENOMEM`
+ *  or `EINVAL`.
+ *
+ * @details
+ * The `aligned_alloc()` function shall allocate unused space for
+ * an object whose alignment is specified by _alignment_, whose size
+ * is specified by _bytes_, and whose value is indeterminate.
+ *
+ * Unsupported alignments, i.e. not powers of 2, return a null
+ * pointer and set `errno` to `EINVAL`.
+ *
+ * @note In µOS++ this function uses a scheduler critical section
+ * and is thread safe.
+ *
+ * @par POSIX compatibility
+ *  Not in POSIX 2013; defined by ISO C11.
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ */
+void*
+aligned_alloc (size_t alignment, size_t bytes)
+{
+  return memalign (alignment, bytes);
+}
+
+/**
+ * @brief Allocate an aligned memory block (non-initialised).
+ * @headerfile stdlib.h <stdlib.h>
+ * @param memptr Pointer to a location where to store the
+ *  address of the block.
+ * @param alignment Alignment of the block, a power of 2 multiple
+ *  of `sizeof(void*)`.
+ * @param bytes Number of bytes to allocate.
+ * @retval 0 The block was allocated.
+ * @retval EINVAL The alignment is not valid.
+ * @retval ENOMEM There is insufficient memory available.
+ *
+ * @details
+ * The `posix_memalign()` function shall allocate _bytes_ bytes
+ * aligned on a boundary specified by _alignment_, and shall return
+ * a pointer to the allocated memory in _memptr_.
+ *
+ * Upon successful completion, `posix_memalign()` shall return zero;
+ * otherwise, an error number shall be returned to indicate the error
+ * and the contents of _memptr_ shall either be left unmodified or be
+ * set to a null pointer.
+ *
+ * @note In µOS++ this function uses a scheduler critical section
+ * and is thread safe.
+ *
+ * @par POSIX compatibility
+ *  Inspired by
+ * [`posix_memalign()`](http://pubs.opengroup.org/onlinepubs/9699919799/functions/posix_memalign.html)
+ *  ([IEEE Std 1003.1, 2013
+ * Edition](http://pubs.opengroup.org/onlinepubs/9699919799/nframe.html)).
+ *
+ * @warning Cannot be invoked from Interrupt Service Routines.
+ */
+int
+posix_memalign (void** memptr, size_t alignment, size_t bytes)
+{
+  if (alignment % sizeof (void*) != 0)
+    {
+      return EINVAL;
+    }
+
+  // Preserve errno, as required.
+  int saved_errno = errno;
+
+  int ret = 0;
+  void* mem = memalign (alignment, bytes);
+  if (mem == nullptr)
+    {
+      ret = errno;
+    }
+  else
+    {
+      *memptr = mem;
+    }
+
+  errno = saved_errno;
+  return ret;
+}
+
 /**
  * @}
  */
@@ -417,6 +779,18 @@ _realloc_r (_reent* impure __attribute__ ((unused)), void* ptr, size_t size)
   return realloc (ptr, size);
 }
 
+size_t
+_malloc_usable_size_r (_reent* reent __attribute__ ((unused)), void* ptr)
+{
+  return malloc_usable_size (ptr);
+}
+
+void*
+_memalign_r (_reent* impure __attribute__ ((unused)), size_t align, size_t s)
+{
+  return memalign (align, s);
+}
+
 /**
  * @endcond
  */
@@ -445,13 +819,6 @@ _malloc_stats_r (_reent* impure __attribute__ ((unused)))
   abort ();
 }
 
-size_t
-_malloc_usable_size_r (_reent* reent __attribute__ ((unused)),
-                       void* ptr __attribute__ ((unused)))
-{
-  abort ();
-}
-
 int
 _mallopt_r (_reent* impure __attribute__ ((unused)),
             int parameter_number __attribute__ ((unused)),
@@ -460,14 +827,6 @@ _mallopt_r (_reent* impure __attribute__ ((unused)),
   abort ();
 }
 
-void*
-_memalign_r (_reent* impure __attribute__ ((unused)),
-             size_t align __attribute__ ((unused)),
-             size_t s __attribute__ ((unused)))
-{
-  abort ();
-}
-
 void*
 _pvalloc_r (_reent* impure __attribute__ ((unused)),
             size_t s __attribute__ ((unused)))
@@ -110,6 +110,13 @@ static_assert (alignof (micro_os_plus_statistics_duration_t)
                    == alignof (statistics::duration_t),
                "adjust align of micro_os_plus_statistics_duration_t");
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+static_assert (sizeof (class statistics::occupancy)
+                   == sizeof (micro_os_plus_statistics_occupancy_t),
+               "adjust size of micro_os_plus_statistics_occupancy_t");
+#endif
+
 static_assert (sizeof (micro_os_plus_thread_function_arguments_t)
                    == sizeof (thread::function_arguments_t),
                "adjust size of micro_os_plus_thread_function_arguments_t");
@@ -382,6 +389,11 @@ static_assert (offsetof (rtos::timer::attributes, timer_type)
 
 static_assert (sizeof (rtos::mutex) == sizeof (micro_os_plus_mutex_t),
                "adjust size of micro_os_plus_mutex_t");
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+static_assert (sizeof (class rtos::mutex::statistics)
+                   == sizeof (micro_os_plus_mutex_statistics_t),
+               "adjust size of micro_os_plus_mutex_statistics_t");
+#endif
 static_assert (sizeof (rtos::mutex::attributes)
                    == sizeof (micro_os_plus_mutex_attributes_t),
                "adjust size of micro_os_plus_mutex_attributes_t");
@@ -426,6 +438,11 @@ static_assert (offsetof (rtos::semaphore::attributes, max_value)
 static_assert (sizeof (rtos::memory_pool)
                    == sizeof (micro_os_plus_memory_pool_t),
                "adjust size of micro_os_plus_memory_pool_t");
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+static_assert (sizeof (class rtos::memory_pool::statistics)
+                   == sizeof (micro_os_plus_memory_pool_statistics_t),
+               "adjust size of micro_os_plus_memory_pool_statistics_t");
+#endif
 static_assert (sizeof (rtos::memory_pool::attributes)
                    == sizeof (micro_os_plus_memory_pool_attributes_t),
                "adjust size of micro_os_plus_memory_pool_attributes_t");
@@ -441,6 +458,11 @@ static_assert (offsetof (rtos::memory_pool::attributes, arena_size_bytes)
 static_assert (sizeof (rtos::message_queue)
                    == sizeof (micro_os_plus_message_queue_t),
                "adjust size of micro_os_plus_message_queue_t");
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+static_assert (sizeof (class rtos::message_queue::statistics)
+                   == sizeof (micro_os_plus_message_queue_statistics_t),
+               "adjust size of micro_os_plus_message_queue_statistics_t");
+#endif
 static_assert (sizeof (rtos::message_queue::attributes)
                    == sizeof (micro_os_plus_message_queue_attributes_t),
                "adjust size of micro_os_plus_message_queue_attributes_t");
@@ -468,7 +490,9 @@ static_assert (sizeof (thread::context)
                "adjust size of micro_os_plus_thread_context_t");
 
 #if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES) \
-    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
 static_assert (sizeof (class thread::statistics)
                    == sizeof (micro_os_plus_thread_statistics_t),
                "adjust size of micro_os_plus_thread_statistics_t");
@@ -386,6 +386,11 @@ namespace micro_os_plus
         list.link (node);
         crt_thread.clock_node_ = &node;
         crt_thread.state_ = thread::state::suspended;
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+        crt_thread.statistics_.internal_wait_begin_ (
+            rtos::statistics::wait_reason::sleep, this);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
         // ----- Exit critical section --------------------------------------
       }
 
@@ -399,6 +404,10 @@ namespace micro_os_plus
         // if not already removed by the timer.
         crt_thread.clock_node_ = nullptr;
         node.unlink ();
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+        crt_thread.statistics_.internal_wait_end_ ();
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
         // ----- Exit critical section --------------------------------------
       }
 
@@ -282,6 +282,11 @@ namespace micro_os_plus
 
       // Don't call this from interrupt handlers.
       micro_os_plus_assert_throw (!interrupts::in_handler_mode (), EPERM);
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      object_registry::internal_link_ (
+          *this, object_registry::kind::condition_variable);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
     }
 
     /**
@@ -311,6 +316,10 @@ namespace micro_os_plus
       trace::printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      object_registry::internal_unlink_ (*this);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
       // There must be no threads waiting for this condition.
       assert (list_.empty ());
     }
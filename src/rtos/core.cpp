@@ -100,6 +100,10 @@ namespace micro_os_plus
 
 #pragma GCC diagnostic pop
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+      thread* stack_scan_cursor_;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
 #if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_SCHEDULER)
 
       bool is_preemptive_ = false;
@@ -352,7 +356,10 @@ namespace micro_os_plus
 
       void
       internal_link_node (internal::waiting_threads_list& list,
-                          internal::waiting_thread_node& node)
+                          internal::waiting_thread_node& node,
+                          rtos::statistics::wait_reason reason
+                          __attribute__ ((unused)),
+                          const void* object __attribute__ ((unused)))
       {
         // Remove this thread from the ready list, if there.
         port::this_thread::prepare_suspend ();
@@ -362,6 +369,10 @@ namespace micro_os_plus
         node.thread_->waiting_node_ = &node;
 
         node.thread_->state_ = thread::state::suspended;
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+        node.thread_->statistics_.internal_wait_begin_ (reason, object);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
       }
 
       void
@@ -375,6 +386,10 @@ namespace micro_os_plus
           // if not already removed.
           node.thread_->waiting_node_ = nullptr;
           node.unlink ();
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+          node.thread_->statistics_.internal_wait_end_ ();
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
           // ----- Exit critical section ------------------------------------
         }
       }
@@ -383,7 +398,10 @@ namespace micro_os_plus
       internal_link_node (internal::waiting_threads_list& list,
                           internal::waiting_thread_node& node,
                           internal::clock_timestamps_list& timeout_list,
-                          internal::timeout_thread_node& timeout_node)
+                          internal::timeout_thread_node& timeout_node,
+                          rtos::statistics::wait_reason reason
+                          __attribute__ ((unused)),
+                          const void* object __attribute__ ((unused)))
       {
         // Remove this thread from the ready list, if there.
         port::this_thread::prepare_suspend ();
@@ -397,6 +415,10 @@ namespace micro_os_plus
         // Add this thread to the clock timeout list.
         timeout_list.link (timeout_node);
         timeout_node.thread.clock_node_ = &timeout_node;
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+        node.thread_->statistics_.internal_wait_begin_ (reason, object);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
       }
 
       void
@@ -415,6 +437,10 @@ namespace micro_os_plus
         // if not already removed.
         node.thread_->waiting_node_ = nullptr;
         node.unlink ();
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+        node.thread_->statistics_.internal_wait_end_ ();
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
         // ----- Exit critical section ----------------------------------------
       }
 
@@ -425,11 +451,16 @@ namespace micro_os_plus
       void
       internal_switch_threads (void)
       {
-#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
 
         // Get the high resolution timestamp.
         clock::timestamp_t now = hrclock.now ();
 
+#endif
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+
         // Compute duration since previous context switch.
         // Assume scheduler is not disabled for very long.
         rtos::statistics::duration_t delta
@@ -446,6 +477,10 @@ namespace micro_os_plus
 
 #endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+        thread* old_thread = scheduler::current_thread_;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+
         // The very core of the scheduler, if not locked, re-link the
         // current thread and return the top priority thread.
         if (!locked ())
@@ -474,6 +509,25 @@ namespace micro_os_plus
         scheduler::current_thread_->statistics_.context_switches_++;
 
 #endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+        // Measure the time spent in the ready list after resume().
+        scheduler::current_thread_->statistics_.internal_record_wakeup_ (now);
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+        if (scheduler::current_thread_ != old_thread)
+          {
+            event_trace::record_event (
+                event_trace::event::context_switch,
+                scheduler::current_thread_->priority (),
+                scheduler::current_thread_,
+                static_cast<uint32_t> (
+                    reinterpret_cast<uintptr_t> (old_thread)));
+          }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
       }
 
 #endif // !defined(MICRO_OS_PLUS_USE_RTOS_PORT_SCHEDULER)
@@ -589,6 +643,153 @@ namespace micro_os_plus
 
     } // namespace interrupts
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL) \
+    || defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
+    // ========================================================================
+    namespace statistics
+    {
+      /**
+       * @class occupancy
+       * @details
+       * The owner calls `internal_update_()` after each change of the
+       * count, from the interrupts critical section that changed it.
+       * The clock is read only when the container becomes, or stops
+       * being, full or empty.
+       *
+       * The time spent empty is measured from the first update that
+       * finds the container empty.
+       */
+
+      /**
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      std::size_t
+      occupancy::count_max (void) const
+      {
+        return count_max_;
+      }
+
+      /**
+       * @details
+       * If the container is currently full, the ongoing interval
+       * is included.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      duration_t
+      occupancy::full_cycles (void)
+      {
+        // ----- Enter critical section -----------------------------------
+        interrupts::critical_section ics;
+
+        return full_cycles_
+               + ((full_timestamp_ != 0) ? hrclock.now () - full_timestamp_
+                                         : 0);
+        // ----- Exit critical section ------------------------------------
+      }
+
+      /**
+       * @details
+       * If the container is currently empty, the ongoing interval
+       * is included.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      duration_t
+      occupancy::empty_cycles (void)
+      {
+        // ----- Enter critical section -----------------------------------
+        interrupts::critical_section ics;
+
+        return empty_cycles_
+               + ((empty_timestamp_ != 0) ? hrclock.now () - empty_timestamp_
+                                          : 0);
+        // ----- Exit critical section ------------------------------------
+      }
+
+      /**
+       * @cond ignore
+       */
+
+      /*
+       * Internal function.
+       * Should be called from an interrupts critical section, after
+       * the count was updated.
+       */
+      void
+      occupancy::internal_update_ (std::size_t count, std::size_t capacity)
+      {
+        if (count > count_max_)
+          {
+            count_max_ = count;
+          }
+
+        bool is_full = (count == capacity);
+        bool is_empty = (count == 0);
+
+        // Read the clock only on transitions.
+        if (is_full == (full_timestamp_ != 0)
+            && is_empty == (empty_timestamp_ != 0))
+          {
+            return;
+          }
+
+        duration_t now = hrclock.now ();
+
+        if (full_timestamp_ != 0 && !is_full)
+          {
+            full_cycles_ += now - full_timestamp_;
+            full_timestamp_ = 0;
+          }
+        else if (full_timestamp_ == 0 && is_full)
+          {
+            full_timestamp_ = now;
+          }
+
+        if (empty_timestamp_ != 0 && !is_empty)
+          {
+            empty_cycles_ += now - empty_timestamp_;
+            empty_timestamp_ = 0;
+          }
+        else if (empty_timestamp_ == 0 && is_empty)
+          {
+            empty_timestamp_ = now;
+          }
+      }
+
+      /*
+       * Internal function.
+       * Should be called from an interrupts critical section.
+       * The high-water mark and the durations are zeroed; an ongoing
+       * full or empty interval is restarted from now.
+       */
+      void
+      occupancy::internal_clear_ (void)
+      {
+        duration_t now = hrclock.now ();
+
+        count_max_ = 0;
+        full_cycles_ = 0;
+        empty_cycles_ = 0;
+        if (full_timestamp_ != 0)
+          {
+            full_timestamp_ = now;
+          }
+        if (empty_timestamp_ != 0)
+          {
+            empty_timestamp_ = now;
+          }
+      }
+
+      /**
+       * @endcond
+       */
+
+    } // namespace statistics
+
+#endif
+
     // ========================================================================
     namespace internal
     {
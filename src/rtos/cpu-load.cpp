@@ -0,0 +1,271 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+#include <micro-os-plus/rtos.h>
+
+#include <micro-os-plus/diag/trace.h>
+
+// ----------------------------------------------------------------------------
+
+#if !defined(MICRO_OS_PLUS_INTEGER_RTOS_CPU_LOAD_DECAY_SHIFT)
+#define MICRO_OS_PLUS_INTEGER_RTOS_CPU_LOAD_DECAY_SHIFT (3)
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+#if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_SCHEDULER)
+extern micro_os_plus::rtos::thread* micro_os_plus_idle_thread;
+#endif // !defined(MICRO_OS_PLUS_USE_RTOS_PORT_SCHEDULER)
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace cpu_load
+    {
+      // ======================================================================
+
+      /**
+       * @cond ignore
+       */
+
+      namespace
+      {
+        constexpr uint32_t full_load = 10000;
+
+        constexpr int decay_shift
+            = MICRO_OS_PLUS_INTEGER_RTOS_CPU_LOAD_DECAY_SHIFT;
+
+        // Timestamp of the previous sample, or 0 before the first one.
+        clock::timestamp_t sample_timestamp_;
+        rtos::statistics::duration_t interval_cycles_;
+
+        uint32_t idle_;
+        uint32_t idle_average_;
+
+        uint32_t
+        decay (uint32_t average, uint32_t load)
+        {
+          int32_t diff
+              = static_cast<int32_t> (load) - static_cast<int32_t> (average);
+          return static_cast<uint32_t> (static_cast<int32_t> (average)
+                                        + diff / (1 << decay_shift));
+        }
+
+#if defined(TRACE)
+        void
+        print_threads (thread* parent, int depth)
+        {
+          for (auto& th : scheduler::children_threads (parent))
+            {
+              class thread::statistics& st = th.statistics ();
+              trace::printf ("\t%*s%-16s %3u.%02u%% %3u.%02u%%\n", depth * 2,
+                             "", th.name (),
+                             static_cast<unsigned int> (st.cpu_load () / 100),
+                             static_cast<unsigned int> (st.cpu_load () % 100),
+                             static_cast<unsigned int> (
+                                 st.cpu_load_average () / 100),
+                             static_cast<unsigned int> (
+                                 st.cpu_load_average () % 100));
+
+              print_threads (&th, depth + 1);
+            }
+        }
+#endif // defined(TRACE)
+      } // namespace
+
+      /**
+       * @endcond
+       */
+
+      // ----------------------------------------------------------------------
+
+      /**
+       * @details
+       * The first call only records the current cycles; the loads
+       * are available after the second call.
+       *
+       * The thread tree is walked with the scheduler locked, and
+       * the interrupts are disabled only while the cycles of a
+       * thread are read, so the cost is proportional to the number
+       * of threads, but the interrupt latency is not.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      void
+      sample (void)
+      {
+        // ----- Enter critical section ---------------------------------------
+        scheduler::critical_section scs;
+
+        clock::timestamp_t now = hrclock.now ();
+        interval_cycles_ = (sample_timestamp_ != 0)
+                               ? static_cast<rtos::statistics::duration_t> (
+                                   now - sample_timestamp_)
+                               : 0;
+        sample_timestamp_ = now;
+
+        internal_sample_ (nullptr);
+
+#if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_SCHEDULER)
+        if (interval_cycles_ != 0 && micro_os_plus_idle_thread != nullptr)
+          {
+            class thread::statistics& st
+                = micro_os_plus_idle_thread->statistics ();
+            idle_ = st.cpu_load ();
+            idle_average_ = st.cpu_load_average ();
+          }
+#endif // !defined(MICRO_OS_PLUS_USE_RTOS_PORT_SCHEDULER)
+        // ----- Exit critical section ----------------------------------------
+      }
+
+      /**
+       * @cond ignore
+       */
+
+      // Compute the load of all threads in the tree, for the last
+      // interval. Called with the scheduler locked, so threads
+      // cannot be created or destroyed.
+      void
+      internal_sample_ (thread* parent)
+      {
+        for (auto& th : scheduler::children_threads (parent))
+          {
+            rtos::statistics::duration_t cycles;
+            {
+              // ----- Enter critical section -----------------------------
+              interrupts::critical_section ics;
+
+              // The cycles since the last context switch are not yet
+              // accumulated to the running thread.
+              cycles = th.statistics ().cpu_cycles ();
+              if (&th == scheduler::current_thread_)
+                {
+                  cycles += hrclock.now ()
+                            - scheduler::statistics::switch_timestamp_;
+                }
+              // ----- Exit critical section ------------------------------
+            }
+
+            class thread::statistics& st = th.statistics ();
+            rtos::statistics::duration_t delta
+                = cycles - st.cpu_cycles_sampled_;
+            st.cpu_cycles_sampled_ = cycles;
+
+            if (interval_cycles_ != 0)
+              {
+                uint32_t load
+                    = (delta >= interval_cycles_)
+                          ? full_load
+                          : static_cast<uint32_t> (delta * full_load
+                                                   / interval_cycles_);
+                st.cpu_load_ = load;
+                st.cpu_load_average_ = decay (st.cpu_load_average_, load);
+              }
+
+            internal_sample_ (&th);
+          }
+      }
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      rtos::statistics::duration_t
+      interval_cycles (void)
+      {
+        return interval_cycles_;
+      }
+
+      /**
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      uint32_t
+      idle (void)
+      {
+        return idle_;
+      }
+
+      /**
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      uint32_t
+      idle_average (void)
+      {
+        return idle_average_;
+      }
+
+      /**
+       * @details
+       * For each thread, the name, the load during the last interval
+       * and the average load are printed, indented as in the
+       * thread tree.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      void
+      trace_print (void)
+      {
+#if defined(TRACE)
+        trace::printf ("CPU load over %lu cycles, idle %u.%02u%% "
+                       "(avg %u.%02u%%)\n",
+                       static_cast<unsigned long> (interval_cycles_),
+                       static_cast<unsigned int> (idle_ / 100),
+                       static_cast<unsigned int> (idle_ % 100),
+                       static_cast<unsigned int> (idle_average_ / 100),
+                       static_cast<unsigned int> (idle_average_ % 100));
+
+        // ----- Enter critical section ---------------------------------------
+        scheduler::critical_section scs;
+
+        print_threads (nullptr, 0);
+        // ----- Exit critical section ----------------------------------------
+#endif // defined(TRACE)
+      }
+
+      // ----------------------------------------------------------------------
+
+    } // namespace cpu_load
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_LOAD)
+
+// ----------------------------------------------------------------------------
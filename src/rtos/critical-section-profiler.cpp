@@ -0,0 +1,325 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_CRITICAL_SECTION_PROFILER)
+
+#include <micro-os-plus/rtos.h>
+
+#include <micro-os-plus/diag/trace.h>
+
+// ----------------------------------------------------------------------------
+
+#if !defined(MICRO_OS_PLUS_INTEGER_RTOS_CRITICAL_SECTION_PROFILER_SITES)
+#define MICRO_OS_PLUS_INTEGER_RTOS_CRITICAL_SECTION_PROFILER_SITES (32)
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace critical_section_profiler
+    {
+      // ======================================================================
+
+      /**
+       * @cond ignore
+       */
+
+      namespace
+      {
+        constexpr std::size_t table_size
+            = MICRO_OS_PLUS_INTEGER_RTOS_CRITICAL_SECTION_PROFILER_SITES;
+
+        static_assert ((table_size & (table_size - 1)) == 0,
+                       "The number of sites must be a power of 2.");
+
+        struct profile
+        {
+          // Nesting level; only the outermost section is measured.
+          uint32_t depth;
+          void* entry_site;
+          rtos::statistics::duration_t entry_timestamp;
+          rtos::statistics::duration_t max_cycles;
+          // Hash table with linear probing; empty slots have a null
+          // address.
+          site table[table_size];
+          // Sites which did not fit in the table.
+          site others;
+        };
+
+        profile profiles[2];
+
+        // Set while the profiler itself runs, to ignore the
+        // critical sections possibly entered by the clock.
+        bool busy;
+
+        // Statically allocated, to avoid large stack frames.
+        site print_buffer[table_size + 1];
+
+        site*
+        find (profile& p, void* address)
+        {
+          std::size_t i = (static_cast<std::size_t> (
+                               reinterpret_cast<uintptr_t> (address) >> 1)
+                           * 2654435761u)
+                          & (table_size - 1);
+          for (std::size_t n = 0; n < table_size; ++n)
+            {
+              site& s = p.table[(i + n) & (table_size - 1)];
+              if (s.address == address)
+                {
+                  return &s;
+                }
+              if (s.address == nullptr)
+                {
+                  s.address = address;
+                  return &s;
+                }
+            }
+
+          return &p.others;
+        }
+
+        // Insert the site in the array sorted by descending max_cycles,
+        // dropping the last one if full.
+        std::size_t
+        insert_sorted (site* out, std::size_t used, std::size_t count,
+                       const site& s)
+        {
+          std::size_t i = (used < count) ? used : count;
+          while (i > 0 && out[i - 1].max_cycles < s.max_cycles)
+            {
+              if (i < count)
+                {
+                  out[i] = out[i - 1];
+                }
+              --i;
+            }
+          if (i < count)
+            {
+              out[i] = s;
+            }
+
+          return (used < count) ? used + 1 : count;
+        }
+      } // namespace
+
+      /*
+       * Called after the critical section was entered.
+       */
+      void
+      internal_enter_ (kind type) noexcept
+      {
+        // The constructor is always inlined, so this is the call site.
+        void* address = __builtin_return_address (0);
+
+        interrupts::state_t state
+            = port::interrupts::critical_section::enter ();
+        if (!busy)
+          {
+            busy = true;
+
+            profile& p = profiles[static_cast<std::size_t> (type)];
+            if (p.depth++ == 0)
+              {
+                p.entry_site = address;
+                p.entry_timestamp = hrclock.now ();
+              }
+
+            busy = false;
+          }
+        port::interrupts::critical_section::exit (state);
+      }
+
+      /*
+       * Called before the critical section is exited.
+       */
+      void
+      internal_exit_ (kind type) noexcept
+      {
+        interrupts::state_t state
+            = port::interrupts::critical_section::enter ();
+        if (!busy)
+          {
+            busy = true;
+
+            profile& p = profiles[static_cast<std::size_t> (type)];
+            if (p.depth > 0 && --p.depth == 0)
+              {
+                rtos::statistics::duration_t cycles
+                    = hrclock.now () - p.entry_timestamp;
+
+                site* s = find (p, p.entry_site);
+                ++s->count;
+                s->total_cycles += cycles;
+                if (cycles > s->max_cycles)
+                  {
+                    s->max_cycles = cycles;
+                  }
+                if (cycles > p.max_cycles)
+                  {
+                    p.max_cycles = cycles;
+                  }
+              }
+
+            busy = false;
+          }
+        port::interrupts::critical_section::exit (state);
+      }
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      std::size_t
+      report (kind type, site* out, std::size_t count) noexcept
+      {
+        if (out == nullptr || count == 0)
+          {
+            return 0;
+          }
+
+        const profile& p = profiles[static_cast<std::size_t> (type)];
+
+        std::size_t used = 0;
+
+        // ----- Begin of critical section ------------------------------------
+        interrupts::state_t state
+            = port::interrupts::critical_section::enter ();
+
+        for (std::size_t i = 0; i < table_size; ++i)
+          {
+            if (p.table[i].address != nullptr)
+              {
+                used = insert_sorted (out, used, count, p.table[i]);
+              }
+          }
+        if (p.others.count != 0)
+          {
+            used = insert_sorted (out, used, count, p.others);
+          }
+
+        port::interrupts::critical_section::exit (state);
+        // ----- End of critical section --------------------------------------
+
+        return used;
+      }
+
+      /**
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      rtos::statistics::duration_t
+      max_cycles (kind type) noexcept
+      {
+        return profiles[static_cast<std::size_t> (type)].max_cycles;
+      }
+
+      /**
+       * @details
+       * The sections in progress are still measured when exited.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      void
+      clear (void) noexcept
+      {
+        // ----- Begin of critical section ------------------------------------
+        interrupts::state_t state
+            = port::interrupts::critical_section::enter ();
+
+        for (auto& p : profiles)
+          {
+            p.max_cycles = 0;
+            for (auto& s : p.table)
+              {
+                s = site{};
+              }
+            p.others = site{};
+          }
+
+        port::interrupts::critical_section::exit (state);
+        // ----- End of critical section --------------------------------------
+      }
+
+      /**
+       * @details
+       * For each kind, print the call sites sorted by the longest
+       * hold time, with the number of sections and the average
+       * hold time, in CPU cycles.
+       *
+       * @warning Not reentrant.
+       */
+      void
+      trace_print (void)
+      {
+#if defined(TRACE)
+        static const char* const names[] = { "Interrupts", "Scheduler" };
+
+        for (std::size_t k = 0; k < 2; ++k)
+          {
+            kind type = static_cast<kind> (k);
+            std::size_t n = report (type, print_buffer, table_size + 1);
+
+            trace::printf ("%s critical sections, max %lu cycles\n", names[k],
+                           static_cast<unsigned long> (max_cycles (type)));
+
+            for (std::size_t i = 0; i < n; ++i)
+              {
+                const site& s = print_buffer[i];
+                trace::printf ("\t%p: max %lu, avg %lu cycles, %u times\n",
+                               s.address,
+                               static_cast<unsigned long> (s.max_cycles),
+                               static_cast<unsigned long> (
+                                   s.total_cycles / (s.count ? s.count : 1)),
+                               static_cast<unsigned int> (s.count));
+              }
+          }
+#endif // defined(TRACE)
+      }
+
+      // ----------------------------------------------------------------------
+
+    } // namespace critical_section_profiler
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_CRITICAL_SECTION_PROFILER)
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,305 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_DEFERRED_LOG)
+
+#include <micro-os-plus/rtos.h>
+
+#include <micro-os-plus/diag/trace.h>
+
+#include <atomic>
+#include <cstring>
+
+// ----------------------------------------------------------------------------
+
+#if !defined(MICRO_OS_PLUS_INTEGER_RTOS_DEFERRED_LOG_RECORDS)
+#define MICRO_OS_PLUS_INTEGER_RTOS_DEFERRED_LOG_RECORDS (128)
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace deferred_log
+    {
+      // ======================================================================
+
+      /**
+       * @cond ignore
+       */
+
+      namespace
+      {
+        constexpr std::size_t ring_size
+            = MICRO_OS_PLUS_INTEGER_RTOS_DEFERRED_LOG_RECORDS;
+
+        static_assert ((ring_size & (ring_size - 1)) == 0,
+                       "The number of records must be a power of 2.");
+
+        record ring[ring_size];
+
+        // The index + 1 of the record stored in each slot, written
+        // after the record content; 0 for empty slots.
+        std::atomic<uint32_t> committed[ring_size];
+
+        // Index of the next record to write.
+        std::atomic<uint32_t> head{ 0 };
+
+        // Index of the next record to format; single consumer.
+        uint32_t tail;
+
+        std::atomic<bool> flushing{ false };
+        std::atomic<bool> idle_flushing{ true };
+
+        uint32_t dropped_records;
+
+        // Copy the record with the given index, if still there.
+        // Return 1 if copied, 0 if not yet committed, -1 if overwritten.
+        int
+        read (uint32_t index, record& r)
+        {
+          std::atomic<uint32_t>& c = committed[index & (ring_size - 1)];
+
+          uint32_t before = c.load (std::memory_order_acquire);
+          if (before != index + 1)
+            {
+              return (static_cast<int32_t> (before - (index + 1)) > 0) ? -1
+                                                                       : 0;
+            }
+
+          r = ring[index & (ring_size - 1)];
+
+          std::atomic_thread_fence (std::memory_order_acquire);
+          if (c.load (std::memory_order_relaxed) != before)
+            {
+              // Overwritten while copying.
+              return -1;
+            }
+
+          return 1;
+        }
+      } // namespace
+
+      void
+      internal_write_ (const char* format, const word_t* args,
+                       std::size_t count) noexcept
+      {
+        uint32_t index = head.fetch_add (1, std::memory_order_relaxed);
+        std::size_t slot = index & (ring_size - 1);
+
+        // Invalidate the slot while it is rewritten.
+        committed[slot].store (0, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+
+        record& r = ring[slot];
+        r.index = index;
+        r.timestamp = static_cast<uint32_t> (hrclock.now ());
+        r.format = reinterpret_cast<word_t> (format);
+        std::size_t i = 0;
+        for (; i < count; ++i)
+          {
+            r.args[i] = args[i];
+          }
+        for (; i < max_args; ++i)
+          {
+            r.args[i] = 0;
+          }
+
+        committed[slot].store (index + 1, std::memory_order_release);
+      }
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @details
+       * Records are formatted in order, with all `max_args` words
+       * passed to `trace::printf()`; extra arguments are ignored.
+       * Records overwritten before being formatted are counted
+       * as dropped.
+       *
+       * If another flush is in progress, return immediately.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      std::size_t
+      flush (void) noexcept
+      {
+        if (flushing.exchange (true, std::memory_order_acquire))
+          {
+            return 0;
+          }
+
+        std::size_t count = 0;
+        while (tail != head.load (std::memory_order_relaxed))
+          {
+            uint32_t end = head.load (std::memory_order_relaxed);
+            constexpr uint32_t size = static_cast<uint32_t> (ring_size);
+            if (end - tail > size)
+              {
+                dropped_records += end - tail - size;
+                tail = end - size;
+              }
+
+            record r;
+            int res = read (tail, r);
+            if (res == 0)
+              {
+                // Reserved, but not yet written.
+                break;
+              }
+
+            if (res > 0)
+              {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+                trace::printf (reinterpret_cast<const char*> (r.format),
+                               r.args[0], r.args[1], r.args[2], r.args[3]);
+#pragma GCC diagnostic pop
+                ++count;
+              }
+            else
+              {
+                ++dropped_records;
+              }
+            ++tail;
+          }
+
+        flushing.store (false, std::memory_order_release);
+        return count;
+      }
+
+      bool
+      idle_flush (bool state) noexcept
+      {
+        return idle_flushing.exchange (state);
+      }
+
+      bool
+      idle_flush (void) noexcept
+      {
+        return idle_flushing.load (std::memory_order_relaxed);
+      }
+
+      uint32_t
+      dropped (void) noexcept
+      {
+        return dropped_records;
+      }
+
+      /**
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      void
+      reset (void) noexcept
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        for (std::size_t i = 0; i < ring_size; ++i)
+          {
+            committed[i].store (0, std::memory_order_relaxed);
+          }
+        head.store (0, std::memory_order_relaxed);
+        tail = 0;
+        dropped_records = 0;
+        // ----- Exit critical section --------------------------------------
+      }
+
+      /**
+       * @details
+       * Write the records still in the ring buffer, formatted or not,
+       * oldest first. The records are not consumed.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      std::size_t
+      dump (void* buffer, std::size_t bytes) noexcept
+      {
+        char* out = static_cast<char*> (buffer);
+        if (out == nullptr || bytes < sizeof (dump_header))
+          {
+            return 0;
+          }
+
+        std::size_t offset = sizeof (dump_header);
+
+        uint32_t end = head.load (std::memory_order_acquire);
+        uint32_t count = (end > ring_size) ? ring_size : end;
+
+        uint32_t records = 0;
+        for (uint32_t i = end - count; i != end; ++i)
+          {
+            if (offset + sizeof (record) > bytes)
+              {
+                break;
+              }
+
+            record r;
+            if (read (i, r) > 0)
+              {
+                std::memcpy (out + offset, &r, sizeof (r));
+                offset += sizeof (r);
+                ++records;
+              }
+          }
+
+        dump_header header{};
+        header.magic = dump_magic;
+        header.version = dump_version;
+        header.record_size = sizeof (record);
+        header.records = records;
+        header.clock_frequency_hz = hrclock.input_clock_frequency_hz ();
+        header.dropped = dropped_records;
+        header.word_size = sizeof (word_t);
+
+        std::memcpy (out, &header, sizeof (header));
+
+        return offset;
+      }
+
+      // ----------------------------------------------------------------------
+
+    } // namespace deferred_log
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_DEFERRED_LOG)
+
+// ----------------------------------------------------------------------------
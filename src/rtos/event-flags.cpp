@@ -180,6 +180,11 @@ namespace micro_os_plus
 #else
 
 #endif
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      object_registry::internal_link_ (*this,
+                                       object_registry::kind::event_flags);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
     }
 
 #pragma GCC diagnostic pop
@@ -203,6 +208,10 @@ namespace micro_os_plus
       trace::printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      object_registry::internal_unlink_ (*this);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
 #if defined(MICRO_OS_PLUS_USE_RTOS_PORT_EVENT_FLAGS)
 
       port::event_flags::destroy (this);
@@ -294,7 +303,8 @@ namespace micro_os_plus
               }
 
             // Add this thread to the event flags waiting list.
-            scheduler::internal_link_node (list_, node);
+            scheduler::internal_link_node (
+                list_, node, rtos::statistics::wait_reason::flags, this);
             // state::suspended set in above link().
             // ----- Exit critical section ----------------------------------
           }
@@ -489,8 +499,9 @@ namespace micro_os_plus
 
             // Add this thread to the event flags waiting list,
             // and the clock timeout list.
-            scheduler::internal_link_node (list_, node, clock_list,
-                                           timeout_node);
+            scheduler::internal_link_node (
+                list_, node, clock_list, timeout_node,
+                rtos::statistics::wait_reason::flags, this);
             // state::suspended set in above link().
             // ----- Exit critical section ----------------------------------
           }
@@ -0,0 +1,359 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+
+#include <micro-os-plus/rtos.h>
+
+#include <atomic>
+#include <cstring>
+
+// ----------------------------------------------------------------------------
+
+#if !defined(MICRO_OS_PLUS_INTEGER_RTOS_EVENT_TRACE_RECORDS)
+#define MICRO_OS_PLUS_INTEGER_RTOS_EVENT_TRACE_RECORDS (256)
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace event_trace
+    {
+      // ======================================================================
+
+      /**
+       * @cond ignore
+       */
+
+      namespace
+      {
+        constexpr std::size_t ring_size
+            = MICRO_OS_PLUS_INTEGER_RTOS_EVENT_TRACE_RECORDS;
+
+        static_assert ((ring_size & (ring_size - 1)) == 0,
+                       "The number of records must be a power of 2.");
+
+        record ring[ring_size];
+
+        // The index + 1 of the record stored in each slot, written
+        // after the record content; 0 for empty slots.
+        std::atomic<uint32_t> committed[ring_size];
+
+        // Index of the next record; increments forever, wraps
+        // at 2^32, which is a multiple of the ring size.
+        std::atomic<uint32_t> head{ 0 };
+
+        std::atomic<bool> recording{ true };
+
+        inline uint32_t
+        address (const void* object)
+        {
+          return static_cast<uint32_t> (reinterpret_cast<uintptr_t> (object));
+        }
+
+        // Copy the record with the given index, if still there.
+        // Return 1 if copied, 0 if not yet committed, -1 if overwritten.
+        int
+        read (uint32_t index, record& r)
+        {
+          std::atomic<uint32_t>& c = committed[index & (ring_size - 1)];
+
+          uint32_t before = c.load (std::memory_order_acquire);
+          if (before != index + 1)
+            {
+              return (static_cast<int32_t> (before - (index + 1)) > 0) ? -1
+                                                                       : 0;
+            }
+
+          r = ring[index & (ring_size - 1)];
+
+          std::atomic_thread_fence (std::memory_order_acquire);
+          if (c.load (std::memory_order_relaxed) != before)
+            {
+              // Overwritten while copying.
+              return -1;
+            }
+
+          return 1;
+        }
+
+        // Store the name as consecutive 4 characters chunks,
+        // the last one padded with zeros.
+        template <typename F>
+        void
+        for_each_name_chunk (const char* name, F&& func)
+        {
+          if (name == nullptr)
+            {
+              return;
+            }
+
+          std::size_t len = std::strlen (name);
+          for (std::size_t i = 0; i <= len / 4 && i < 256; ++i)
+            {
+              char chunk[4] = {};
+              std::size_t n = (len - i * 4 > 4) ? 4 : len - i * 4;
+              std::memcpy (chunk, name + i * 4, n);
+
+              uint32_t value;
+              std::memcpy (&value, chunk, sizeof (value));
+
+              func (static_cast<uint8_t> (i), value);
+            }
+        }
+
+        std::size_t
+        dump_names (thread* parent, char* out, std::size_t bytes,
+                    std::size_t& count)
+        {
+          std::size_t offset = 0;
+          for (auto& th : scheduler::children_threads (parent))
+            {
+              for_each_name_chunk (th.name (), [&] (uint8_t i, uint32_t v) {
+                if (offset + sizeof (record) > bytes)
+                  {
+                    return;
+                  }
+
+                record r{};
+                r.type = event::thread_name;
+                r.arg = i;
+                r.object = address (&th);
+                r.value = v;
+
+                std::memcpy (out + offset, &r, sizeof (r));
+                offset += sizeof (r);
+                ++count;
+              });
+
+              offset
+                  += dump_names (&th, out + offset, bytes - offset, count);
+            }
+
+          return offset;
+        }
+      } // namespace
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @details
+       * Reserve the next slot with an atomic increment, fill it and
+       * commit it; readers skip slots not yet committed.
+       * If the writer is preempted between the steps, the
+       * timestamps of adjacent records may be slightly out of order;
+       * the decoder accounts for this.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      void
+      record_event (event type, uint8_t arg, const void* object,
+                    uint32_t value) noexcept
+      {
+        if (!recording.load (std::memory_order_relaxed))
+          {
+            return;
+          }
+
+        uint32_t index = head.fetch_add (1, std::memory_order_relaxed);
+        std::size_t slot = index & (ring_size - 1);
+
+        // Invalidate the slot while it is rewritten.
+        committed[slot].store (0, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+
+        record& r = ring[slot];
+        r.timestamp = static_cast<uint32_t> (hrclock.now ());
+        r.type = type;
+        r.arg = arg;
+        r.sequence = static_cast<uint16_t> (index);
+        r.object = address (object);
+        r.value = value;
+
+        committed[slot].store (index + 1, std::memory_order_release);
+      }
+
+      /**
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      void
+      record_name (const void* object, const char* name) noexcept
+      {
+        for_each_name_chunk (name, [object] (uint8_t i, uint32_t v) {
+          record_event (event::thread_name, i, object, v);
+        });
+      }
+
+      /**
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      void
+      isr_enter (uint8_t irq) noexcept
+      {
+        record_event (event::isr_enter, irq, nullptr, 0);
+      }
+
+      /**
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      void
+      isr_exit (uint8_t irq) noexcept
+      {
+        record_event (event::isr_exit, irq, nullptr, 0);
+      }
+
+      /**
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      bool
+      enabled (bool state) noexcept
+      {
+        return recording.exchange (state);
+      }
+
+      /**
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      bool
+      enabled (void) noexcept
+      {
+        return recording.load (std::memory_order_relaxed);
+      }
+
+      /**
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      void
+      reset (void) noexcept
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        for (std::size_t i = 0; i < ring_size; ++i)
+          {
+            committed[i].store (0, std::memory_order_relaxed);
+          }
+        head.store (0, std::memory_order_relaxed);
+        // ----- Exit critical section --------------------------------------
+      }
+
+      std::size_t
+      capacity (void) noexcept
+      {
+        return ring_size;
+      }
+
+      uint32_t
+      written (void) noexcept
+      {
+        return head.load (std::memory_order_relaxed);
+      }
+
+      /**
+       * @details
+       * Records are copied oldest first; records still being
+       * written or overwritten while copied are skipped. If the
+       * buffer is too small, the newest records and names are left out.
+       *
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      std::size_t
+      dump (void* buffer, std::size_t bytes) noexcept
+      {
+        char* out = static_cast<char*> (buffer);
+        if (out == nullptr || bytes < sizeof (dump_header))
+          {
+            return 0;
+          }
+
+        std::size_t offset = sizeof (dump_header);
+
+        uint32_t end = head.load (std::memory_order_acquire);
+        uint32_t count = (end > ring_size) ? ring_size : end;
+
+        std::size_t records = 0;
+        for (uint32_t i = end - count; i != end; ++i)
+          {
+            if (offset + sizeof (record) > bytes)
+              {
+                break;
+              }
+
+            record r;
+            if (read (i, r) > 0)
+              {
+                std::memcpy (out + offset, &r, sizeof (r));
+                offset += sizeof (r);
+                ++records;
+              }
+          }
+
+        {
+          // ----- Enter critical section -----------------------------------
+          scheduler::critical_section scs;
+
+          // Threads which are still alive may have been named in
+          // records already overwritten.
+          offset += dump_names (nullptr, out + offset, bytes - offset,
+                                records);
+          // ----- Exit critical section ------------------------------------
+        }
+
+        dump_header header{};
+        header.magic = dump_magic;
+        header.version = dump_version;
+        header.record_size = sizeof (record);
+        header.records = static_cast<uint32_t> (records);
+        header.clock_frequency_hz = hrclock.input_clock_frequency_hz ();
+
+        std::memcpy (out, &header, sizeof (header));
+
+        return offset;
+      }
+
+      // ----------------------------------------------------------------------
+
+    } // namespace event_trace
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+
+// ----------------------------------------------------------------------------
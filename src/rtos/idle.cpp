@@ -46,6 +46,14 @@ micro_os_plus_idle (thread::function_arguments_t arguments);
 void
 micro_os_plus_rtos_idle_actions (void);
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
+#if !defined(MICRO_OS_PLUS_INTEGER_RTOS_THREAD_STACK_SCAN_ELEMENTS)
+#define MICRO_OS_PLUS_INTEGER_RTOS_THREAD_STACK_SCAN_ELEMENTS (64)
+#endif
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
 /**
  * @details
  * The hook must check an application specific condition to determine
@@ -88,6 +96,38 @@ void __attribute__ ((weak)) micro_os_plus_rtos_idle_actions (void)
       this_thread::yield ();
     }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+  {
+    // ----- Enter critical section -----------------------------------------
+    scheduler::critical_section scs;
+
+    // Advance the scan of a single thread per iteration; threads
+    // terminating move the cursor past them, so it is always valid
+    // while the scheduler is locked.
+    thread* th = scheduler::stack_scan_cursor_;
+    if (th == nullptr && !scheduler::top_threads_list_.empty ())
+      {
+        // Restart from the first top level thread.
+        th = &(*scheduler::top_threads_list_.begin ());
+      }
+    if (th != nullptr)
+      {
+        th->stack ().scan (
+            MICRO_OS_PLUS_INTEGER_RTOS_THREAD_STACK_SCAN_ELEMENTS);
+        scheduler::stack_scan_cursor_ = th->internal_next_in_tree_ (true);
+      }
+    // ----- Exit critical section ------------------------------------------
+  }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_DEFERRED_LOG)
+  if (deferred_log::idle_flush ())
+    {
+      // Format the log records stored by the other threads.
+      deferred_log::flush ();
+    }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_DEFERRED_LOG)
+
 #if defined(MICRO_OS_PLUS_HAS_INTERRUPTS_STACK)
   // Simple test to verify that the interrupts
   // did not underflow the stack.
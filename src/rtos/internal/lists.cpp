@@ -43,6 +43,30 @@ namespace micro_os_plus
   {
     namespace internal
     {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_LISTS)
+
+      /**
+       * @cond ignore
+       */
+
+      namespace
+      {
+        // The lists are updated inside critical sections; when
+        // available, only store the trace records, and format
+        // them later.
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_DEFERRED_LOG)
+        namespace lists_trace = rtos::deferred_log;
+#else
+        namespace lists_trace = micro_os_plus::trace;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_DEFERRED_LOG)
+      } // namespace
+
+      /**
+       * @endcond
+       */
+
+#endif // defined(MICRO_OS_PLUS_TRACE_RTOS_LISTS)
+
       // ======================================================================
 
       void
@@ -73,15 +97,16 @@ namespace micro_os_plus
           {
             // Insert at the end of the list.
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_LISTS)
-            trace::printf ("ready %s() empty +%u\n", __func__, prio);
+            lists_trace::printf ("ready %s() empty +%u\n", __func__,
+                                 prio);
 #endif
           }
         else if (prio <= after->thread_->priority ())
           {
             // Insert at the end of the list.
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_LISTS)
-            trace::printf ("ready %s() back %u +%u \n", __func__,
-                           after->thread_->priority (), prio);
+            lists_trace::printf ("ready %s() back %u +%u \n", __func__,
+                                 after->thread_->priority (), prio);
 #endif
           }
         else if (prio > head ()->thread_->priority ())
@@ -89,8 +114,8 @@ namespace micro_os_plus
             // Insert at the beginning of the list.
             after = static_cast<waiting_thread_node*> (&head_);
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_LISTS)
-            trace::printf ("ready %s() front +%u %u \n", __func__, prio,
-                           head ()->thread_->priority ());
+            lists_trace::printf ("ready %s() front +%u %u \n", __func__,
+                                 prio, head ()->thread_->priority ());
 #endif
           }
         else
@@ -103,8 +128,8 @@ namespace micro_os_plus
                 after = static_cast<waiting_thread_node*> (after->previous ());
               }
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_LISTS)
-            trace::printf ("ready %s() middle %u +%u \n", __func__,
-                           after->thread_->priority (), prio);
+            lists_trace::printf ("ready %s() middle %u +%u \n", __func__,
+                                 after->thread_->priority (), prio);
 #endif
           }
 
@@ -125,7 +150,8 @@ namespace micro_os_plus
         thread* th = head ()->thread_;
 
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_LISTS)
-        trace::printf ("ready %s() %p %s\n", __func__, th, th->name ());
+        lists_trace::printf ("ready %s() %p %s\n", __func__, th,
+                             th->name ());
 #endif
 
         const_cast<waiting_thread_node*> (head ())->unlink ();
@@ -196,15 +222,15 @@ namespace micro_os_plus
           {
             // Insert at the end of the list.
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_LISTS)
-            trace::printf ("wait %s() empty +%u\n", __func__, prio);
+            lists_trace::printf ("wait %s() empty +%u\n", __func__, prio);
 #endif
           }
         else if (prio <= after->thread_->priority ())
           {
             // Insert at the end of the list.
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_LISTS)
-            trace::printf ("wait %s() back %u +%u \n", __func__,
-                           after->thread_->priority (), prio);
+            lists_trace::printf ("wait %s() back %u +%u \n", __func__,
+                                 after->thread_->priority (), prio);
 #endif
           }
         else if (prio > head ()->thread_->priority ())
@@ -212,8 +238,8 @@ namespace micro_os_plus
             // Insert at the beginning of the list.
             after = static_cast<waiting_thread_node*> (&head_);
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_LISTS)
-            trace::printf ("wait %s() front +%u %u \n", __func__, prio,
-                           head ()->thread_->priority ());
+            lists_trace::printf ("wait %s() front +%u %u \n", __func__,
+                                 prio, head ()->thread_->priority ());
 #endif
           }
         else
@@ -226,8 +252,8 @@ namespace micro_os_plus
                 after = static_cast<waiting_thread_node*> (after->previous ());
               }
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_LISTS)
-            trace::printf ("wait %s() middle %u +%u \n", __func__,
-                           after->thread_->priority (), prio);
+            lists_trace::printf ("wait %s() middle %u +%u \n", __func__,
+                                 after->thread_->priority (), prio);
 #endif
           }
 
@@ -269,7 +295,7 @@ namespace micro_os_plus
         else
           {
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_LISTS)
-            trace::printf ("%s() gone \n", __func__);
+            lists_trace::printf ("%s() gone \n", __func__);
 #endif
           }
 
@@ -0,0 +1,393 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+
+#include <micro-os-plus/rtos/memory-heap-arena.h>
+
+// ----------------------------------------------------------------------------
+
+#if !defined(MICRO_OS_PLUS_INTEGER_RTOS_THREAD_HEAP_ARENAS)
+#define MICRO_OS_PLUS_INTEGER_RTOS_THREAD_HEAP_ARENAS (8)
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace memory
+    {
+      // ======================================================================
+
+      /**
+       * @cond ignore
+       */
+
+      namespace
+      {
+        constexpr std::size_t arenas_size
+            = MICRO_OS_PLUS_INTEGER_RTOS_THREAD_HEAP_ARENAS;
+
+        // All arenas, indexed by the tag stored in front of
+        // their blocks, to find the owner of a block freed by
+        // another thread.
+        heap_arena* arenas[arenas_size];
+
+        // Identifies the tags of the arena blocks; the arena index
+        // is added to it.
+        constexpr uintptr_t tag_magic = 0x41524E00;
+
+        // The tag and the header size are stored just below
+        // the payload, which remains aligned.
+        constexpr std::size_t
+        header_size (std::size_t alignment)
+        {
+          return align_size (2 * sizeof (uintptr_t),
+                             max (alignment, memory_resource::max_align));
+        }
+      } // namespace
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @class heap_arena
+       * @details
+       * A TLSF allocator reserved to a single thread, which
+       * can allocate and free its own blocks without
+       * locking the scheduler.
+       *
+       * Each block is preceded by a small header with a tag
+       * identifying the arena, so the owner of any block is found
+       * in constant time, without locking, when the block is
+       * freed.
+       *
+       * When `MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA` is defined,
+       * `malloc()` first tries the arena of the current thread, and
+       * only if it has none, or if it is full, it falls back to the
+       * shared application memory resource, under a scheduler
+       * critical section.
+       *
+       * Blocks freed by other threads are not returned to the free
+       * lists directly, but are queued in a short interrupts
+       * critical section; the owner thread frees them
+       * when it next uses the arena, or when calling `drain()`.
+       *
+       * @note The arena must outlive all blocks allocated from it;
+       * blocks freed remotely remain allocated until the owner
+       * thread drains the queue.
+       * The maximum number of arenas is configured with
+       * `MICRO_OS_PLUS_INTEGER_RTOS_THREAD_HEAP_ARENAS` (default 8).
+       */
+
+      /**
+       * @details
+       * The arena is assigned to the owner thread, and is registered
+       * in the table of all arenas.
+       */
+      heap_arena::heap_arena (const char* name, void* addr,
+                              std::size_t bytes, rtos::thread& owner)
+          : tlsf{ name, addr, bytes }, //
+            owner_{ &owner }
+      {
+        trace::printf ("%s(%p,%u,%p) @%p %s\n", __func__, addr, bytes, &owner,
+                       this, this->name ());
+
+        // ----- Begin of critical section ------------------------------------
+        scheduler::critical_section scs;
+
+        assert (owner.heap_arena_ == nullptr);
+
+        for (index_ = 0; index_ < arenas_size; ++index_)
+          {
+            if (arenas[index_] == nullptr)
+              {
+                break;
+              }
+          }
+        micro_os_plus_assert_throw (index_ < arenas_size, ENOMEM);
+
+        arenas[index_] = this;
+        owner.heap_arena_ = this;
+        // ----- End of critical section --------------------------------------
+      }
+
+      /**
+       * @details
+       * The arena is removed from the owner thread and from the
+       * table of all arenas.
+       */
+      heap_arena::~heap_arena ()
+      {
+        trace::printf ("%s() @%p %s\n", __func__, this, name ());
+
+        // ----- Begin of critical section ------------------------------------
+        scheduler::critical_section scs;
+
+        if (owner_->heap_arena_ == this)
+          {
+            owner_->heap_arena_ = nullptr;
+          }
+
+        arenas[index_] = nullptr;
+        // ----- End of critical section --------------------------------------
+      }
+
+      /**
+       * @details
+       * Return `nullptr` when invoked from Interrupt Service Routines
+       * or before the scheduler is started, since there is
+       * no current thread.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      heap_arena*
+      heap_arena::current (void) noexcept
+      {
+        if (interrupts::in_handler_mode () || !scheduler::started ())
+          {
+            return nullptr;
+          }
+
+        return this_thread::thread ().heap_arena_;
+      }
+
+      /**
+       * @details
+       * The tag in front of the block selects the arena; since
+       * any block may be passed, the tag is only a hint, and the
+       * block must also be inside the arena. The cost does not
+       * depend on the number of arenas and the scheduler is
+       * not locked.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      heap_arena*
+      heap_arena::find (void* addr) noexcept
+      {
+        std::size_t index = static_cast<std::size_t> (
+            static_cast<uintptr_t*> (addr)[-1] - tag_magic);
+        if (index >= arenas_size)
+          {
+            return nullptr;
+          }
+
+        heap_arena* arena = arenas[index];
+        if (arena == nullptr || !arena->owns (addr))
+          {
+            return nullptr;
+          }
+
+        return arena;
+      }
+
+      /**
+       * @details
+       * The block is linked in the queue of the arena,
+       * to be freed later by the owner thread.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      void
+      heap_arena::remote_free (void* addr) noexcept
+      {
+        assert (owns (addr));
+
+        // ----- Begin of critical section ------------------------------------
+        interrupts::critical_section ics;
+
+        *static_cast<void**> (addr) = remote_list_;
+        remote_list_ = addr;
+        ++remote_count_;
+        // ----- End of critical section --------------------------------------
+      }
+
+      /**
+       * @details
+       * The queue is detached in a short interrupts critical section,
+       * then the blocks are freed without locking.
+       *
+       * @warning Must be invoked only from the owner thread.
+       */
+      std::size_t
+      heap_arena::drain (void) noexcept
+      {
+        void* list;
+        {
+          // ----- Begin of critical section ----------------------------------
+          interrupts::critical_section ics;
+
+          list = remote_list_;
+          if (list == nullptr)
+            {
+              return 0;
+            }
+          remote_list_ = nullptr;
+          remote_count_ = 0;
+          // ----- End of critical section ------------------------------------
+        }
+
+        std::size_t count = 0;
+        while (list != nullptr)
+          {
+            void* next = *static_cast<void**> (list);
+
+            ++deallocations_;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+            internal_record_deallocation (list, 0);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
+            heap_profiler::record_deallocation (list);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
+            tlsf::do_deallocate (
+                static_cast<char*> (list)
+                    - static_cast<std::size_t*> (list)[-2],
+                0, memory_resource::max_align);
+
+            list = next;
+            ++count;
+          }
+
+        return count;
+      }
+
+      /**
+       * @details
+       * The blocks freed by other threads are reclaimed first.
+       */
+      void*
+      heap_arena::do_allocate (std::size_t bytes, std::size_t alignment)
+      {
+        drain ();
+
+        alignment = max (alignment, memory_resource::max_align);
+        std::size_t header_bytes = header_size (alignment);
+
+        char* mem = static_cast<char*> (
+            tlsf::do_allocate (bytes + header_bytes, alignment));
+        if (mem == nullptr)
+          {
+            return nullptr;
+          }
+
+        uintptr_t* block = reinterpret_cast<uintptr_t*> (mem + header_bytes);
+        block[-1] = tag_magic + index_;
+        block[-2] = header_bytes;
+
+        return block;
+      }
+
+      void
+      heap_arena::do_deallocate (void* addr, std::size_t bytes,
+                                 std::size_t alignment) noexcept
+      {
+        drain ();
+
+        std::size_t header_bytes = static_cast<uintptr_t*> (addr)[-2];
+
+        // Clear the tag, for the case the address is freed again.
+        static_cast<uintptr_t*> (addr)[-1] = 0;
+
+        tlsf::do_deallocate (static_cast<char*> (addr) - header_bytes,
+                             (bytes != 0) ? bytes + header_bytes : 0,
+                             max (alignment, memory_resource::max_align));
+      }
+
+      std::size_t
+      heap_arena::do_max_size (void) const noexcept
+      {
+        std::size_t bytes = tlsf::do_max_size ();
+        std::size_t header_bytes = header_size (memory_resource::max_align);
+
+        return (bytes > header_bytes) ? bytes - header_bytes : 0;
+      }
+
+      /**
+       * @details
+       * The queued blocks are discarded together with
+       * all other blocks.
+       */
+      void
+      heap_arena::do_reset (void) noexcept
+      {
+        {
+          // ----- Begin of critical section ----------------------------------
+          interrupts::critical_section ics;
+
+          remote_list_ = nullptr;
+          remote_count_ = 0;
+          // ----- End of critical section ------------------------------------
+        }
+
+        tlsf::do_reset ();
+      }
+
+      /**
+       * @details
+       * The blocks freed by other threads are reclaimed first,
+       * to increase the chances to grow in place.
+       */
+      bool
+      heap_arena::do_resize (void* addr, std::size_t bytes) noexcept
+      {
+        drain ();
+
+        std::size_t header_bytes = static_cast<uintptr_t*> (addr)[-2];
+
+        return tlsf::do_resize (static_cast<char*> (addr) - header_bytes,
+                                bytes + header_bytes);
+      }
+
+      std::size_t
+      heap_arena::do_usable_size (void* addr) noexcept
+      {
+        std::size_t header_bytes = static_cast<uintptr_t*> (addr)[-2];
+
+        return tlsf::do_usable_size (static_cast<char*> (addr) - header_bytes)
+               - header_bytes;
+      }
+
+      // ----------------------------------------------------------------------
+
+    } // namespace memory
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_HEAP_ARENA)
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,390 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
+
+#include <micro-os-plus/rtos.h>
+
+// ----------------------------------------------------------------------------
+
+#if !defined(MICRO_OS_PLUS_INTEGER_RTOS_HEAP_PROFILER_SAMPLES)
+#define MICRO_OS_PLUS_INTEGER_RTOS_HEAP_PROFILER_SAMPLES (64)
+#endif
+
+#if !defined(MICRO_OS_PLUS_INTEGER_RTOS_HEAP_PROFILER_INTERVAL_BYTES)
+#define MICRO_OS_PLUS_INTEGER_RTOS_HEAP_PROFILER_INTERVAL_BYTES (4096)
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace memory
+    {
+      namespace heap_profiler
+      {
+        // ====================================================================
+
+        /**
+         * @cond ignore
+         */
+
+        namespace
+        {
+          constexpr std::size_t table_size
+              = MICRO_OS_PLUS_INTEGER_RTOS_HEAP_PROFILER_SAMPLES;
+
+          static_assert ((table_size & (table_size - 1)) == 0,
+                         "The number of samples must be a power of 2.");
+
+          // Keep the open addressing table at most 3/4 full.
+          constexpr std::size_t max_samples = table_size - table_size / 4;
+
+          // Hash table of the live samples, with linear probing;
+          // empty slots have a null address.
+          sample table[table_size];
+
+          // Statically allocated, to avoid large stack frames.
+          sample print_buffer[table_size];
+
+          std::size_t interval_bytes
+              = MICRO_OS_PLUS_INTEGER_RTOS_HEAP_PROFILER_INTERVAL_BYTES;
+          std::size_t countdown_bytes
+              = MICRO_OS_PLUS_INTEGER_RTOS_HEAP_PROFILER_INTERVAL_BYTES;
+
+          std::size_t volatile live_samples;
+          std::size_t dropped_samples;
+
+          uint32_t random_state = 2463534242u;
+
+          inline std::size_t
+          slot (void* addr)
+          {
+            // Blocks are at least 8 bytes aligned; mix the rest.
+            uint32_t a = static_cast<uint32_t> (
+                reinterpret_cast<uintptr_t> (addr) >> 3);
+            return static_cast<std::size_t> (a * 2654435761u)
+                   & (table_size - 1);
+          }
+
+          // The distance to the next sample is randomised around
+          // the mean interval, to avoid aliasing with periodic
+          // allocation patterns.
+          std::size_t
+          next_countdown (void)
+          {
+            // xorshift32.
+            random_state ^= random_state << 13;
+            random_state ^= random_state >> 17;
+            random_state ^= random_state << 5;
+
+            return interval_bytes / 2 + random_state % interval_bytes;
+          }
+
+          std::size_t
+          find (void* addr)
+          {
+            std::size_t i = slot (addr);
+            while (table[i].address != nullptr)
+              {
+                if (table[i].address == addr)
+                  {
+                    return i;
+                  }
+                i = (i + 1) & (table_size - 1);
+              }
+            return table_size;
+          }
+        } // namespace
+
+        /**
+         * @endcond
+         */
+
+        // --------------------------------------------------------------------
+
+        /**
+         * @details
+         * The table is not cleared; already sampled blocks are
+         * kept until freed.
+         *
+         * @note Can be invoked from Interrupt Service Routines.
+         */
+        std::size_t
+        sampling_interval (std::size_t bytes) noexcept
+        {
+          // ----- Begin of critical section ---------------------------------
+          interrupts::critical_section ics;
+
+          std::size_t tmp = interval_bytes;
+          interval_bytes = bytes;
+          if (bytes != 0)
+            {
+              countdown_bytes = next_countdown ();
+            }
+          return tmp;
+          // ----- End of critical section -----------------------------------
+        }
+
+        std::size_t
+        sampling_interval (void) noexcept
+        {
+          return interval_bytes;
+        }
+
+        /**
+         * @details
+         * Called by `memory_resource::allocate()` for each
+         * successful allocation; when the sampling countdown expires,
+         * the block is added to the table.
+         *
+         * @note Can be invoked from Interrupt Service Routines.
+         */
+        void
+        record_allocation (void* addr, std::size_t bytes,
+                           void* caller) noexcept
+        {
+          if (interval_bytes == 0)
+            {
+              return;
+            }
+
+          // ----- Begin of critical section ---------------------------------
+          interrupts::critical_section ics;
+
+          if (bytes < countdown_bytes)
+            {
+              countdown_bytes -= bytes;
+              return;
+            }
+          countdown_bytes = next_countdown ();
+
+          if (live_samples >= max_samples)
+            {
+              ++dropped_samples;
+              return;
+            }
+
+          std::size_t i = slot (addr);
+          while (table[i].address != nullptr)
+            {
+              i = (i + 1) & (table_size - 1);
+            }
+
+          table[i].address = addr;
+          table[i].bytes = bytes;
+          table[i].caller = caller;
+          ++live_samples;
+          // ----- End of critical section -----------------------------------
+        }
+
+        /**
+         * @details
+         * Called by `memory_resource::deallocate()`; when there are
+         * no live samples, it returns immediately.
+         *
+         * @note Can be invoked from Interrupt Service Routines.
+         */
+        void
+        record_deallocation (void* addr) noexcept
+        {
+          if (live_samples == 0 || addr == nullptr)
+            {
+              return;
+            }
+
+          // ----- Begin of critical section ---------------------------------
+          interrupts::critical_section ics;
+
+          std::size_t i = find (addr);
+          if (i == table_size)
+            {
+              return;
+            }
+
+          // Backward shift deletion, to keep the probe
+          // sequences unbroken.
+          std::size_t j = i;
+          for (;;)
+            {
+              j = (j + 1) & (table_size - 1);
+              if (table[j].address == nullptr)
+                {
+                  break;
+                }
+              std::size_t k = slot (table[j].address);
+              // Entries whose slot is cyclically in (i, j] stay.
+              if ((i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j)))
+                {
+                  continue;
+                }
+              table[i] = table[j];
+              i = j;
+            }
+
+          table[i].address = nullptr;
+          --live_samples;
+          // ----- End of critical section -----------------------------------
+        }
+
+        /**
+         * @note Can be invoked from Interrupt Service Routines.
+         */
+        void
+        record_resize (void* addr, std::size_t bytes) noexcept
+        {
+          if (live_samples == 0)
+            {
+              return;
+            }
+
+          // ----- Begin of critical section ---------------------------------
+          interrupts::critical_section ics;
+
+          std::size_t i = find (addr);
+          if (i != table_size)
+            {
+              table[i].bytes = bytes;
+            }
+          // ----- End of critical section -----------------------------------
+        }
+
+        std::size_t
+        samples (void) noexcept
+        {
+          return live_samples;
+        }
+
+        std::size_t
+        dropped (void) noexcept
+        {
+          return dropped_samples;
+        }
+
+        /**
+         * @details
+         * The samples are copied in a single interrupts critical section,
+         * so the result is consistent.
+         *
+         * @note Can be invoked from Interrupt Service Routines.
+         */
+        std::size_t
+        snapshot (sample* buffer, std::size_t count) noexcept
+        {
+          assert (buffer != nullptr);
+
+          // ----- Begin of critical section ---------------------------------
+          interrupts::critical_section ics;
+
+          std::size_t n = 0;
+          for (std::size_t i = 0; i < table_size && n < count; ++i)
+            {
+              if (table[i].address != nullptr)
+                {
+                  buffer[n++] = table[i];
+                }
+            }
+          return n;
+          // ----- End of critical section -----------------------------------
+        }
+
+        /**
+         * @details
+         * For each call site, print the number of live samples,
+         * their total size, and the estimated number of live bytes
+         * allocated from there; a sample stands for the sampling
+         * interval, or for its own size if larger.
+         *
+         * @warning Not reentrant.
+         */
+        void
+        trace_print (void)
+        {
+#if defined(TRACE)
+          std::size_t n = snapshot (print_buffer, table_size);
+
+          trace::printf ("Heap profile: %u samples, %u dropped, "
+                         "interval %u bytes\n",
+                         n, dropped (), interval_bytes);
+
+          for (std::size_t i = 0; i < n; ++i)
+            {
+              void* caller = print_buffer[i].caller;
+
+              bool seen = false;
+              for (std::size_t j = 0; j < i; ++j)
+                {
+                  if (print_buffer[j].caller == caller)
+                    {
+                      seen = true;
+                      break;
+                    }
+                }
+              if (seen)
+                {
+                  continue;
+                }
+
+              std::size_t count = 0;
+              std::size_t bytes = 0;
+              std::size_t estimated = 0;
+              for (std::size_t j = i; j < n; ++j)
+                {
+                  if (print_buffer[j].caller == caller)
+                    {
+                      ++count;
+                      bytes += print_buffer[j].bytes;
+                      estimated += max (print_buffer[j].bytes, interval_bytes);
+                    }
+                }
+
+              trace::printf ("\t%p: %u samples, %u bytes, ~%u bytes live\n",
+                             caller, count, bytes, estimated);
+            }
+#endif // defined(TRACE)
+        }
+
+        // --------------------------------------------------------------------
+
+      } // namespace heap_profiler
+    } // namespace memory
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_HEAP_PROFILER)
+
+// ----------------------------------------------------------------------------
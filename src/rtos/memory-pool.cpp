@@ -36,6 +36,17 @@
 #pragma clang diagnostic ignored "-Wc++98-compat"
 #endif
 
+#if defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+namespace
+{
+  // The free list head keeps the block index plus 1 in the low half
+  // (0 means an empty list) and a generation count in the high half,
+  // changed by every update, so a stale compare-and-swap always fails.
+  constexpr uint32_t head_index_mask = 0xFFFF;
+  constexpr uint32_t head_generation_increment = 0x10000;
+} // namespace
+#endif
+
 namespace micro_os_plus
 {
   namespace rtos
@@ -177,6 +188,19 @@ namespace micro_os_plus
      * memset (block, 0, mp.block_size ());
      * @endcode
      *
+     * @par Lock-free operation
+     *
+     * When `MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL` is defined,
+     * `try_alloc()` and `free()` do not mask interrupts; the free
+     * list is updated with compare-and-swap on a tagged head
+     * (block index plus a generation count, to prevent the ABA
+     * problem) and the counters are atomic. The blocking `alloc()`
+     * and `timed_alloc()` still enter a critical section
+     * before suspending on the waiting list, and test the free list
+     * again after the thread is linked, so a block freed
+     * concurrently by another core does not leave it waiting. The target must have
+     * native 32-bit atomic compare-and-swap (like Cortex-M3 and up).
+     *
      * @par POSIX compatibility
      *  No POSIX similar functionality identified.
      *  Current functionality inspired by ARM CMSIS, with extensions.
@@ -381,6 +405,11 @@ namespace micro_os_plus
       micro_os_plus_assert_throw (pool_arena_address_ != nullptr, ENOMEM);
 
       internal_init_ ();
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      object_registry::internal_link_ (*this,
+                                       object_registry::kind::memory_pool);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
     }
 
     /**
@@ -409,6 +438,10 @@ namespace micro_os_plus
       trace::printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      object_registry::internal_unlink_ (*this);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
       // There must be no threads waiting for this pool.
       assert (list_.empty ());
 
@@ -428,47 +461,133 @@ namespace micro_os_plus
      */
 
     /*
-     * Construct the linked list of blocks and initialise the
-     * internal pointers and counters.
+     * Initialise the internal pointers and counters.
+     *
+     * The blocks are not linked here; they are taken in order from the
+     * arena, by advancing a watermark, and only the freed blocks are
+     * linked in the free list. This keeps the initialisation (and the
+     * reset) O(1), without touching the arena.
      */
     void
     memory_pool::internal_init_ (void)
     {
-      // Construct a linked list of blocks. Store the pointer at
-      // the beginning of each block. Each block
-      // will hold the address of the next free block, or nullptr at the end.
-      char* p = static_cast<char*> (pool_arena_address_);
-      for (std::size_t i = 1; i < blocks_; ++i)
+#if defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+      // No freed blocks; advance the generation to invalidate
+      // any pending compare-and-swap.
+      head_.store ((head_.load (std::memory_order_relaxed)
+                    + head_generation_increment)
+                       & ~head_index_mask,
+                   std::memory_order_release);
+#else
+      first_ = nullptr; // No freed blocks.
+#endif
+
+      watermark_ = 0; // No blocks taken from the arena.
+
+      count_ = 0; // No allocated blocks.
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+      if (scheduler::started ())
         {
-          // Compute the address of the next block;
-          char* pn = p + block_size_bytes_;
+          // Start measuring the time spent with no blocks allocated.
+          statistics_.occupancy_.internal_update_ (0, blocks_);
+        }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+    }
+
+#if defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
 
-          // Make this block point to the next one.
-          *(static_cast<void**> (static_cast<void*> (p))) = pn;
-          // Advance pointer
-          p = pn;
+    /*
+     * Internal function used to return the first block in the
+     * free list, or, if the list is empty, the next never used
+     * block from the arena.
+     * Lock-free, can be called from any context.
+     */
+    void*
+    memory_pool::internal_try_first_ (void)
+    {
+      char* const arena = static_cast<char*> (pool_arena_address_);
+      void* p = nullptr;
+
+      // Pop from the free list.
+      uint32_t head = head_.load (std::memory_order_acquire);
+      while ((head & head_index_mask) != 0)
+        {
+          char* block = arena
+                        + static_cast<std::size_t> ((head & head_index_mask)
+                                                    - 1)
+                              * block_size_bytes_;
+
+          // The block may be concurrently popped and overwritten;
+          // the value read is then irrelevant, since the generation
+          // changed and the exchange will fail.
+          uint32_t next = *static_cast<volatile uint32_t*> (
+              static_cast<void*> (block));
+
+          uint32_t desired
+              = ((head + head_generation_increment) & ~head_index_mask)
+                | (next & head_index_mask);
+          if (head_.compare_exchange_weak (head, desired,
+                                           std::memory_order_acquire,
+                                           std::memory_order_acquire))
+            {
+              p = block;
+              break;
+            }
         }
 
-      // Mark end of list.
-      *(static_cast<void**> (static_cast<void*> (p))) = nullptr;
+      if (p == nullptr)
+        {
+          // Take the next never used block.
+          memory_pool::size_t watermark
+              = watermark_.load (std::memory_order_relaxed);
+          for (;;)
+            {
+              if (watermark >= blocks_)
+                {
+                  return nullptr;
+                }
+              if (watermark_.compare_exchange_weak (
+                      watermark,
+                      static_cast<memory_pool::size_t> (watermark + 1),
+                      std::memory_order_relaxed, std::memory_order_relaxed))
+                {
+                  break;
+                }
+            }
+          p = arena + static_cast<std::size_t> (watermark) * block_size_bytes_;
+        }
 
-      first_ = pool_arena_address_; // Pointer to first block.
+      count_.fetch_add (1, std::memory_order_relaxed);
 
-      count_ = 0; // No allocated blocks.
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+      internal_update_statistics_ (true);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+
+      return p;
     }
 
+#else
+
     /*
      * Internal function used to return the first block in the
-     * free list.
+     * free list, or, if the list is empty, the next never used
+     * block from the arena.
      * Should be called from an interrupts critical section.
      */
     void*
     memory_pool::internal_try_first_ (void)
     {
+      void* p;
       if (first_ != nullptr)
         {
-          void* p = static_cast<void*> (first_);
+          p = static_cast<void*> (first_);
           first_ = *(static_cast<void**> (first_));
+        }
+      else if (watermark_ < blocks_)
+        {
+          p = static_cast<char*> (pool_arena_address_)
+              + static_cast<std::size_t> (watermark_) * block_size_bytes_;
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
@@ -477,15 +596,104 @@ namespace micro_os_plus
 #pragma GCC diagnostic ignored "-Warith-conversion"
 #endif
 #endif
-          count_ = count_ + 1; // Volatile increment.
+          watermark_ = watermark_ + 1; // Volatile increment.
 #pragma GCC diagnostic pop
+        }
+      else
+        {
+          return nullptr;
+        }
 
-          return p;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#if defined(__GNUC__) && !defined(__clang__)
+#if __GNUC__ >= 10
+#pragma GCC diagnostic ignored "-Warith-conversion"
+#endif
+#endif
+      count_ = count_ + 1; // Volatile increment.
+#pragma GCC diagnostic pop
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+      internal_update_statistics_ (true);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+
+      return p;
+    }
+
+#endif // defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+
+#if defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+
+    /*
+     * Internal function used to push a block to the free list.
+     * Lock-free, can be called from any context.
+     */
+    void
+    memory_pool::internal_push_ (void* block)
+    {
+      uint32_t index = static_cast<uint32_t> (
+          static_cast<std::size_t> (static_cast<char*> (block)
+                                    - static_cast<char*> (pool_arena_address_))
+          / block_size_bytes_);
+
+      // Perform a lock-free push_front() on the single linked LIFO list;
+      // the blocks store the index of the next one (plus 1).
+      uint32_t head = head_.load (std::memory_order_relaxed);
+      uint32_t desired;
+      do
+        {
+          *static_cast<volatile uint32_t*> (block) = head & head_index_mask;
+          desired = ((head + head_generation_increment) & ~head_index_mask)
+                    | (index + 1);
         }
+      while (!head_.compare_exchange_weak (head, desired,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed));
+
+      count_.fetch_sub (1, std::memory_order_relaxed);
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+      internal_update_statistics_ (false);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+    }
+
+#else
+
+    /*
+     * Internal function used to push a block to the free list.
+     * Should be called from an interrupts critical section.
+     */
+    void
+    memory_pool::internal_push_ (void* block)
+    {
+      // Perform a push_front() on the single linked LIFO list,
+      // i.e. add the block to the beginning of the list.
+
+      // Link previous list to this block; may be null, but it does
+      // not matter.
+      *(static_cast<void**> (block)) = first_;
+
+      // Now this block is the first one.
+      first_ = block;
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#if defined(__GNUC__) && !defined(__clang__)
+#if __GNUC__ >= 10
+#pragma GCC diagnostic ignored "-Warith-conversion"
+#endif
+#endif
+      count_ = count_ - 1; // Volatile decrement.
+#pragma GCC diagnostic pop
 
-      return nullptr;
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+      internal_update_statistics_ (false);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
     }
 
+#endif // defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+
     /**
      * @endcond
      */
@@ -526,8 +734,10 @@ namespace micro_os_plus
       // Extra test before entering the loop, with its inherent weight.
       // Trade size for speed.
       {
+#if !defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
         // ----- Enter critical section -------------------------------------
         interrupts::critical_section ics;
+#endif
 
         p = internal_try_first_ ();
         if (p != nullptr)
@@ -537,6 +747,14 @@ namespace micro_os_plus
 #endif
             return p;
           }
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+#if defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+#endif
+        statistics_.blocked_allocations_++;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
         // ----- Exit critical section --------------------------------------
       }
 
@@ -563,8 +781,20 @@ namespace micro_os_plus
               }
 
             // Add this thread to the memory pool waiting list.
-            scheduler::internal_link_node (list_, node);
+            scheduler::internal_link_node (
+                list_, node, rtos::statistics::wait_reason::memory_pool, this);
             // state::suspended set in above link().
+#if defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+            // free() does not mask interrupts, so on multi-core a block
+            // freed by another core after the test above found no
+            // waiting thread; test again now that the thread is
+            // linked, and stay ready if a block is available.
+            if ((head_.load (std::memory_order_acquire) & head_index_mask)
+                != 0)
+              {
+                crt_thread.resume ();
+              }
+#endif // defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
             // ----- Exit critical section ----------------------------------
           }
 
@@ -615,8 +845,10 @@ namespace micro_os_plus
 
       void* p;
       {
+#if !defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
         // ----- Enter critical section -------------------------------------
         interrupts::critical_section ics;
+#endif
 
         p = internal_try_first_ ();
         // ----- Exit critical section --------------------------------------
@@ -691,8 +923,10 @@ namespace micro_os_plus
       // Extra test before entering the loop, with its inherent weight.
       // Trade size for speed.
       {
+#if !defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
         // ----- Enter critical section -------------------------------------
         interrupts::critical_section ics;
+#endif
 
         p = internal_try_first_ ();
         if (p != nullptr)
@@ -702,6 +936,14 @@ namespace micro_os_plus
 #endif
             return p;
           }
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+#if defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+#endif
+        statistics_.blocked_allocations_++;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
         // ----- Exit critical section --------------------------------------
       }
 
@@ -736,9 +978,21 @@ namespace micro_os_plus
 
             // Add this thread to the memory pool waiting list,
             // and the clock timeout list.
-            scheduler::internal_link_node (list_, node, clock_list,
-                                           timeout_node);
+            scheduler::internal_link_node (
+                list_, node, clock_list, timeout_node,
+                rtos::statistics::wait_reason::memory_pool, this);
             // state::suspended set in above link().
+#if defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+            // free() does not mask interrupts, so on multi-core a block
+            // freed by another core after the test above found no
+            // waiting thread; test again now that the thread is
+            // linked, and stay ready if a block is available.
+            if ((head_.load (std::memory_order_acquire) & head_index_mask)
+                != 0)
+              {
+                crt_thread.resume ();
+              }
+#endif // defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
             // ----- Exit critical section ----------------------------------
           }
 
@@ -762,6 +1016,15 @@ namespace micro_os_plus
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_MEMPOOL)
               trace::printf ("%s() TMO @%p %s\n", __func__, this, name ());
 #endif
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+              {
+                // ----- Enter critical section -----------------------------
+                interrupts::critical_section ics;
+
+                statistics_.timeouts_++;
+                // ----- Exit critical section ------------------------------
+              }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
               return nullptr;
             }
         }
@@ -775,7 +1038,8 @@ namespace micro_os_plus
      * back to the memory pool.
      *
      * It uses a critical section to protect simultaneous access from
-     * other threads or interrupts.
+     * other threads or interrupts, or, in the lock-free configuration,
+     * an atomic compare-and-swap.
      *
      * @note Can be invoked from Interrupt Service Routines.
      */
@@ -802,29 +1066,12 @@ namespace micro_os_plus
         }
 
       {
+#if !defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
         // ----- Enter critical section -------------------------------------
         interrupts::critical_section ics;
-
-        // Perform a push_front() on the single linked LIFO list,
-        // i.e. add the block to the beginning of the list.
-
-        // Link previous list to this block; may be null, but it does
-        // not matter.
-        *(static_cast<void**> (block)) = first_;
-
-        // Now this block is the first one.
-        first_ = block;
-
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#if defined(__GNUC__) && !defined(__clang__)
-#if __GNUC__ >= 10
-#pragma GCC diagnostic ignored "-Warith-conversion"
-#endif
 #endif
-        count_ = count_ - 1; // Volatile decrement.
-#pragma GCC diagnostic push
 
+        internal_push_ (block);
         // ----- Exit critical section --------------------------------------
       }
 
@@ -838,6 +1085,10 @@ namespace micro_os_plus
      * @details
      * Reset the memory pool to the initial state, with all blocks free.
      *
+     * The blocks are not visited, the free list is simply dropped
+     * and blocks are again taken in order from the arena,
+     * so the duration does not depend on the pool size.
+     *
      * @warning Cannot be invoked from Interrupt Service Routines.
      */
     result_t
@@ -866,6 +1117,286 @@ namespace micro_os_plus
       return result::ok;
     }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+
+    /**
+     * @cond ignore
+     */
+
+    /*
+     * Internal function, called after the count was updated.
+     * Should be called from an interrupts critical section, except
+     * in the lock-free configuration, where it enters its own.
+     */
+    void
+    memory_pool::internal_update_statistics_ (bool allocated)
+    {
+#if defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+      // ----- Enter critical section -----------------------------------------
+      interrupts::critical_section ics;
+#endif
+
+      if (allocated)
+        {
+          statistics_.allocations_++;
+        }
+      else
+        {
+          statistics_.frees_++;
+        }
+      statistics_.occupancy_.internal_update_ (count_, blocks_);
+      // ----- Exit critical section ------------------------------------------
+    }
+
+    /**
+     * @endcond
+     */
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @class memory_pool::statistics
+     * @details
+     * The counters are updated in the same critical sections that
+     * update the pool, and the durations are measured with the high
+     * resolution clock, so they can be used to size the
+     * pool from real data.
+     *
+     * The time spent with no blocks allocated is measured from the
+     * moment the scheduler is started, or from the first time
+     * all blocks are freed.
+     *
+     * In the lock-free configuration the statistics are updated
+     * in a short interrupts critical section.
+     *
+     * The measurements are not cleared by `memory_pool::reset()`.
+     */
+
+    /**
+     * @details
+     * The counters and the durations are zeroed; an ongoing full or
+     * empty interval is restarted from now.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    void
+    memory_pool::statistics::clear (void)
+    {
+      // ----- Enter critical section -----------------------------------------
+      interrupts::critical_section ics;
+
+      allocations_ = 0;
+      frees_ = 0;
+      blocked_allocations_ = 0;
+      timeouts_ = 0;
+      occupancy_.internal_clear_ ();
+      // ----- Exit critical section ------------------------------------------
+    }
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+
+    // ========================================================================
+
+    /**
+     * @class memory_pool::magazine
+     * @details
+     * In pipelines where threads allocate and free blocks in
+     * tight loops, all operations on a shared memory pool
+     * contend for the same free list. A magazine keeps a
+     * private stack of free blocks in front of the pool, and
+     * accesses the pool only when it runs empty or full, moving
+     * half of its capacity at a time, in a single critical section.
+     *
+     * The blocks cached in magazines are counted as allocated
+     * by the pool.
+     *
+     * The ratio `hits() / (hits() + misses())` gives the cache hit rate.
+     *
+     * @par Example
+     *
+     * @code{.cpp}
+     * memory_pool_inclusive<packet_t, 64> packets;
+     *
+     * void
+     * worker(void)
+     * {
+     *   memory_pool::magazine_inclusive<8> mag { packets };
+     *   for (; some_condition();)
+     *     {
+     *       void* p = mag.alloc();
+     *       // Process packet.
+     *       mag.free(p);
+     *     }
+     * }
+     * @endcode
+     */
+
+    /**
+     * @details
+     * The storage is an array of `size` pointers, used as a
+     * stack of cached free blocks.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    memory_pool::magazine::magazine (memory_pool& pool, void** storage,
+                                     std::size_t size)
+        : pool_{ &pool }, storage_{ storage }, size_{ size }
+    {
+      assert (storage != nullptr);
+      assert (size > 0);
+    }
+
+    /**
+     * @details
+     * The cached blocks are returned to the pool.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    memory_pool::magazine::~magazine ()
+    {
+      flush ();
+    }
+
+    /**
+     * @details
+     * Get a block from the magazine; if empty, refill it
+     * from the pool. If the pool is also empty, wait on the pool
+     * like `memory_pool::alloc()`.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    void*
+    memory_pool::magazine::alloc (void)
+    {
+      void* p = try_alloc ();
+      if (p != nullptr)
+        {
+          return p;
+        }
+
+      return pool_->alloc ();
+    }
+
+    /**
+     * @details
+     * Get a block from the magazine; if empty, refill it
+     * with up to half of its capacity from the pool.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    void*
+    memory_pool::magazine::try_alloc (void)
+    {
+      if (count_ > 0)
+        {
+          ++hits_;
+          return storage_[--count_];
+        }
+
+      ++misses_;
+
+      std::size_t batch = (size_ + 1) / 2;
+      {
+#if !defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+#endif
+
+        while (count_ < batch)
+          {
+            void* p = pool_->internal_try_first_ ();
+            if (p == nullptr)
+              {
+                break;
+              }
+            storage_[count_++] = p;
+          }
+        // ----- Exit critical section --------------------------------------
+      }
+
+      if (count_ == 0)
+        {
+          return nullptr;
+        }
+
+      return storage_[--count_];
+    }
+
+    /**
+     * @details
+     * Store the block in the magazine; if full, first return half
+     * of the cached blocks to the pool.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    memory_pool::magazine::free (void* block)
+    {
+      // Validate pointer.
+      if ((block < pool_->pool_arena_address_)
+          || (block >= (static_cast<char*> (pool_->pool_arena_address_)
+                        + pool_->blocks_ * pool_->block_size_bytes_)))
+        {
+          return EINVAL;
+        }
+
+      if (count_ >= size_)
+        {
+          std::size_t batch = (size_ + 1) / 2;
+          {
+#if !defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+#endif
+
+            for (std::size_t i = 0; i < batch; ++i)
+              {
+                pool_->internal_push_ (storage_[--count_]);
+              }
+            // ----- Exit critical section ----------------------------------
+          }
+
+          // Multiple blocks were freed, wake-up all threads, if any.
+          pool_->list_.resume_all ();
+        }
+
+      storage_[count_++] = block;
+
+      return result::ok;
+    }
+
+    /**
+     * @details
+     * Return all cached blocks to the pool, for example before
+     * the thread waits for a long time.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    void
+    memory_pool::magazine::flush (void)
+    {
+      if (count_ == 0)
+        {
+          return;
+        }
+
+      {
+#if !defined(MICRO_OS_PLUS_USE_RTOS_LOCK_FREE_MEMORY_POOL)
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+#endif
+
+        while (count_ > 0)
+          {
+            pool_->internal_push_ (storage_[--count_]);
+          }
+        // ----- Exit critical section --------------------------------------
+      }
+
+      // Wake-up all threads, if any.
+      pool_->list_.resume_all ();
+    }
+
     // ------------------------------------------------------------------------
 
   } // namespace rtos
@@ -0,0 +1,439 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <micro-os-plus/rtos/memory-slab.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace memory
+    {
+      // ======================================================================
+
+      /**
+       * @class slab
+       * @details
+       * Small requests are served from fixed size blocks, grouped
+       * in size classes; each class keeps a list of freed blocks,
+       * so allocation and deallocation take constant time
+       * (apart from a short search for the class), and
+       * fragmentation is bounded by the class granularity.
+       *
+       * The first part of the arena is split into pages,
+       * assigned to size classes on demand; the rest of the
+       * arena is managed by a general allocator
+       * (`micro_os_plus::memory::first_fit_top`), used for large
+       * requests, for requests with extended alignment, or
+       * when all pages are in use.
+       *
+       * Blocks are identified by their address, so the size
+       * is not needed when deallocating, as required by `free()`.
+       *
+       * Pages are not returned to the pool of unassigned pages
+       * when all their blocks are freed; after a `reset()`,
+       * all pages are again available.
+       *
+       * To use it for `malloc()` and `operator new`, define
+       * `MICRO_OS_PLUS_TYPE_APPLICATION_MEMORY_RESOURCE` to
+       * `micro_os_plus::rtos::memory::slab`.
+       *
+       * @note Not thread safe; the callers must provide the
+       * synchronisation, as `malloc()` and the RTOS allocators do.
+       */
+
+      /**
+       * @details
+       * The classes are powers of two, from 16 to 256 bytes.
+       */
+      const std::size_t slab::default_class_sizes[5]
+          = { 16, 32, 64, 128, 256 };
+
+      /**
+       * @details
+       * Half of the arena is reserved for the size classes,
+       * with the default class sizes and page size.
+       */
+      slab::slab (const char* name, void* addr, std::size_t bytes)
+          : slab{ name,
+                  addr,
+                  bytes,
+                  bytes / 2,
+                  default_class_sizes,
+                  sizeof (default_class_sizes)
+                      / sizeof (default_class_sizes[0]) }
+      {
+        ;
+      }
+
+      /**
+       * @details
+       * The class sizes are rounded up to multiples of the
+       * maximum alignment, and must not exceed the page size.
+       */
+      slab::slab (const char* name, void* addr, std::size_t bytes,
+                  std::size_t slab_bytes, const std::size_t* class_sizes,
+                  std::size_t classes, std::size_t page_size_bytes)
+          : memory_resource{ name }, //
+            fallback_{ name, internal_fallback_address_ (addr, slab_bytes),
+                       internal_fallback_size_bytes_ (bytes, slab_bytes) }
+      {
+        trace::printf ("%s(%p,%u,%u) @%p %s\n", __func__, addr, bytes,
+                       slab_bytes, this, this->name ());
+
+        internal_construct_ (addr, bytes, slab_bytes, class_sizes, classes,
+                             page_size_bytes);
+      }
+
+      slab::~slab ()
+      {
+        trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      }
+
+      /**
+       * @cond ignore
+       */
+
+      void*
+      slab::internal_fallback_address_ (void* addr, std::size_t slab_bytes)
+      {
+        return static_cast<char*> (addr)
+               + align_size (slab_bytes, memory_resource::max_align);
+      }
+
+      std::size_t
+      slab::internal_fallback_size_bytes_ (std::size_t bytes,
+                                           std::size_t slab_bytes)
+      {
+        std::size_t aligned
+            = align_size (slab_bytes, memory_resource::max_align);
+        assert (aligned < bytes);
+        return bytes - aligned;
+      }
+
+      void
+      slab::internal_construct_ (void* addr, std::size_t bytes,
+                                 std::size_t slab_bytes,
+                                 const std::size_t* class_sizes,
+                                 std::size_t classes,
+                                 std::size_t page_size_bytes)
+      {
+        assert (addr != nullptr);
+        assert (classes > 0 && classes <= max_classes);
+        assert (page_size_bytes >= memory_resource::max_align);
+
+        page_size_bytes_
+            = align_size (page_size_bytes, memory_resource::max_align);
+
+        std::size_t prev = 0;
+        for (std::size_t i = 0; i < classes; ++i)
+          {
+            std::size_t sz
+                = align_size (class_sizes[i], memory_resource::max_align);
+            assert (sz > prev);
+            assert (sz <= page_size_bytes_);
+            classes_[i].size_bytes = sz;
+            prev = sz;
+          }
+        classes_count_ = classes;
+
+        // The slab area starts with the table of page classes,
+        // followed by the aligned pages.
+        slab_bytes = align_size (slab_bytes, memory_resource::max_align);
+        std::size_t pages = slab_bytes / (page_size_bytes_ + 1);
+        while (pages > 0
+               && align_size (pages, memory_resource::max_align)
+                          + pages * page_size_bytes_
+                      > slab_bytes)
+          {
+            --pages;
+          }
+        pages_ = pages;
+
+        page_classes_ = static_cast<uint8_t*> (addr);
+        pages_address_ = static_cast<char*> (addr)
+                         + align_size (pages, memory_resource::max_align);
+
+        total_bytes_ = bytes;
+
+        internal_reset_ ();
+      }
+
+      void
+      slab::internal_reset_ (void) noexcept
+      {
+        for (std::size_t i = 0; i < classes_count_; ++i)
+          {
+            classes_[i].free_list = nullptr;
+            classes_[i].bump = nullptr;
+            classes_[i].bump_end = nullptr;
+            classes_[i].allocated_chunks = 0;
+          }
+
+        // Pages are assigned in order; no need to clear the table.
+        pages_used_ = 0;
+
+        slab_allocated_bytes_ = 0;
+        slab_allocated_chunks_ = 0;
+
+        max_allocated_bytes_ = 0;
+        internal_update_statistics_ ();
+      }
+
+      void*
+      slab::internal_class_allocate_ (std::size_t index) noexcept
+      {
+        size_class& sc = classes_[index];
+        void* p;
+
+        if (sc.free_list != nullptr)
+          {
+            // Reuse a freed block.
+            p = sc.free_list;
+            sc.free_list = *static_cast<void**> (p);
+          }
+        else if (sc.bump != sc.bump_end)
+          {
+            // Take a never used block from the current page.
+            p = sc.bump;
+            sc.bump += sc.size_bytes;
+          }
+        else if (pages_used_ < pages_)
+          {
+            // Assign a new page to this class.
+            page_classes_[pages_used_] = static_cast<uint8_t> (index);
+            char* page = pages_address_ + pages_used_ * page_size_bytes_;
+            ++pages_used_;
+
+            p = page;
+            sc.bump = page + sc.size_bytes;
+            sc.bump_end
+                = page + (page_size_bytes_ / sc.size_bytes) * sc.size_bytes;
+          }
+        else
+          {
+            return nullptr;
+          }
+
+        ++sc.allocated_chunks;
+        slab_allocated_bytes_ += sc.size_bytes;
+        ++slab_allocated_chunks_;
+
+        return p;
+      }
+
+      slab::size_class*
+      slab::internal_class_of_ (void* addr) noexcept
+      {
+        char* p = static_cast<char*> (addr);
+        if (p >= pages_address_
+            && p < pages_address_ + pages_used_ * page_size_bytes_)
+          {
+            std::size_t page
+                = static_cast<std::size_t> (p - pages_address_)
+                  / page_size_bytes_;
+            return &classes_[page_classes_[page]];
+          }
+
+        return nullptr;
+      }
+
+      void
+      slab::internal_update_statistics_ (void) noexcept
+      {
+        allocated_bytes_
+            = slab_allocated_bytes_ + fallback_.allocated_bytes ();
+        if (allocated_bytes_ > max_allocated_bytes_)
+          {
+            max_allocated_bytes_ = allocated_bytes_;
+          }
+        free_bytes_ = total_bytes_ - allocated_bytes_;
+        allocated_chunks_
+            = slab_allocated_chunks_ + fallback_.allocated_chunks ();
+        free_chunks_ = fallback_.free_chunks ();
+      }
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @details
+       * Requests up to the largest class size, with an alignment
+       * not larger than the maximum alignment, are served from
+       * the smallest class that fits; if no pages are available,
+       * and for all other requests, the general allocator is used.
+       */
+      void*
+      slab::do_allocate (std::size_t bytes, std::size_t alignment)
+      {
+        void* mem = nullptr;
+
+        if (alignment <= memory_resource::max_align)
+          {
+            for (std::size_t i = 0; i < classes_count_; ++i)
+              {
+                if (bytes <= classes_[i].size_bytes)
+                  {
+                    mem = internal_class_allocate_ (i);
+                    break;
+                  }
+              }
+          }
+
+        if (mem == nullptr)
+          {
+            mem = internal_forward_allocate (fallback_, bytes, alignment);
+          }
+
+        internal_update_statistics_ ();
+
+        if (mem == nullptr)
+          {
+#if defined(MICRO_OS_PLUS_TRACE_LIBC_MALLOC)
+            trace::printf ("slab::%s(%u,%u) @%p %s out of memory\n",
+                           __func__, bytes, alignment, this, name ());
+#endif
+            if (out_of_memory_handler_ != nullptr)
+              {
+                out_of_memory_handler_ ();
+              }
+          }
+
+        return mem;
+      }
+
+      /**
+       * @details
+       * Blocks within the pages are returned to their size class,
+       * the others to the general allocator.
+       */
+      void
+      slab::do_deallocate (void* addr, std::size_t bytes,
+                           std::size_t alignment) noexcept
+      {
+        size_class* psc = internal_class_of_ (addr);
+        if (psc != nullptr)
+          {
+            size_class& sc = *psc;
+
+            // Perform a push_front() on the single linked LIFO list.
+            *static_cast<void**> (addr) = sc.free_list;
+            sc.free_list = addr;
+
+            assert (sc.allocated_chunks > 0);
+            --sc.allocated_chunks;
+            slab_allocated_bytes_ -= sc.size_bytes;
+            --slab_allocated_chunks_;
+          }
+        else
+          {
+            internal_forward_deallocate (fallback_, addr, bytes, alignment);
+          }
+
+        internal_update_statistics_ ();
+      }
+
+      /**
+       * @details
+       * The largest block that can be allocated, either from
+       * a size class or from the general allocator.
+       */
+      std::size_t
+      slab::do_max_size (void) const noexcept
+      {
+        return max (fallback_.max_size (),
+                    classes_[classes_count_ - 1].size_bytes);
+      }
+
+      /**
+       * @details
+       * All pages and the general allocator are reset to the
+       * initial state.
+       */
+      void
+      slab::do_reset (void) noexcept
+      {
+        fallback_.reset ();
+        internal_reset_ ();
+      }
+
+      /**
+       * @details
+       * Blocks from size classes can be resized up to the class size;
+       * the other blocks are resized by the general allocator, if it
+       * supports it.
+       */
+      bool
+      slab::do_resize (void* addr, std::size_t bytes) noexcept
+      {
+        size_class* sc = internal_class_of_ (addr);
+        if (sc != nullptr)
+          {
+            return bytes <= sc->size_bytes;
+          }
+
+        bool ret = internal_forward_resize (fallback_, addr, bytes);
+        internal_update_statistics_ ();
+
+        return ret;
+      }
+
+      /**
+       * @details
+       * For blocks from size classes, the class size; for the other
+       * blocks, the size reported by the general allocator.
+       */
+      std::size_t
+      slab::do_usable_size (void* addr) noexcept
+      {
+        size_class* sc = internal_class_of_ (addr);
+        if (sc != nullptr)
+          {
+            return sc->size_bytes;
+          }
+
+        return fallback_.usable_size (addr);
+      }
+
+      // ----------------------------------------------------------------------
+
+    } // namespace memory
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
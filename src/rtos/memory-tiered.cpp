@@ -0,0 +1,370 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <micro-os-plus/rtos/memory-tiered.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace memory
+    {
+      // ======================================================================
+
+      /**
+       * @class tiered
+       * @details
+       * Each tier is a memory region, for example fast internal
+       * SRAM or slow external RAM, managed by its own memory
+       * resource, like `tlsf` or `first_fit_top`, which must be
+       * constructed by the application.
+       *
+       * Allocations with a placement hint are first tried in the tiers
+       * preferred for that placement, in the given order; if
+       * they fail, the other tiers are tried, again in order,
+       * except for `placement::dma`, which never falls back
+       * to tiers not reachable by DMA. Allocations without a hint,
+       * including those via the standard `allocate()`, try all
+       * tiers in order.
+       *
+       * Deallocations are forwarded to the tier which contains the
+       * address, so the size is not needed, as required by `free()`.
+       *
+       * For the RTOS objects, which do not pass a hint, `resource()`
+       * returns a memory resource bound to a placement; it can be
+       * set as the resource of a type, for example
+       * `set_resource_typed<thread> (&heap.resource (placement::hot))`
+       * to allocate the thread stacks in fast RAM, or
+       * `set_resource_typed<memory_pool> (&heap.resource (placement::cold))`
+       * for the pools storage.
+       *
+       * The statistics are the sums of the tiers statistics.
+       *
+       * @note Not thread safe; the callers must provide the
+       * synchronisation, as `malloc()` and the RTOS allocators do.
+       */
+
+      tiered::tiered (const char* name, const tier* tiers, std::size_t count)
+          : memory_resource{ name }
+      {
+        trace::printf ("%s(%p,%u) @%p %s\n", __func__, tiers, count, this,
+                       this->name ());
+
+        assert (tiers != nullptr);
+        assert (count > 0 && count <= max_tiers);
+
+        for (std::size_t i = 0; i < count; ++i)
+          {
+            assert (tiers[i].resource != nullptr);
+            tiers_[i] = tiers[i];
+          }
+        tiers_count_ = count;
+
+        for (std::size_t i = 0; i < placements; ++i)
+          {
+            views_[i].parent_ = this;
+            views_[i].placement_ = static_cast<memory::placement> (i);
+          }
+
+        internal_update_statistics_ ();
+      }
+
+      tiered::~tiered ()
+      {
+        trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      }
+
+      /**
+       * @details
+       * Equivalent to `resource(hint).allocate(bytes, alignment)`.
+       */
+      void*
+      tiered::allocate (std::size_t bytes, memory::placement hint,
+                        std::size_t alignment)
+      {
+        return resource (hint).allocate (bytes, alignment);
+      }
+
+      std::size_t
+      tiered::tier_of (void* addr) const noexcept
+      {
+        char* p = static_cast<char*> (addr);
+        for (std::size_t i = 0; i < tiers_count_; ++i)
+          {
+            char* begin = static_cast<char*> (tiers_[i].address);
+            if (p >= begin && p < begin + tiers_[i].size_bytes)
+              {
+                return i;
+              }
+          }
+        return tiers_count_;
+      }
+
+      /**
+       * @cond ignore
+       */
+
+      // The tiers are reached only through the tiered resource, whose
+      // public functions already counted the operation and informed
+      // the profiler; call the tier implementations directly, so the
+      // same block is not counted twice.
+
+      void*
+      tiered::internal_allocate_ (std::size_t bytes, memory::placement hint,
+                                  std::size_t alignment) noexcept
+      {
+        placement_mask_t m = mask (hint);
+        void* mem = nullptr;
+
+        if (hint != memory::placement::any)
+          {
+            // First the tiers preferred for this placement.
+            for (std::size_t i = 0; i < tiers_count_ && mem == nullptr; ++i)
+              {
+                if ((tiers_[i].placements & m) != 0)
+                  {
+                    mem = internal_forward_allocate (*tiers_[i].resource,
+                                                     bytes, alignment);
+                  }
+              }
+          }
+
+        if (mem == nullptr && hint != memory::placement::dma)
+          {
+            // Then all the other tiers.
+            for (std::size_t i = 0; i < tiers_count_ && mem == nullptr; ++i)
+              {
+                if (hint == memory::placement::any
+                    || (tiers_[i].placements & m) == 0)
+                  {
+                    mem = internal_forward_allocate (*tiers_[i].resource,
+                                                     bytes, alignment);
+                  }
+              }
+          }
+
+        internal_update_statistics_ ();
+
+        if (mem == nullptr)
+          {
+#if defined(MICRO_OS_PLUS_TRACE_LIBC_MALLOC)
+            trace::printf ("tiered::%s(%u,%u,%u) @%p %s out of memory\n",
+                           __func__, bytes, static_cast<unsigned> (hint),
+                           alignment, this, name ());
+#endif
+            if (out_of_memory_handler_ != nullptr)
+              {
+                out_of_memory_handler_ ();
+              }
+          }
+
+        return mem;
+      }
+
+      std::size_t
+      tiered::internal_max_size_ (memory::placement hint) const noexcept
+      {
+        placement_mask_t m = mask (hint);
+
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < tiers_count_; ++i)
+          {
+            if (hint != memory::placement::dma
+                || (tiers_[i].placements & m) != 0)
+              {
+                size = max (size, tiers_[i].resource->max_size ());
+              }
+          }
+        return size;
+      }
+
+      void
+      tiered::internal_update_statistics_ (void) noexcept
+      {
+        total_bytes_ = 0;
+        allocated_bytes_ = 0;
+        free_bytes_ = 0;
+        allocated_chunks_ = 0;
+        free_chunks_ = 0;
+
+        for (std::size_t i = 0; i < tiers_count_; ++i)
+          {
+            memory_resource* res = tiers_[i].resource;
+
+            total_bytes_ += res->total_bytes ();
+            allocated_bytes_ += res->allocated_bytes ();
+            free_bytes_ += res->free_bytes ();
+            allocated_chunks_ += res->allocated_chunks ();
+            free_chunks_ += res->free_chunks ();
+          }
+
+        if (allocated_bytes_ > max_allocated_bytes_)
+          {
+            max_allocated_bytes_ = allocated_bytes_;
+          }
+      }
+
+      /**
+       * @endcond
+       */
+
+      void*
+      tiered::do_allocate (std::size_t bytes, std::size_t alignment)
+      {
+        return internal_allocate_ (bytes, memory::placement::any, alignment);
+      }
+
+      void
+      tiered::do_deallocate (void* addr, std::size_t bytes,
+                             std::size_t alignment) noexcept
+      {
+        if (addr == nullptr)
+          {
+            return;
+          }
+
+        std::size_t i = tier_of (addr);
+        assert (i < tiers_count_);
+
+        internal_forward_deallocate (*tiers_[i].resource, addr, bytes,
+                                     alignment);
+
+        internal_update_statistics_ ();
+      }
+
+      /**
+       * @details
+       * The largest block available in any tier.
+       */
+      std::size_t
+      tiered::do_max_size (void) const noexcept
+      {
+        return internal_max_size_ (memory::placement::any);
+      }
+
+      void
+      tiered::do_reset (void) noexcept
+      {
+        for (std::size_t i = 0; i < tiers_count_; ++i)
+          {
+            tiers_[i].resource->reset ();
+          }
+
+        internal_update_statistics_ ();
+      }
+
+      bool
+      tiered::do_coalesce (void) noexcept
+      {
+        bool ret = false;
+        for (std::size_t i = 0; i < tiers_count_; ++i)
+          {
+            ret |= tiers_[i].resource->coalesce ();
+          }
+
+        internal_update_statistics_ ();
+
+        return ret;
+      }
+
+      bool
+      tiered::do_resize (void* addr, std::size_t bytes) noexcept
+      {
+        std::size_t i = tier_of (addr);
+        assert (i < tiers_count_);
+
+        bool ret = internal_forward_resize (*tiers_[i].resource, addr, bytes);
+
+        internal_update_statistics_ ();
+
+        return ret;
+      }
+
+      std::size_t
+      tiered::do_usable_size (void* addr) noexcept
+      {
+        std::size_t i = tier_of (addr);
+        assert (i < tiers_count_);
+
+        return tiers_[i].resource->usable_size (addr);
+      }
+
+      // ======================================================================
+
+      // The view is the resource the application called, and its
+      // public functions already counted the operation and informed
+      // the profiler; forward to the parent implementation directly,
+      // so the same block is not counted twice.
+
+      void*
+      tiered::view::do_allocate (std::size_t bytes, std::size_t alignment)
+      {
+        return parent_->internal_allocate_ (bytes, placement_, alignment);
+      }
+
+      void
+      tiered::view::do_deallocate (void* addr, std::size_t bytes,
+                                   std::size_t alignment) noexcept
+      {
+        parent_->do_deallocate (addr, bytes, alignment);
+      }
+
+      std::size_t
+      tiered::view::do_max_size (void) const noexcept
+      {
+        return parent_->internal_max_size_ (placement_);
+      }
+
+      bool
+      tiered::view::do_resize (void* addr, std::size_t bytes) noexcept
+      {
+        return parent_->do_resize (addr, bytes);
+      }
+
+      std::size_t
+      tiered::view::do_usable_size (void* addr) noexcept
+      {
+        return parent_->do_usable_size (addr);
+      }
+
+      // ----------------------------------------------------------------------
+
+    } // namespace memory
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,678 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <micro-os-plus/rtos/memory-tlsf.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace memory
+    {
+      // ======================================================================
+
+      /**
+       * @cond ignore
+       */
+
+      /*
+       * The arena is a sequence of physically adjacent blocks, each
+       * with a header storing the address of the previous block and
+       * the payload size; the lowest bit of the size marks free
+       * blocks. A zero size used block marks the end of the arena.
+       *
+       * Free blocks keep the links of the segregated list
+       * at the beginning of the payload.
+       */
+      class tlsf::block
+      {
+      public:
+        static constexpr std::size_t free_bit = 1;
+
+        std::size_t
+        size (void) const
+        {
+          return size_flags & ~free_bit;
+        }
+
+        void
+        size (std::size_t sz)
+        {
+          size_flags = sz | (size_flags & free_bit);
+        }
+
+        bool
+        is_free (void) const
+        {
+          return (size_flags & free_bit) != 0;
+        }
+
+        void
+        mark_free (void)
+        {
+          size_flags |= free_bit;
+        }
+
+        void
+        mark_used (void)
+        {
+          size_flags &= ~free_bit;
+        }
+
+        char*
+        payload (void)
+        {
+          return reinterpret_cast<char*> (this) + header_size_bytes;
+        }
+
+        static block*
+        from_payload (void* addr)
+        {
+          return reinterpret_cast<block*> (static_cast<char*> (addr)
+                                           - header_size_bytes);
+        }
+
+        block*
+        next_phys (void)
+        {
+          return reinterpret_cast<block*> (payload () + size ());
+        }
+
+        block*&
+        next_free (void)
+        {
+          return reinterpret_cast<block**> (payload ())[0];
+        }
+
+        block*&
+        prev_free (void)
+        {
+          return reinterpret_cast<block**> (payload ())[1];
+        }
+
+        block* prev_phys;
+        std::size_t size_flags;
+      };
+
+      namespace
+      {
+        // Index of the most significant bit set.
+        inline std::size_t
+        fls (std::size_t word)
+        {
+          return sizeof (unsigned long) * 8 - 1
+                 - static_cast<std::size_t> (
+                     __builtin_clzl (static_cast<unsigned long> (word)));
+        }
+
+        // Index of the least significant bit set.
+        inline std::size_t
+        ffs (uint32_t word)
+        {
+          return static_cast<std::size_t> (__builtin_ctz (word));
+        }
+      } // namespace
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @class tlsf
+       * @details
+       * Free blocks are kept in segregated lists, indexed on two
+       * levels: the first level splits sizes in powers of two,
+       * the second level splits each power of two range in
+       * linear sub-ranges. Bitmaps of the non empty lists allow to
+       * find a suitable list with a few bit operations, so both
+       * allocation and deallocation take constant time, regardless
+       * of the number of free blocks and the fragmentation.
+       *
+       * Freed blocks are immediately merged with their free neighbours.
+       *
+       * Each block has a header of two pointers; payloads
+       * are aligned to the maximum alignment.
+       *
+       * To use it for `malloc()` and `operator new`, define
+       * `MICRO_OS_PLUS_TYPE_APPLICATION_MEMORY_RESOURCE` to
+       * `micro_os_plus::rtos::memory::tlsf`.
+       *
+       * @note Not thread safe; the callers must provide the
+       * synchronisation, as `malloc()` and the RTOS allocators do.
+       */
+
+      tlsf::tlsf (void* addr, std::size_t bytes) : tlsf{ nullptr, addr, bytes }
+      {
+        ;
+      }
+
+      tlsf::tlsf (const char* name, void* addr, std::size_t bytes)
+          : memory_resource{ name }
+      {
+        trace::printf ("%s(%p,%u) @%p %s\n", __func__, addr, bytes, this,
+                       this->name ());
+
+        internal_construct_ (addr, bytes);
+      }
+
+      tlsf::~tlsf ()
+      {
+        trace::printf ("%s() @%p %s\n", __func__, this, name ());
+      }
+
+      /**
+       * @cond ignore
+       */
+
+      void
+      tlsf::internal_construct_ (void* addr, std::size_t bytes)
+      {
+        assert (addr != nullptr);
+
+        arena_address_ = addr;
+        arena_size_bytes_ = bytes;
+
+        total_bytes_ = bytes;
+
+        internal_reset_ ();
+      }
+
+      void
+      tlsf::internal_reset_ (void) noexcept
+      {
+        fl_bitmap_ = 0;
+        for (std::size_t i = 0; i < fl_index_count; ++i)
+          {
+            sl_bitmap_[i] = 0;
+            for (std::size_t j = 0; j < sl_index_count; ++j)
+              {
+                blocks_[i][j] = nullptr;
+              }
+          }
+
+        allocated_bytes_ = 0;
+        max_allocated_bytes_ = 0;
+        allocated_chunks_ = 0;
+        free_bytes_ = 0;
+        free_chunks_ = 0;
+
+        // Align the beginning of the arena.
+        char* first = reinterpret_cast<char*> (
+            align_size (reinterpret_cast<std::size_t> (arena_address_),
+                        memory_resource::max_align));
+        std::size_t adjust = static_cast<std::size_t> (
+            first - static_cast<char*> (arena_address_));
+
+        // Leave room for the first header and the end marker.
+        assert (arena_size_bytes_
+                >= adjust + 2 * header_size_bytes + min_block_size_bytes);
+        std::size_t size = (arena_size_bytes_ - adjust - 2 * header_size_bytes)
+                           & ~(memory_resource::max_align - 1);
+
+        // Larger arenas are truncated.
+        std::size_t max_size = (static_cast<std::size_t> (1) << fl_index_max)
+                               - memory_resource::max_align;
+        if (size > max_size)
+          {
+            size = max_size;
+          }
+
+        block* blk = reinterpret_cast<block*> (first);
+        blk->prev_phys = nullptr;
+        blk->size_flags = size;
+        blk->mark_free ();
+
+        block* last = blk->next_phys ();
+        last->prev_phys = blk;
+        last->size_flags = 0;
+
+        internal_insert_ (blk);
+      }
+
+      void
+      tlsf::internal_mapping_insert_ (std::size_t size, std::size_t& fl,
+                                      std::size_t& sl) noexcept
+      {
+        if (size < (static_cast<std::size_t> (1) << fl_index_shift))
+          {
+            // Small blocks are kept in linearly spaced lists.
+            fl = 0;
+            sl = size >> align_size_log2;
+          }
+        else
+          {
+            std::size_t f = fls (size);
+            sl = (size >> (f - sl_index_count_log2))
+                 ^ (static_cast<std::size_t> (1) << sl_index_count_log2);
+            fl = f - (fl_index_shift - 1);
+          }
+      }
+
+      bool
+      tlsf::internal_mapping_search_ (std::size_t size, std::size_t& fl,
+                                      std::size_t& sl) noexcept
+      {
+        // Round up to the next list, so any block in it fits.
+        if (size >= (static_cast<std::size_t> (1) << fl_index_shift))
+          {
+            std::size_t round
+                = (static_cast<std::size_t> (1)
+                   << (fls (size) - sl_index_count_log2))
+                  - 1;
+            size += round;
+          }
+
+        internal_mapping_insert_ (size, fl, sl);
+
+        return fl < fl_index_count;
+      }
+
+      tlsf::block*
+      tlsf::internal_find_suitable_ (std::size_t& fl, std::size_t& sl) noexcept
+      {
+        // Search in the current first level, from the given second level.
+        uint32_t sl_map = sl_bitmap_[fl] & (~static_cast<uint32_t> (0) << sl);
+        if (sl_map == 0)
+          {
+            // Search in the next non empty first level.
+            uint32_t fl_map
+                = fl_bitmap_ & (~static_cast<uint32_t> (0) << (fl + 1));
+            if (fl_map == 0)
+              {
+                return nullptr;
+              }
+
+            fl = ffs (fl_map);
+            sl_map = sl_bitmap_[fl];
+          }
+
+        sl = ffs (sl_map);
+
+        return blocks_[fl][sl];
+      }
+
+      void
+      tlsf::internal_insert_ (block* blk) noexcept
+      {
+        std::size_t fl;
+        std::size_t sl;
+        internal_mapping_insert_ (blk->size (), fl, sl);
+
+        block* head = blocks_[fl][sl];
+        blk->next_free () = head;
+        blk->prev_free () = nullptr;
+        if (head != nullptr)
+          {
+            head->prev_free () = blk;
+          }
+        blocks_[fl][sl] = blk;
+
+        fl_bitmap_ |= static_cast<uint32_t> (1) << fl;
+        sl_bitmap_[fl] |= static_cast<uint32_t> (1) << sl;
+
+        free_bytes_ += blk->size ();
+        ++free_chunks_;
+      }
+
+      void
+      tlsf::internal_remove_ (block* blk, std::size_t fl,
+                              std::size_t sl) noexcept
+      {
+        block* prev = blk->prev_free ();
+        block* next = blk->next_free ();
+        if (next != nullptr)
+          {
+            next->prev_free () = prev;
+          }
+        if (prev != nullptr)
+          {
+            prev->next_free () = next;
+          }
+        else
+          {
+            blocks_[fl][sl] = next;
+            if (next == nullptr)
+              {
+                // The list is empty, clear the bitmaps.
+                sl_bitmap_[fl] &= ~(static_cast<uint32_t> (1) << sl);
+                if (sl_bitmap_[fl] == 0)
+                  {
+                    fl_bitmap_ &= ~(static_cast<uint32_t> (1) << fl);
+                  }
+              }
+          }
+
+        free_bytes_ -= blk->size ();
+        --free_chunks_;
+      }
+
+      void
+      tlsf::internal_remove_ (block* blk) noexcept
+      {
+        std::size_t fl;
+        std::size_t sl;
+        internal_mapping_insert_ (blk->size (), fl, sl);
+
+        internal_remove_ (blk, fl, sl);
+      }
+
+      /*
+       * Trim the block to the given size, if the rest is large
+       * enough to make a new free block.
+       * The block must not be in a free list.
+       */
+      void
+      tlsf::internal_split_ (block* blk, std::size_t size) noexcept
+      {
+        if (blk->size () < size + header_size_bytes + min_block_size_bytes)
+          {
+            return;
+          }
+
+        block* rest = reinterpret_cast<block*> (blk->payload () + size);
+        rest->prev_phys = blk;
+        rest->size_flags = blk->size () - size - header_size_bytes;
+        rest->mark_free ();
+
+        blk->size (size);
+
+        block* next = rest->next_phys ();
+        next->prev_phys = rest;
+
+        // The next block may be free if this block was used.
+        if (next->is_free ())
+          {
+            rest = internal_merge_ (rest);
+          }
+
+        internal_insert_ (rest);
+      }
+
+      /*
+       * Merge the block with the adjacent free blocks.
+       * The block must not be in a free list.
+       */
+      tlsf::block*
+      tlsf::internal_merge_ (block* blk) noexcept
+      {
+        block* prev = blk->prev_phys;
+        if (prev != nullptr && prev->is_free ())
+          {
+            internal_remove_ (prev);
+            prev->size (prev->size () + header_size_bytes + blk->size ());
+            blk = prev;
+            blk->next_phys ()->prev_phys = blk;
+          }
+
+        block* next = blk->next_phys ();
+        if (next->is_free ())
+          {
+            internal_remove_ (next);
+            blk->size (blk->size () + header_size_bytes + next->size ());
+            blk->next_phys ()->prev_phys = blk;
+          }
+
+        return blk;
+      }
+
+      /**
+       * @endcond
+       */
+
+      /**
+       * @details
+       * Round the size up to the block granularity and search
+       * the first non empty list guaranteed to hold a block that fits;
+       * the block is split and the rest returned to the free lists.
+       *
+       * For alignments larger than the maximum alignment, a larger block
+       * is searched, and the unaligned head is returned as a free block.
+       */
+      void*
+      tlsf::do_allocate (std::size_t bytes, std::size_t alignment)
+      {
+        std::size_t size = max (align_size (bytes, memory_resource::max_align),
+                                min_block_size_bytes);
+
+        std::size_t search = size;
+        if (alignment > memory_resource::max_align)
+          {
+            // Room for the aligned block and for a free head block.
+            search += alignment + header_size_bytes + min_block_size_bytes;
+          }
+
+        block* blk = nullptr;
+        std::size_t fl;
+        std::size_t sl;
+        if (bytes < (static_cast<std::size_t> (1) << fl_index_max)
+            && internal_mapping_search_ (search, fl, sl))
+          {
+            blk = internal_find_suitable_ (fl, sl);
+          }
+
+        if (blk == nullptr)
+          {
+#if defined(MICRO_OS_PLUS_TRACE_LIBC_MALLOC)
+            trace::printf ("tlsf::%s(%u,%u) @%p %s out of memory\n",
+                           __func__, bytes, alignment, this, name ());
+#endif
+            if (out_of_memory_handler_ != nullptr)
+              {
+                out_of_memory_handler_ ();
+              }
+            return nullptr;
+          }
+
+        internal_remove_ (blk, fl, sl);
+
+        if (alignment > memory_resource::max_align)
+          {
+            char* payload = blk->payload ();
+            char* aligned = reinterpret_cast<char*> (align_size (
+                reinterpret_cast<std::size_t> (payload), alignment));
+            if (aligned != payload)
+              {
+                // The head must be large enough for a free block.
+                while (static_cast<std::size_t> (aligned - payload)
+                       < header_size_bytes + min_block_size_bytes)
+                  {
+                    aligned += alignment;
+                  }
+                std::size_t gap = static_cast<std::size_t> (aligned - payload);
+
+                block* aligned_blk = block::from_payload (aligned);
+                aligned_blk->prev_phys = blk;
+                aligned_blk->size_flags = blk->size () - gap;
+                aligned_blk->next_phys ()->prev_phys = aligned_blk;
+
+                // The previous block is used, no need to merge.
+                blk->size (gap - header_size_bytes);
+                internal_insert_ (blk);
+
+                blk = aligned_blk;
+              }
+          }
+
+        internal_split_ (blk, size);
+        blk->mark_used ();
+
+        allocated_bytes_ += blk->size ();
+        if (allocated_bytes_ > max_allocated_bytes_)
+          {
+            max_allocated_bytes_ = allocated_bytes_;
+          }
+        ++allocated_chunks_;
+
+        return blk->payload ();
+      }
+
+      /**
+       * @details
+       * The block is merged with the adjacent free blocks, if any,
+       * and inserted in the free list of its size.
+       */
+      void
+      tlsf::do_deallocate (void* addr, std::size_t bytes __attribute__ ((unused)),
+                           std::size_t alignment
+                           __attribute__ ((unused))) noexcept
+      {
+        if (addr == nullptr)
+          {
+            return;
+          }
+
+        block* blk = block::from_payload (addr);
+        assert (!blk->is_free ());
+
+        allocated_bytes_ -= blk->size ();
+        --allocated_chunks_;
+
+        blk->mark_free ();
+        blk = internal_merge_ (blk);
+        internal_insert_ (blk);
+      }
+
+      /**
+       * @details
+       * Return the size of the largest request guaranteed to be
+       * satisfied, which is the lower limit of the last non empty list,
+       * since the search rounds the requests up to the next list
+       * boundary; it may be smaller than the largest free block.
+       */
+      std::size_t
+      tlsf::do_max_size (void) const noexcept
+      {
+        if (fl_bitmap_ == 0)
+          {
+            return 0;
+          }
+
+        std::size_t fl = fls (fl_bitmap_);
+        std::size_t sl = fls (sl_bitmap_[fl]);
+
+        if (fl == 0)
+          {
+            // Small blocks are not rounded, and all blocks in a
+            // linear list have the same size.
+            return blocks_[fl][sl]->size ();
+          }
+
+        std::size_t f = fl + fl_index_shift - 1;
+        return (static_cast<std::size_t> (1) << f)
+               + (sl << (f - sl_index_count_log2));
+      }
+
+      /**
+       * @details
+       * The arena is returned to the initial state, with a single
+       * free block.
+       */
+      void
+      tlsf::do_reset (void) noexcept
+      {
+        internal_reset_ ();
+      }
+
+      /**
+       * @details
+       * Shrinking returns the tail to the free lists, if large enough.
+       * Growing is possible when the next block is free and
+       * large enough; the unused part is split back.
+       */
+      bool
+      tlsf::do_resize (void* addr, std::size_t bytes) noexcept
+      {
+        assert (addr != nullptr);
+
+        if (bytes >= (static_cast<std::size_t> (1) << fl_index_max))
+          {
+            return false;
+          }
+
+        std::size_t size = max (align_size (bytes, memory_resource::max_align),
+                                min_block_size_bytes);
+
+        block* blk = block::from_payload (addr);
+        assert (!blk->is_free ());
+
+        std::size_t old_size = blk->size ();
+        if (size > old_size)
+          {
+            block* next = blk->next_phys ();
+            if (!next->is_free ()
+                || old_size + header_size_bytes + next->size () < size)
+              {
+                return false;
+              }
+
+            // Absorb the next block.
+            internal_remove_ (next);
+            blk->size (old_size + header_size_bytes + next->size ());
+            blk->next_phys ()->prev_phys = blk;
+          }
+
+        internal_split_ (blk, size);
+
+        allocated_bytes_ = allocated_bytes_ - old_size + blk->size ();
+        if (allocated_bytes_ > max_allocated_bytes_)
+          {
+            max_allocated_bytes_ = allocated_bytes_;
+          }
+
+        return true;
+      }
+
+      /**
+       * @details
+       * The payload size of the block, a multiple of the
+       * maximum alignment.
+       */
+      std::size_t
+      tlsf::do_usable_size (void* addr) noexcept
+      {
+        assert (addr != nullptr);
+
+        return block::from_payload (addr)->size ();
+      }
+
+      // ----------------------------------------------------------------------
+
+    } // namespace memory
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
@@ -479,6 +479,41 @@ namespace micro_os_plus
         return false;
       }
 
+      /**
+       * @details
+       * The default implementation of this virtual function returns
+       * false, meaning the block cannot be resized in place.
+       *
+       * Override this function to perform the action.
+       *
+       * @par Standard compliance
+       *   Extension to standard.
+       */
+      bool
+      memory_resource::do_resize (void* addr __attribute__ ((unused)),
+                                  std::size_t bytes
+                                  __attribute__ ((unused))) noexcept
+      {
+        return false;
+      }
+
+      /**
+       * @details
+       * The default implementation of this virtual function returns
+       * zero, meaning the size is not known.
+       *
+       * Override this function to return the actual size.
+       *
+       * @par Standard compliance
+       *   Extension to standard.
+       */
+      std::size_t
+      memory_resource::do_usable_size (void* addr
+                                       __attribute__ ((unused))) noexcept
+      {
+        return 0;
+      }
+
       void
       memory_resource::internal_increase_allocated_statistics (
           std::size_t bytes) noexcept
@@ -507,6 +542,124 @@ namespace micro_os_plus
         ++free_chunks_;
       }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+
+      /**
+       * @details
+       * The fragmentation index is the percentage of the free
+       * memory which cannot be used by a single allocation:
+       * 0 when all free memory is in one block, close to 100
+       * when it is scattered in many small blocks.
+       *
+       * @par Standard compliance
+       *   Extension to standard.
+       */
+      std::size_t
+      memory_resource::fragmentation (void) const noexcept
+      {
+        std::size_t free = free_bytes_;
+        if (free == 0)
+          {
+            return 0;
+          }
+
+        std::size_t largest = do_max_size ();
+        if (largest >= free)
+          {
+            return 0;
+          }
+
+        return 100
+               - static_cast<std::size_t> (
+                   static_cast<uint64_t> (largest) * 100 / free);
+      }
+
+      /**
+       * @details
+       * Failed allocations are counted, and those which failed
+       * although the total free memory was large enough are
+       * counted as fragmentation failures.
+       */
+      void
+      memory_resource::internal_record_allocation (void* addr,
+                                                   std::size_t bytes) noexcept
+      {
+        if (addr == nullptr)
+          {
+            ++allocation_failures_;
+            if (bytes <= free_bytes_)
+              {
+                ++fragmentation_failures_;
+              }
+            return;
+          }
+
+        ++histogram_total_[histogram_bucket (bytes)];
+
+        // The live blocks are counted by their usable size, which
+        // is found again when they are freed; the size passed to
+        // deallocate() may be missing (free() passes 0).
+        std::size_t size = do_usable_size (addr);
+        if (size == 0)
+          {
+            // The memory resource cannot report the block sizes,
+            // so the live histogram is not maintained.
+            histogram_live_unknown_ = true;
+            return;
+          }
+        ++histogram_live_[histogram_bucket (size)];
+      }
+
+      /**
+       * @details
+       * The block is counted in the bucket of its usable size,
+       * as at allocation.
+       */
+      void
+      memory_resource::internal_record_deallocation (
+          void* addr, std::size_t bytes __attribute__ ((unused))) noexcept
+      {
+        if (addr == nullptr || histogram_live_unknown_)
+          {
+            return;
+          }
+
+        std::size_t size = do_usable_size (addr);
+        if (size == 0)
+          {
+            return;
+          }
+
+        --histogram_live_[histogram_bucket (size)];
+      }
+
+      /**
+       * @details
+       * Resizing in place may change the usable size, and thus
+       * the live bucket; the total histogram counts allocations
+       * and is not changed.
+       */
+      void
+      memory_resource::internal_record_resize (void* addr,
+                                               std::size_t old_size) noexcept
+      {
+        if (old_size == 0 || histogram_live_unknown_)
+          {
+            return;
+          }
+
+        std::size_t new_size = do_usable_size (addr);
+        std::size_t old_index = histogram_bucket (old_size);
+        std::size_t new_index = histogram_bucket (new_size);
+        if (old_index != new_index)
+          {
+            --histogram_live_[old_index];
+            ++histogram_live_[new_index];
+          }
+      }
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_RESOURCE)
+
       // ----------------------------------------------------------------------
 
     } // namespace memory
@@ -492,6 +492,10 @@ namespace micro_os_plus
       trace::printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      object_registry::internal_unlink_ (*this);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
 #if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_MESSAGE_QUEUE)
 
       // There must be no threads waiting for this queue.
@@ -628,6 +632,11 @@ namespace micro_os_plus
 
       internal_init_ ();
 #endif
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      object_registry::internal_link_ (*this,
+                                       object_registry::kind::message_queue);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
     }
 
     void
@@ -660,6 +669,14 @@ namespace micro_os_plus
 
       head_ = no_index;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+      if (scheduler::started ())
+        {
+          // Start measuring the time spent empty.
+          statistics_.occupancy_.internal_update_ (count_, messages_);
+        }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
       // Need not be inside the critical section,
       // the lists are protected by inner `resume_one()`.
 
@@ -760,6 +777,16 @@ namespace micro_os_plus
       // One more message added to the queue.
       ++count_;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+      statistics_.sends_++;
+      statistics_.occupancy_.internal_update_ (count_, messages_);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+      event_trace::record_event (event_trace::event::queue_send,
+                                 message_priority, this, count_);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+
       // Wake-up one thread, if any.
       receive_list_.resume_one ();
 
@@ -813,6 +840,11 @@ namespace micro_os_plus
 
       --count_;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+      statistics_.receives_++;
+      statistics_.occupancy_.internal_update_ (count_, messages_);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
       // Copy to destination
       {
         // ----- Enter uncritical section -----------------------------------
@@ -839,6 +871,11 @@ namespace micro_os_plus
       // Now this block is the first one.
       first_free_ = src;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+      event_trace::record_event (event_trace::event::queue_receive, prio,
+                                 this, count_);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+
       // Wake-up one thread, if any.
       send_list_.resume_one ();
 
@@ -924,6 +961,10 @@ namespace micro_os_plus
           {
             return result::ok;
           }
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+        statistics_.blocked_senders_++;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
         // ----- Exit critical section --------------------------------------
       }
 
@@ -946,7 +987,9 @@ namespace micro_os_plus
               }
 
             // Add this thread to the message queue send waiting list.
-            scheduler::internal_link_node (send_list_, node);
+            scheduler::internal_link_node (
+                send_list_, node, rtos::statistics::wait_reason::queue_send,
+                this);
             // state::suspended set in above link().
             // ----- Exit critical section ----------------------------------
           }
@@ -1130,6 +1173,10 @@ namespace micro_os_plus
           {
             return result::ok;
           }
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+        statistics_.blocked_senders_++;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
         // ----- Exit critical section --------------------------------------
       }
 
@@ -1161,8 +1208,9 @@ namespace micro_os_plus
 
             // Add this thread to the semaphore waiting list,
             // and the clock timeout list.
-            scheduler::internal_link_node (send_list_, node, clock_list,
-                                           timeout_node);
+            scheduler::internal_link_node (
+                send_list_, node, clock_list, timeout_node,
+                rtos::statistics::wait_reason::queue_send, this);
             // state::suspended set in above link().
             // ----- Exit critical section ----------------------------------
           }
@@ -1191,6 +1239,15 @@ namespace micro_os_plus
                              message, nbytes, message_priority, timeout, this,
                              name ());
 #endif
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+              {
+                // ----- Enter critical section -----------------------------
+                interrupts::critical_section ics;
+
+                statistics_.send_timeouts_++;
+                // ----- Exit critical section ------------------------------
+              }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
               return ETIMEDOUT;
             }
         }
@@ -1272,6 +1329,10 @@ namespace micro_os_plus
           {
             return result::ok;
           }
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+        statistics_.blocked_receivers_++;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
         // ----- Exit critical section --------------------------------------
       }
 
@@ -1294,7 +1355,9 @@ namespace micro_os_plus
               }
 
             // Add this thread to the message queue receive waiting list.
-            scheduler::internal_link_node (receive_list_, node);
+            scheduler::internal_link_node (
+                receive_list_, node,
+                rtos::statistics::wait_reason::queue_receive, this);
             // state::suspended set in above link().
             // ----- Exit critical section ----------------------------------
           }
@@ -1491,6 +1554,10 @@ namespace micro_os_plus
           {
             return result::ok;
           }
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+        statistics_.blocked_receivers_++;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
         // ----- Exit critical section --------------------------------------
       }
 
@@ -1521,8 +1588,9 @@ namespace micro_os_plus
 
             // Add this thread to the message queue receive waiting list,
             // and the clock timeout list.
-            scheduler::internal_link_node (receive_list_, node, clock_list,
-                                           timeout_node);
+            scheduler::internal_link_node (
+                receive_list_, node, clock_list, timeout_node,
+                rtos::statistics::wait_reason::queue_receive, this);
             // state::suspended set in above link().
             // ----- Exit critical section ----------------------------------
           }
@@ -1549,6 +1617,15 @@ namespace micro_os_plus
               trace::printf ("%s(%p,%u,%u) ETIMEDOUT @%p %s\n", __func__,
                              message, nbytes, timeout, this, name ());
 #endif
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+              {
+                // ----- Enter critical section -----------------------------
+                interrupts::critical_section ics;
+
+                statistics_.receive_timeouts_++;
+                // ----- Exit critical section ------------------------------
+              }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
               return ETIMEDOUT;
             }
         }
@@ -1597,6 +1674,51 @@ namespace micro_os_plus
 #endif
     }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @class message_queue::statistics
+     * @details
+     * The counters are updated in the same critical sections that
+     * update the queue, and the durations are measured with the high
+     * resolution clock, so they can be used to size the
+     * queue from real data.
+     *
+     * The time spent empty is measured from the moment the scheduler
+     * is started, or from the first time the queue becomes empty.
+     *
+     * The measurements are available only for the internal
+     * implementation (not with `MICRO_OS_PLUS_USE_RTOS_PORT_MESSAGE_QUEUE`)
+     * and are not cleared by `message_queue::reset()`.
+     */
+
+    /**
+     * @details
+     * The counters and the durations are zeroed; an ongoing full or
+     * empty interval is restarted from now.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    void
+    message_queue::statistics::clear (void)
+    {
+      // ----- Enter critical section -----------------------------------------
+      interrupts::critical_section ics;
+
+      sends_ = 0;
+      receives_ = 0;
+      blocked_senders_ = 0;
+      blocked_receivers_ = 0;
+      send_timeouts_ = 0;
+      receive_timeouts_ = 0;
+      occupancy_.internal_clear_ ();
+      // ----- Exit critical section ------------------------------------------
+    }
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+
     // ------------------------------------------------------------------------
 
   } // namespace rtos
@@ -328,6 +328,47 @@ namespace micro_os_plus
     using mutexes_list = utils::intrusive_list<mutex, utils::double_list_links,
                                                &mutex::owner_links_>;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
+#if !defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
+    using statistics_mutexes_list
+        = utils::intrusive_list<mutex, utils::double_list_links,
+                                &mutex::statistics_links_>;
+
+    // All constructed mutexes, to be enumerated by the statistics.
+    static statistics_mutexes_list statistics_mutexes_list_;
+
+#endif // !defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
+    // Call the function for all constructed mutexes, in the order
+    // of construction. Must be called with the scheduler locked.
+    template <typename F>
+    static void
+    for_each_mutex (F&& func)
+    {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Waggregate-return"
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      // The registry already links all mutexes.
+      for (auto&& object :
+           object_registry::internal_list_ (object_registry::kind::mutex))
+        {
+          func (static_cast<mutex&> (object));
+        }
+#else
+      for (auto&& mx : statistics_mutexes_list_)
+        {
+          func (mx);
+        }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
+#pragma GCC diagnostic pop
+    }
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
     // ------------------------------------------------------------------------
 
     /**
@@ -532,6 +573,17 @@ namespace micro_os_plus
       initial_priority_ceiling_ = _attributes.priority_ceiling;
       priority_ceiling_ = _attributes.priority_ceiling;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX) \
+    && !defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      {
+        // ----- Enter critical section -------------------------------------
+        scheduler::critical_section scs;
+
+        statistics_mutexes_list_.link (*this);
+        // ----- Exit critical section --------------------------------------
+      }
+#endif
+
 #if defined(MICRO_OS_PLUS_USE_RTOS_PORT_MUTEX)
 
       count_ = 0;
@@ -542,6 +594,10 @@ namespace micro_os_plus
       internal_init_ ();
 
 #endif
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      object_registry::internal_link_ (*this, object_registry::kind::mutex);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
     }
 
     /**
@@ -570,6 +626,10 @@ namespace micro_os_plus
       trace::printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      object_registry::internal_unlink_ (*this);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
 #if defined(MICRO_OS_PLUS_USE_RTOS_PORT_MUTEX)
 
       port::mutex::destroy (this);
@@ -581,6 +641,17 @@ namespace micro_os_plus
       // There must be no threads waiting for this mutex.
       assert (list_.empty ());
 
+#endif
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX) \
+    && !defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      {
+        // ----- Enter critical section -------------------------------------
+        scheduler::critical_section scs;
+
+        statistics_links_.unlink ();
+        // ----- Exit critical section --------------------------------------
+      }
 #endif
     }
 
@@ -670,6 +741,10 @@ namespace micro_os_plus
                 }
             }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+          statistics_.internal_record_acquisition_ ();
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_MUTEX)
           trace::printf ("%s() @%p %s by %p %s LCK\n", __func__, this, name (),
                          th, th->name ());
@@ -872,6 +947,10 @@ namespace micro_os_plus
             // Delayed until end of critical section.
             list_.resume_one ();
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+            statistics_.internal_record_release_ ();
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
             // Finally release the mutex.
             owner_ = nullptr;
             count_ = 0;
@@ -1013,6 +1092,10 @@ namespace micro_os_plus
 
       thread& crt_thread = this_thread::thread ();
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+      rtos::statistics::duration_t wait_timestamp = 0;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
       result_t res;
       {
         // ----- Enter critical section -------------------------------------
@@ -1023,6 +1106,17 @@ namespace micro_os_plus
           {
             return res;
           }
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+        event_trace::record_event (
+            event_trace::event::mutex_contention, 0, this,
+            static_cast<uint32_t> (reinterpret_cast<uintptr_t> (owner_)));
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+        statistics_.contentions_++;
+        wait_timestamp = hrclock.now ();
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
         // ----- Exit critical section --------------------------------------
       }
 
@@ -1040,6 +1134,10 @@ namespace micro_os_plus
             res = internal_try_lock_ (&crt_thread);
             if (res != EWOULDBLOCK)
               {
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+                statistics_.internal_record_wait_ (crt_thread,
+                                                   wait_timestamp);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
                 return res;
               }
 
@@ -1048,7 +1146,8 @@ namespace micro_os_plus
               interrupts::critical_section ics;
 
               // Add this thread to the mutex waiting list.
-              scheduler::internal_link_node (list_, node);
+              scheduler::internal_link_node (
+                  list_, node, rtos::statistics::wait_reason::mutex, this);
               // state::suspended set in above link().
               // ----- Exit critical section ------------------------------
             }
@@ -1066,6 +1165,16 @@ namespace micro_os_plus
 #if defined(MICRO_OS_PLUS_TRACE_RTOS_MUTEX)
               trace::printf ("%s() EINTR @%p %s\n", __func__, this, name ());
 #endif
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+              {
+                // ----- Enter critical section -----------------------------
+                scheduler::critical_section scs;
+
+                statistics_.internal_record_wait_ (crt_thread,
+                                                   wait_timestamp);
+                // ----- Exit critical section ------------------------------
+              }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
               return EINTR;
             }
         }
@@ -1221,6 +1330,10 @@ namespace micro_os_plus
 
       thread& crt_thread = this_thread::thread ();
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+      rtos::statistics::duration_t wait_timestamp = 0;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
       result_t res;
 
       // Extra test before entering the loop, with its inherent weight.
@@ -1234,6 +1347,17 @@ namespace micro_os_plus
           {
             return res;
           }
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+        event_trace::record_event (
+            event_trace::event::mutex_contention, 0, this,
+            static_cast<uint32_t> (reinterpret_cast<uintptr_t> (owner_)));
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+        statistics_.contentions_++;
+        wait_timestamp = hrclock.now ();
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
         // ----- Exit critical section --------------------------------------
       }
 
@@ -1258,6 +1382,10 @@ namespace micro_os_plus
             res = internal_try_lock_ (&crt_thread);
             if (res != EWOULDBLOCK)
               {
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+                statistics_.internal_record_wait_ (crt_thread,
+                                                   wait_timestamp);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
                 return res;
               }
 
@@ -1267,8 +1395,9 @@ namespace micro_os_plus
 
               // Add this thread to the mutex waiting list,
               // and the clock timeout list.
-              scheduler::internal_link_node (list_, node, clock_list,
-                                             timeout_node);
+              scheduler::internal_link_node (
+                  list_, node, clock_list, timeout_node,
+                  rtos::statistics::wait_reason::mutex, this);
               // state::suspended set in above link().
               // ----- Exit critical section ------------------------------
             }
@@ -1301,6 +1430,17 @@ namespace micro_os_plus
             }
           if (res != result::ok)
             {
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+              {
+                // ----- Enter critical section -----------------------------
+                scheduler::critical_section scs;
+
+                statistics_.internal_record_wait_ (crt_thread,
+                                                   wait_timestamp);
+                // ----- Exit critical section ------------------------------
+              }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
               if (boosted_priority_ != thread::priority::none)
                 {
                   // If the priority was boosted, it must be restored
@@ -1570,6 +1710,194 @@ namespace micro_os_plus
       }
     }
 
+    // ========================================================================
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
+    /**
+     * @class mutex::statistics
+     * @details
+     * The measurements are done with the high resolution clock,
+     * in the same critical sections that update the mutex state,
+     * and are available only for the internal implementation
+     * (not with `MICRO_OS_PLUS_USE_RTOS_PORT_MUTEX`).
+     *
+     * The measurements are not cleared by `mutex::reset()`.
+     */
+
+    /**
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    void
+    mutex::statistics::clear (void)
+    {
+      // ----- Enter critical section -----------------------------------------
+      scheduler::critical_section scs;
+
+      acquisitions_ = 0;
+      contentions_ = 0;
+      wait_cycles_total_ = 0;
+      wait_cycles_max_ = 0;
+      hold_cycles_total_ = 0;
+      hold_cycles_max_ = 0;
+      longest_waiter_ = nullptr;
+      longest_waiter_name_[0] = '\0';
+      // ----- Exit critical section ------------------------------------------
+    }
+
+    /**
+     * @details
+     * Walk the list of existing mutexes and store pointers to
+     * the `count` ones with the largest accumulated wait time,
+     * in descending order.
+     *
+     * The pointers are valid only as long as the mutexes are not
+     * destroyed.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    std::size_t
+    mutex::statistics::rank (mutex** mutexes, std::size_t count)
+    {
+      assert (mutexes != nullptr || count == 0);
+
+      std::size_t n = 0;
+
+      // ----- Enter critical section -----------------------------------------
+      scheduler::critical_section scs;
+
+      for_each_mutex ([&] (mutex& mx) {
+        rtos::statistics::duration_t cycles
+            = mx.statistics_.wait_cycles_total_;
+
+        std::size_t i;
+        if (n < count)
+          {
+            i = n++;
+          }
+        else if (count > 0
+                 && cycles
+                        > mutexes[count - 1]->statistics_.wait_cycles_total_)
+          {
+            // Replace the least contended.
+            i = count - 1;
+          }
+        else
+          {
+            return;
+          }
+
+        // Insertion sort, the array is short.
+        while (i > 0
+               && mutexes[i - 1]->statistics_.wait_cycles_total_ < cycles)
+          {
+            mutexes[i] = mutexes[i - 1];
+            --i;
+          }
+        mutexes[i] = &mx;
+      });
+
+      return n;
+      // ----- Exit critical section ------------------------------------------
+    }
+
+    /**
+     * @details
+     * One line per mutex, in the order of construction.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    void
+    mutex::statistics::trace_print (void)
+    {
+#if defined(TRACE)
+      // ----- Enter critical section -----------------------------------------
+      scheduler::critical_section scs;
+
+      trace::printf ("Mutex statistics (cycles)\n");
+
+      for_each_mutex ([] (mutex& mx) {
+        const statistics& st = mx.statistics_;
+        const char* waiter = (st.longest_waiter_ != nullptr)
+                                 ? st.longest_waiter_name_
+                                 : "-";
+
+        trace::printf ("\t%s: %lu locks, %lu waits, wait max %lu, "
+                       "avg %lu by %s@%p, hold max %lu, avg %lu\n",
+                       mx.name (),
+                       static_cast<unsigned long> (st.acquisitions_),
+                       static_cast<unsigned long> (st.contentions_),
+                       static_cast<unsigned long> (st.wait_cycles_max_),
+                       static_cast<unsigned long> (
+                           st.wait_cycles_total_
+                           / (st.contentions_ ? st.contentions_ : 1)),
+                       waiter, st.longest_waiter_,
+                       static_cast<unsigned long> (st.hold_cycles_max_),
+                       static_cast<unsigned long> (
+                           st.hold_cycles_total_
+                           / (st.acquisitions_ ? st.acquisitions_ : 1)));
+      });
+      // ----- Exit critical section ------------------------------------------
+#endif // defined(TRACE)
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    // Called from a scheduler critical section.
+    void
+    mutex::statistics::internal_record_acquisition_ (void)
+    {
+      acquisitions_++;
+      hold_timestamp_ = hrclock.now ();
+    }
+
+    // Called from a scheduler critical section.
+    void
+    mutex::statistics::internal_record_release_ (void)
+    {
+      rtos::statistics::duration_t cycles = hrclock.now () - hold_timestamp_;
+
+      hold_cycles_total_ += cycles;
+      if (cycles > hold_cycles_max_)
+        {
+          hold_cycles_max_ = cycles;
+        }
+    }
+
+    // Called from a scheduler critical section.
+    void
+    mutex::statistics::internal_record_wait_ (
+        thread& th, rtos::statistics::duration_t timestamp)
+    {
+      rtos::statistics::duration_t cycles = hrclock.now () - timestamp;
+
+      wait_cycles_total_ += cycles;
+      if (cycles > wait_cycles_max_)
+        {
+          wait_cycles_max_ = cycles;
+
+          // Copy the name, the thread may be destroyed before
+          // the statistics are printed.
+          longest_waiter_ = &th;
+          const char* name = th.name ();
+          std::size_t i = 0;
+          for (; i < sizeof (longest_waiter_name_) - 1 && name[i] != '\0';
+               ++i)
+            {
+              longest_waiter_name_[i] = name[i];
+            }
+          longest_waiter_name_[i] = '\0';
+        }
+    }
+
+    /**
+     * @endcond
+     */
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+
     // ==========================================================================
 
     /**
@@ -0,0 +1,467 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
+#include <micro-os-plus/rtos.h>
+
+#include <micro-os-plus/diag/trace.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    // ========================================================================
+
+    /**
+     * @cond ignore
+     */
+
+    namespace
+    {
+      // One list per object type, in construction order.
+      object_registry::objects_list lists_[object_registry::kinds];
+
+      std::size_t size_ = 0;
+      uint32_t changes_ = 0;
+
+#if defined(TRACE)
+      constexpr std::size_t print_page = 8;
+
+      object_registry::entry print_buffer[print_page];
+#endif // defined(TRACE)
+
+#if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_MUTEX) \
+    || !defined(MICRO_OS_PLUS_USE_RTOS_PORT_CONDITION_VARIABLE) \
+    || !defined(MICRO_OS_PLUS_USE_RTOS_PORT_SEMAPHORE) \
+    || !defined(MICRO_OS_PLUS_USE_RTOS_PORT_EVENT_FLAGS) \
+    || !defined(MICRO_OS_PLUS_USE_RTOS_PORT_MESSAGE_QUEUE) \
+    || !defined(MICRO_OS_PLUS_USE_RTOS_PORT_MEMORY_POOL)
+
+      uint16_t
+      waiters (const internal::waiting_threads_list& list)
+      {
+        std::size_t n = 0;
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Waggregate-return"
+
+        for (auto it = list.begin (); it != list.end (); ++it)
+          {
+            ++n;
+          }
+
+#pragma GCC diagnostic pop
+
+        return static_cast<uint16_t> (n);
+      }
+
+#endif
+    } // namespace
+
+    /**
+     * @endcond
+     */
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @class object_registry
+     * @details
+     * The registry keeps one intrusive list per object type; objects
+     * are appended when constructed and removed when destroyed,
+     * both under a scheduler critical section.
+     *
+     * Statically allocated objects are registered by their constructors,
+     * before `main()`; the lists are static, so they are already
+     * initialised at that moment.
+     */
+
+    /**
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    std::size_t
+    object_registry::size (void)
+    {
+      return size_;
+    }
+
+    /**
+     * @details
+     * Tools enumerating the registry in pages can compare the
+     * counter before and after the walk, and restart it if
+     * objects were created or destroyed in between.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    uint32_t
+    object_registry::changes (void)
+    {
+      return changes_;
+    }
+
+    /**
+     * @details
+     * The registry is walked with the scheduler locked, so the
+     * lists cannot change and no thread can run during the walk.
+     * The state of each object is copied with the interrupts disabled,
+     * but only for that object, so the interrupt latency does
+     * not depend on the number of registered objects.
+     *
+     * The objects are enumerated by type, in the order defined by
+     * `object_registry::kind`, then in the order of construction.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    std::size_t
+    object_registry::snapshot (entry* entries, std::size_t count,
+                               std::size_t first)
+    {
+      assert (entries != nullptr || count == 0);
+
+      std::size_t n = 0;
+      std::size_t skipped = 0;
+
+      // ----- Enter critical section -----------------------------------------
+      scheduler::critical_section scs;
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Waggregate-return"
+
+      for (std::size_t k = 0; k < kinds && n < count; ++k)
+        {
+          for (auto&& object : lists_[k])
+            {
+              if (skipped < first)
+                {
+                  ++skipped;
+                  continue;
+                }
+              if (n >= count)
+                {
+                  break;
+                }
+
+              internal_capture_ (object, static_cast<kind> (k), entries[n]);
+              ++n;
+            }
+        }
+
+#pragma GCC diagnostic pop
+
+      return n;
+      // ----- Exit critical section ------------------------------------------
+    }
+
+    /**
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    const char*
+    object_registry::kind_name (kind type)
+    {
+      static const char* const names[kinds]
+          = { "thread",      "mutex",         "condvar",     "semaphore",
+              "event_flags", "message_queue", "memory_pool", "timer" };
+
+      std::size_t k = static_cast<std::size_t> (type);
+      return (k < kinds) ? names[k] : "?";
+    }
+
+    /**
+     * @details
+     * The registry is printed in pages, each captured by a separate
+     * call to `snapshot()`.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    void
+    object_registry::trace_print (void)
+    {
+#if defined(TRACE)
+      trace::printf ("Objects: %u, changes %u\n",
+                     static_cast<unsigned int> (size ()),
+                     static_cast<unsigned int> (changes ()));
+
+      std::size_t first = 0;
+      std::size_t n;
+      while ((n = snapshot (print_buffer, print_page, first)) > 0)
+        {
+          for (std::size_t i = 0; i < n; ++i)
+            {
+              const entry& e = print_buffer[i];
+              trace::printf ("\t%-13s %s @%p: state %u, prio %u, "
+                             "waiters %u, %lu/%lu, %lu events, "
+                             "%lu cycles\n",
+                             kind_name (e.type), e.name, e.object,
+                             static_cast<unsigned int> (e.state),
+                             static_cast<unsigned int> (e.priority),
+                             static_cast<unsigned int> (e.waiters),
+                             static_cast<unsigned long> (e.count),
+                             static_cast<unsigned long> (e.capacity),
+                             static_cast<unsigned long> (e.events),
+                             static_cast<unsigned long> (e.cycles));
+            }
+          first += n;
+        }
+#endif // defined(TRACE)
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    object_registry::objects_list&
+    object_registry::internal_list_ (kind type)
+    {
+      return lists_[static_cast<std::size_t> (type)];
+    }
+
+    void
+    object_registry::internal_link_ (internal::object_named_system& object,
+                                     kind type)
+    {
+      assert (static_cast<std::size_t> (type) < kinds);
+
+      // ----- Enter critical section -----------------------------------------
+      scheduler::critical_section scs;
+
+      lists_[static_cast<std::size_t> (type)].link (object);
+      ++size_;
+      ++changes_;
+      // ----- Exit critical section ------------------------------------------
+    }
+
+    void
+    object_registry::internal_unlink_ (internal::object_named_system& object)
+    {
+      // ----- Enter critical section -----------------------------------------
+      scheduler::critical_section scs;
+
+      // Objects created by constructors that do not register them
+      // (like the default thread constructors) are not linked.
+      if (object.registry_links_.linked ())
+        {
+          object.registry_links_.unlink ();
+          --size_;
+          ++changes_;
+        }
+      // ----- Exit critical section ------------------------------------------
+    }
+
+    void
+    object_registry::internal_capture_ (internal::object_named_system& object,
+                                        kind type, entry& e)
+    {
+      e.object = &object;
+      e.name = object.name ();
+      e.owner = nullptr;
+      e.type = type;
+      e.state = 0;
+      e.priority = 0;
+      e.waiters = 0;
+      e.count = 0;
+      e.capacity = 0;
+      e.events = 0;
+      e.cycles = 0;
+
+      switch (type)
+        {
+        case kind::thread:
+          {
+            thread& th = static_cast<thread&> (object);
+
+            // The binary search in the stack may take a while,
+            // and the stack contents are not protected by the
+            // critical section anyway.
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+            std::size_t available = th.stack ().available_cached ();
+#else
+            std::size_t available = th.stack ().available_estimate ();
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            e.state = th.state ();
+            e.priority = th.priority ();
+            e.count = static_cast<uint32_t> (available);
+            e.capacity = static_cast<uint32_t> (th.stack ().size ());
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
+            e.events = th.statistics ().context_switches ();
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CONTEXT_SWITCHES)
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+            e.cycles = th.statistics ().cpu_cycles ();
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_CPU_CYCLES)
+            // ----- Exit critical section ----------------------------------
+          }
+          break;
+
+        case kind::mutex:
+          {
+            mutex& mx = static_cast<mutex&> (object);
+
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            e.owner = mx.owner ();
+            e.count = static_cast<uint32_t> (mx.count_);
+            e.capacity = static_cast<uint32_t> (mx.max_count_);
+#if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_MUTEX)
+            e.waiters = waiters (mx.list_);
+#endif
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+            e.events = mx.statistics ().contentions ();
+            e.cycles = mx.statistics ().wait_cycles_total ();
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MUTEX)
+            // ----- Exit critical section ----------------------------------
+          }
+          break;
+
+        case kind::condition_variable:
+          {
+#if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_CONDITION_VARIABLE)
+            condition_variable& cv = static_cast<condition_variable&> (object);
+
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            e.waiters = waiters (cv.list_);
+            // ----- Exit critical section ----------------------------------
+#endif
+          }
+          break;
+
+        case kind::semaphore:
+          {
+            semaphore& sem = static_cast<semaphore&> (object);
+
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            e.count = static_cast<uint32_t> (sem.value ());
+            e.capacity = static_cast<uint32_t> (sem.max_value ());
+#if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_SEMAPHORE)
+            e.waiters = waiters (sem.list_);
+#endif
+            // ----- Exit critical section ----------------------------------
+          }
+          break;
+
+        case kind::event_flags:
+          {
+#if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_EVENT_FLAGS)
+            event_flags& ev = static_cast<event_flags&> (object);
+
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            e.count = ev.event_flags_.mask ();
+            e.waiters = waiters (ev.list_);
+            // ----- Exit critical section ----------------------------------
+#endif
+          }
+          break;
+
+        case kind::message_queue:
+          {
+            message_queue& mq = static_cast<message_queue&> (object);
+
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            e.count = static_cast<uint32_t> (mq.length ());
+            e.capacity = static_cast<uint32_t> (mq.capacity ());
+#if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_MESSAGE_QUEUE)
+            e.waiters = static_cast<uint16_t> (waiters (mq.send_list_)
+                                               + waiters (mq.receive_list_));
+#endif
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+            e.events = mq.statistics ().sends ();
+            e.cycles = mq.statistics ().full_cycles ();
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MESSAGE_QUEUE)
+            // ----- Exit critical section ----------------------------------
+          }
+          break;
+
+        case kind::memory_pool:
+          {
+            memory_pool& mp = static_cast<memory_pool&> (object);
+
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            e.count = static_cast<uint32_t> (mp.count ());
+            e.capacity = static_cast<uint32_t> (mp.capacity ());
+#if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_MEMORY_POOL)
+            e.waiters = waiters (mp.list_);
+#endif
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+            e.events = mp.statistics ().allocations ();
+            e.cycles = mp.statistics ().full_cycles ();
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_MEMORY_POOL)
+            // ----- Exit critical section ----------------------------------
+          }
+          break;
+
+        case kind::timer:
+          {
+            timer& tm = static_cast<timer&> (object);
+
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            e.state = tm.state_;
+#if !defined(MICRO_OS_PLUS_USE_RTOS_PORT_TIMER)
+            e.count = static_cast<uint32_t> (tm.period_);
+#endif
+            // ----- Exit critical section ----------------------------------
+          }
+          break;
+        }
+    }
+
+    /**
+     * @endcond
+     */
+
+    // ------------------------------------------------------------------------
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
+// ----------------------------------------------------------------------------
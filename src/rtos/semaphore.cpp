@@ -211,6 +211,11 @@ namespace micro_os_plus
       internal_init_ ();
 
 #endif
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      object_registry::internal_link_ (*this,
+                                       object_registry::kind::semaphore);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
     }
 
     /**
@@ -244,6 +249,10 @@ namespace micro_os_plus
       trace::printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      object_registry::internal_unlink_ (*this);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
 #if defined(MICRO_OS_PLUS_USE_RTOS_PORT_SEMAPHORE)
 
       port::semaphore::destroy (this);
@@ -489,7 +498,8 @@ namespace micro_os_plus
               }
 
             // Add this thread to the semaphore waiting list.
-            scheduler::internal_link_node (list_, node);
+            scheduler::internal_link_node (
+                list_, node, rtos::statistics::wait_reason::semaphore, this);
             // state::suspended set in above link().
             // ----- Exit critical section ----------------------------------
           }
@@ -678,8 +688,9 @@ namespace micro_os_plus
 
             // Add this thread to the semaphore waiting list,
             // and the clock timeout list.
-            scheduler::internal_link_node (list_, node, clock_list,
-                                           timeout_node);
+            scheduler::internal_link_node (
+                list_, node, clock_list, timeout_node,
+                rtos::statistics::wait_reason::semaphore, this);
             // state::suspended set in above link().
             // ----- Exit critical section ----------------------------------
           }
@@ -0,0 +1,1378 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <micro-os-plus/rtos.h>
+
+#include <cstring>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    // ------------------------------------------------------------------------
+
+    /**
+     * @class stream_buffer::attributes
+     * @details
+     * Allow to assign a name and custom attributes (like a static
+     * address) to the stream buffer.
+     *
+     * To simplify access, the member variables are public and do not
+     * require accessors or mutators.
+     */
+
+    /**
+     * @var void* stream_buffer::attributes::arena_address
+     * @details
+     * Set this variable to a user defined memory area large enough
+     * to store the stream buffer. Usually this is a statically
+     * allocated array.
+     *
+     * The default value is `nullptr`, which means there is no
+     * user defined storage.
+     */
+
+    /**
+     * @var std::size_t stream_buffer::attributes::arena_size_bytes
+     * @details
+     * The storage size must be large enough to accommodate the
+     * requested buffer size.
+     *
+     * If the @ref arena_address is `nullptr`, this variable is
+     * not checked, but it is recommended to leave it zero.
+     */
+
+    /**
+     * @var std::size_t stream_buffer::attributes::trigger_level_bytes
+     * @details
+     * The number of bytes, including the record headers, that must be
+     * present in the buffer before a blocked reader is resumed.
+     * Larger values allow readers to process records in batches,
+     * with fewer context switches.
+     *
+     * The default value is 1, which means readers are resumed
+     * as soon as a record is available.
+     */
+
+    /**
+     * @details
+     * This variable is used by the default constructor.
+     */
+    const stream_buffer::attributes stream_buffer::initializer;
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @class stream_buffer
+     * @details
+     * Stream buffers allow threads and interrupt handlers to exchange
+     * variable length records. Each record is stored in a ring of bytes,
+     * prefixed by its length, so, unlike message queues, which
+     * reserve the maximum message size for each message, only the
+     * actual record size plus a small header is used.
+     *
+     * Records are delivered in the order they were sent.
+     *
+     * Blocked readers are resumed only when the number of bytes in
+     * the buffer reaches the trigger level, or when a sender is
+     * blocked because its record does not fit; the non-blocking calls
+     * ignore the trigger level and return any available record.
+     *
+     * For zero-copy access, a reader can `acquire()` the oldest record,
+     * process it directly from the buffer via the two returned spans
+     * (the second one is used only when the record wraps around the
+     * end of the ring), and `release()` it when done. Only one record
+     * can be acquired at a time.
+     *
+     * The storage for the buffer is allocated dynamically,
+     * using the
+     * RTOS specific allocator (`micro_os_plus::memory::allocator`).
+     *
+     * For special cases, the storage can be allocated outside the
+     * class and specified via the `arena_address` and
+     * `arena_size_bytes` attributes.
+     *
+     * @par Example
+     *
+     * @code{.cpp}
+     * // The buffer storage is allocated statically inside this instance.
+     * stream_buffer_inclusive<256> sb;
+     *
+     * void
+     * uart_rx_isr(void)
+     * {
+     *   // Push the received frame, if there is enough space.
+     *   sb.try_send(frame, frame_length);
+     * }
+     *
+     * void
+     * consumer(void)
+     * {
+     *   uint8_t frame[64];
+     *   std::size_t length;
+     *   for (; some_condition();)
+     *     {
+     *       sb.receive(frame, sizeof(frame), &length);
+     *       // Process frame
+     *     }
+     * }
+     * @endcode
+     *
+     * @par POSIX compatibility
+     *  No POSIX similar functionality identified.
+     */
+
+    /**
+     * @class stream_buffer_inclusive
+     * @details
+     * If the buffer size is known at compile time and the buffer is used
+     * for the entire application life cycle, it might be preferred to
+     * allocate the storage statically inside the buffer instance.
+     */
+
+    // ------------------------------------------------------------------------
+    /**
+     * @cond ignore
+     */
+
+    // Protected internal constructor.
+    stream_buffer::stream_buffer ()
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+#endif
+    }
+
+    stream_buffer::stream_buffer (const char* name)
+        : object_named_system{ name }
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+#endif
+    }
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @details
+     * This constructor shall initialise a stream buffer object
+     * with attributes referenced by _attr_.
+     * If the attributes specified by _attr_ are modified later,
+     * the stream buffer attributes shall not be affected.
+     *
+     * If the attributes define a storage area (via
+     * `arena_address` and `arena_size_bytes`), that
+     * storage is used, otherwise the storage is dynamically allocated using
+     * the RTOS specific allocator
+     * (`rtos::memory::allocator`).
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    stream_buffer::stream_buffer (std::size_t size_bytes,
+                                  const attributes& _attributes,
+                                  const allocator_type& allocator)
+        : stream_buffer{ nullptr, size_bytes, _attributes, allocator }
+    {
+      ;
+    }
+
+    /**
+     * @details
+     * This constructor shall initialise a named stream buffer object
+     * with attributes referenced by _attr_.
+     * If the attributes specified by _attr_ are modified later,
+     * the stream buffer attributes shall not be affected.
+     *
+     * If the attributes define a storage area (via
+     * `arena_address` and `arena_size_bytes`), that
+     * storage is used, otherwise the storage is dynamically allocated using
+     * the RTOS specific allocator
+     * (`rtos::memory::allocator`).
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    stream_buffer::stream_buffer (const char* name, std::size_t size_bytes,
+                                  const attributes& _attributes,
+                                  const allocator_type& allocator)
+        : object_named_system{ name }
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s() @%p %s %u\n", __func__, this, this->name (),
+                     size_bytes);
+#endif
+
+      if (_attributes.arena_address != nullptr)
+        {
+          // Do not use any allocator at all.
+          internal_construct_ (size_bytes, _attributes, nullptr, 0);
+        }
+      else
+        {
+          allocator_ = &allocator;
+
+          // If no user storage was provided via attributes,
+          // allocate it dynamically via the allocator.
+          allocated_arena_size_elements_
+              = (compute_allocated_size_bytes<
+                     typename allocator_type::value_type> (size_bytes)
+                 + sizeof (typename allocator_type::value_type) - 1)
+                / sizeof (typename allocator_type::value_type);
+
+          allocated_arena_address_
+              = const_cast<allocator_type&> (allocator).allocate (
+                  allocated_arena_size_elements_);
+
+          internal_construct_ (
+              size_bytes, _attributes, allocated_arena_address_,
+              allocated_arena_size_elements_
+                  * sizeof (typename allocator_type::value_type));
+        }
+    }
+
+    /**
+     * @details
+     * It shall be safe to destroy an initialised stream buffer object
+     * upon which no threads are currently blocked. Attempting to
+     * destroy a stream buffer object upon which other threads are
+     * currently blocked results in undefined behaviour.
+     *
+     * If the storage for the stream buffer was dynamically allocated,
+     * it is deallocated using the same allocator.
+     */
+    stream_buffer::~stream_buffer ()
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // There must be no threads waiting for this buffer.
+      assert (send_list_.empty ());
+      assert (receive_list_.empty ());
+
+      if (allocated_arena_address_ != nullptr)
+        {
+          typedef
+              typename std::allocator_traits<allocator_type>::pointer pointer;
+
+          static_cast<allocator_type*> (const_cast<void*> (allocator_))
+              ->deallocate (
+                  reinterpret_cast<pointer> (allocated_arena_address_),
+                  allocated_arena_size_elements_);
+        }
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    void
+    stream_buffer::internal_construct_ (std::size_t size_bytes,
+                                        const attributes& _attributes,
+                                        void* arena_address,
+                                        std::size_t arena_size_bytes)
+    {
+      // Don't call this from interrupt handlers.
+      micro_os_plus_assert_throw (!interrupts::in_handler_mode (), EPERM);
+
+      clock_ = _attributes.clock != nullptr ? _attributes.clock : &sysclock;
+
+      // The buffer must be able to store at least a one byte record.
+      micro_os_plus_assert_throw (size_bytes > record_header_size_bytes,
+                                  EINVAL);
+      size_bytes_ = size_bytes;
+
+      // If the storage is given explicitly, override attributes.
+      if (arena_address != nullptr)
+        {
+          // The attributes should not define any storage in this case.
+          assert (_attributes.arena_address == nullptr);
+
+          arena_address_ = arena_address;
+          arena_size_bytes_ = arena_size_bytes;
+        }
+      else
+        {
+          arena_address_ = _attributes.arena_address;
+          arena_size_bytes_ = _attributes.arena_size_bytes;
+        }
+
+      // The buffer storage must have a real address.
+      micro_os_plus_assert_throw (arena_address_ != nullptr, ENOMEM);
+
+      // The buffer must fit the storage.
+      micro_os_plus_assert_throw (arena_size_bytes_ >= size_bytes_, EINVAL);
+
+      trigger_level (_attributes.trigger_level_bytes);
+
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s() @%p %s %u %p %u %u\n", __func__, this, name (),
+                     size_bytes_, arena_address_, arena_size_bytes_,
+                     trigger_level_bytes_);
+#endif
+
+      internal_init_ ();
+    }
+
+    void
+    stream_buffer::internal_init_ (void)
+    {
+      head_ = 0;
+      tail_ = 0;
+      used_bytes_ = 0;
+      records_ = 0;
+      acquired_bytes_ = 0;
+
+      // Need not be inside the critical section,
+      // the lists are protected by inner `resume_one()`.
+
+      // Wake-up all threads, if any.
+      send_list_.resume_all ();
+      receive_list_.resume_all ();
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    std::size_t
+    stream_buffer::internal_copy_in_ (std::size_t offset, const void* src,
+                                      std::size_t nbytes)
+    {
+      char* arena = static_cast<char*> (arena_address_);
+      std::size_t first = size_bytes_ - offset;
+
+      if (nbytes < first)
+        {
+          std::memcpy (arena + offset, src, nbytes);
+          return offset + nbytes;
+        }
+
+      // The bytes wrap around the end of the ring.
+      std::memcpy (arena + offset, src, first);
+      std::memcpy (arena, static_cast<const char*> (src) + first,
+                   nbytes - first);
+      return nbytes - first;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    std::size_t
+    stream_buffer::internal_copy_out_ (std::size_t offset, void* dest,
+                                       std::size_t nbytes) const
+    {
+      const char* arena = static_cast<const char*> (arena_address_);
+      std::size_t first = size_bytes_ - offset;
+
+      if (nbytes < first)
+        {
+          std::memcpy (dest, arena + offset, nbytes);
+          return offset + nbytes;
+        }
+
+      // The bytes wrap around the end of the ring.
+      std::memcpy (dest, arena + offset, first);
+      std::memcpy (static_cast<char*> (dest) + first, arena, nbytes - first);
+      return nbytes - first;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    bool
+    stream_buffer::internal_try_send_ (const void* record, std::size_t nbytes)
+    {
+      std::size_t total_bytes = record_header_size_bytes + nbytes;
+      if ((size_bytes_ - used_bytes_) < total_bytes)
+        {
+          // No available space to send the record.
+          return false;
+        }
+
+      // The record is copied while in the critical section; the
+      // buffer is intended for short records, like protocol frames.
+      record_size_t header = static_cast<record_size_t> (nbytes);
+      tail_ = internal_copy_in_ (tail_, &header, sizeof (header));
+      tail_ = internal_copy_in_ (tail_, record, nbytes);
+
+      used_bytes_ = used_bytes_ + total_bytes; // Volatile increment.
+      records_ = records_ + 1; // Volatile increment.
+
+      if (internal_is_triggered_ ())
+        {
+          // Wake-up one thread, if any.
+          receive_list_.resume_one ();
+        }
+
+      return true;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    bool
+    stream_buffer::internal_is_triggered_ (void) const
+    {
+      // The acquired record blocks the head of the ring.
+      // A blocked sender needs space, which only readers can free,
+      // so the trigger level must not be waited for; otherwise
+      // a record which does not fit below the level would block
+      // both sides forever.
+      return (records_ > 0) && (acquired_bytes_ == 0)
+             && ((used_bytes_ >= trigger_level_bytes_)
+                 || !send_list_.empty ());
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    std::size_t
+    stream_buffer::internal_head_record_size_ (void) const
+    {
+      record_size_t header;
+      internal_copy_out_ (head_, &header, sizeof (header));
+
+      return header;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section,
+     * with at least one record in the buffer.
+     */
+    result_t
+    stream_buffer::internal_receive_ (void* record, std::size_t nbytes,
+                                      std::size_t* record_size_bytes)
+    {
+      std::size_t length = internal_head_record_size_ ();
+      if (nbytes < length)
+        {
+          // Leave the record in the buffer.
+          return EMSGSIZE;
+        }
+
+      std::size_t offset = head_ + record_header_size_bytes;
+      if (offset >= size_bytes_)
+        {
+          offset -= size_bytes_;
+        }
+      head_ = internal_copy_out_ (offset, record, length);
+
+      used_bytes_
+          = used_bytes_ - (record_header_size_bytes + length); // Volatile.
+      records_ = records_ - 1; // Volatile decrement.
+
+      if (record_size_bytes != nullptr)
+        {
+          *record_size_bytes = length;
+        }
+
+      // Records have variable sizes, so the freed space might
+      // be enough for several senders; let all of them retry.
+      send_list_.resume_all ();
+
+      return result::ok;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section,
+     * with at least one record in the buffer.
+     */
+    void
+    stream_buffer::internal_acquire_ (spans& record_spans)
+    {
+      std::size_t length = internal_head_record_size_ ();
+
+      std::size_t offset = head_ + record_header_size_bytes;
+      if (offset >= size_bytes_)
+        {
+          offset -= size_bytes_;
+        }
+
+      char* arena = static_cast<char*> (arena_address_);
+
+      record_spans.first_address = arena + offset;
+      if (length <= size_bytes_ - offset)
+        {
+          record_spans.first_size_bytes = length;
+          record_spans.second_address = nullptr;
+          record_spans.second_size_bytes = 0;
+        }
+      else
+        {
+          record_spans.first_size_bytes = size_bytes_ - offset;
+          record_spans.second_address = arena;
+          record_spans.second_size_bytes
+              = length - record_spans.first_size_bytes;
+        }
+
+      acquired_bytes_ = record_header_size_bytes + length;
+    }
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @details
+     * The `send()` function shall add the record pointed to by
+     * _record_ to the end of the buffer.
+     *
+     * If there is not enough free space in the buffer, `send()`
+     * shall block until space becomes available, or until
+     * `send()` is cancelled/interrupted.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    stream_buffer::send (const void* record, std::size_t nbytes)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s(%p,%u) @%p %s\n", __func__, record, nbytes, this,
+                     name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      micro_os_plus_assert_err (!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      micro_os_plus_assert_err (!scheduler::locked (), EPERM);
+
+      micro_os_plus_assert_err (record != nullptr, EINVAL);
+      micro_os_plus_assert_err (nbytes <= max_record_size, EMSGSIZE);
+      micro_os_plus_assert_err (
+          record_header_size_bytes + nbytes <= size_bytes_, EMSGSIZE);
+
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        if (internal_try_send_ (record, nbytes))
+          {
+            return result::ok;
+          }
+        // ----- Exit critical section --------------------------------------
+      }
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node{ crt_thread };
+
+      for (;;)
+        {
+          {
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            if (internal_try_send_ (record, nbytes))
+              {
+                return result::ok;
+              }
+
+            // Add this thread to the stream buffer send waiting list.
+            scheduler::internal_link_node (
+                send_list_, node, rtos::statistics::wait_reason::queue_send,
+                this);
+            // state::suspended set in above link().
+
+            // The reader may wait for a level this record cannot reach.
+            if (internal_is_triggered_ ())
+              {
+                receive_list_.resume_one ();
+              }
+            // ----- Exit critical section ----------------------------------
+          }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the send waiting list,
+          // if not already removed by receive().
+          scheduler::internal_unlink_node (node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+              trace::printf ("%s(%p,%u) EINTR @%p %s\n", __func__, record,
+                             nbytes, this, name ());
+#endif
+              return EINTR;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * The `try_send()` function shall try to add the record pointed to by
+     * _record_ to the end of the buffer.
+     *
+     * If there is not enough free space in the buffer, the record shall
+     * not be added and `try_send()` shall return an error.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    stream_buffer::try_send (const void* record, std::size_t nbytes)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s(%p,%u) @%p %s\n", __func__, record, nbytes, this,
+                     name ());
+#endif
+
+      micro_os_plus_assert_err (record != nullptr, EINVAL);
+      micro_os_plus_assert_err (nbytes <= max_record_size, EMSGSIZE);
+      micro_os_plus_assert_err (
+          record_header_size_bytes + nbytes <= size_bytes_, EMSGSIZE);
+
+      // Don't call this from high priority interrupts.
+      assert (port::interrupts::is_priority_valid ());
+
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        if (internal_try_send_ (record, nbytes))
+          {
+            return result::ok;
+          }
+        else
+          {
+            return EWOULDBLOCK;
+          }
+        // ----- Exit critical section --------------------------------------
+      }
+    }
+
+    /**
+     * @details
+     * The `timed_send()` function shall add the record pointed to by
+     * _record_ to the end of the buffer.
+     *
+     * If there is not enough free space in the buffer, the wait for
+     * space shall be terminated when the specified timeout expires.
+     *
+     * Under no circumstance shall the operation fail with a timeout
+     * if there is sufficient room in the buffer to add the record
+     * immediately.
+     *
+     * The clock used for timeouts can be specified via the `clock`
+     * attribute. By default, the clock derived from the scheduler
+     * timer is used, and the durations are expressed in ticks.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    stream_buffer::timed_send (const void* record, std::size_t nbytes,
+                               clock::duration_t timeout)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s(%p,%u,%u) @%p %s\n", __func__, record, nbytes,
+                     timeout, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      micro_os_plus_assert_err (!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      micro_os_plus_assert_err (!scheduler::locked (), EPERM);
+
+      micro_os_plus_assert_err (record != nullptr, EINVAL);
+      micro_os_plus_assert_err (nbytes <= max_record_size, EMSGSIZE);
+      micro_os_plus_assert_err (
+          record_header_size_bytes + nbytes <= size_bytes_, EMSGSIZE);
+
+      // Extra test before entering the loop, with its inherent weight.
+      // Trade size for speed.
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        if (internal_try_send_ (record, nbytes))
+          {
+            return result::ok;
+          }
+        // ----- Exit critical section --------------------------------------
+      }
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node{ crt_thread };
+
+      internal::clock_timestamps_list& clock_list = clock_->steady_list ();
+      clock::timestamp_t timeout_timestamp = clock_->steady_now () + timeout;
+
+      // Prepare a timeout node pointing to the current thread.
+      internal::timeout_thread_node timeout_node{ timeout_timestamp,
+                                                  crt_thread };
+
+      for (;;)
+        {
+          {
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            if (internal_try_send_ (record, nbytes))
+              {
+                return result::ok;
+              }
+
+            // Add this thread to the stream buffer send waiting list,
+            // and the clock timeout list.
+            scheduler::internal_link_node (
+                send_list_, node, clock_list, timeout_node,
+                rtos::statistics::wait_reason::queue_send, this);
+            // state::suspended set in above link().
+
+            // The reader may wait for a level this record cannot reach.
+            if (internal_is_triggered_ ())
+              {
+                receive_list_.resume_one ();
+              }
+            // ----- Exit critical section ----------------------------------
+          }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the send waiting list,
+          // if not already removed by receive() and from the clock timeout
+          // list, if not already removed by the timer.
+          scheduler::internal_unlink_node (node, timeout_node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+              trace::printf ("%s(%p,%u,%u) EINTR @%p %s\n", __func__, record,
+                             nbytes, timeout, this, name ());
+#endif
+              return EINTR;
+            }
+
+          if (clock_->steady_now () >= timeout_timestamp)
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+              trace::printf ("%s(%p,%u,%u) ETIMEDOUT @%p %s\n", __func__,
+                             record, nbytes, timeout, this, name ());
+#endif
+              return ETIMEDOUT;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * The `receive()` function shall remove the oldest record from
+     * the buffer and copy it to the location pointed to by _record_.
+     * If the destination is smaller than the record, the function
+     * shall fail and the record is left in the buffer.
+     *
+     * If the buffer is empty, or the number of buffered bytes did not
+     * yet reach the trigger level, `receive()` shall block
+     * until enough records are sent or until
+     * `receive()` is cancelled/interrupted.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    stream_buffer::receive (void* record, std::size_t nbytes,
+                            std::size_t* record_size_bytes)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s(%p,%u) @%p %s\n", __func__, record, nbytes, this,
+                     name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      micro_os_plus_assert_err (!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      micro_os_plus_assert_err (!scheduler::locked (), EPERM);
+
+      micro_os_plus_assert_err (record != nullptr, EINVAL);
+
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        if (internal_is_triggered_ ())
+          {
+            return internal_receive_ (record, nbytes, record_size_bytes);
+          }
+        // ----- Exit critical section --------------------------------------
+      }
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node{ crt_thread };
+
+      for (;;)
+        {
+          {
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            if (internal_is_triggered_ ())
+              {
+                return internal_receive_ (record, nbytes, record_size_bytes);
+              }
+
+            // Add this thread to the stream buffer receive waiting list.
+            scheduler::internal_link_node (
+                receive_list_, node,
+                rtos::statistics::wait_reason::queue_receive, this);
+            // state::suspended set in above link().
+            // ----- Exit critical section ----------------------------------
+          }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the receive waiting list,
+          // if not already removed by send().
+          scheduler::internal_unlink_node (node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+              trace::printf ("%s(%p,%u) EINTR @%p %s\n", __func__, record,
+                             nbytes, this, name ());
+#endif
+              return EINTR;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * The `try_receive()` function shall try to remove the oldest
+     * record from the buffer and copy it to the location pointed
+     * to by _record_.
+     *
+     * The trigger level is ignored, any available record is returned;
+     * this allows a reader resumed by the trigger to drain the buffer.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    stream_buffer::try_receive (void* record, std::size_t nbytes,
+                                std::size_t* record_size_bytes)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s(%p,%u) @%p %s\n", __func__, record, nbytes, this,
+                     name ());
+#endif
+
+      micro_os_plus_assert_err (record != nullptr, EINVAL);
+
+      // Don't call this from high priority interrupts.
+      assert (port::interrupts::is_priority_valid ());
+
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        if (records_ == 0 || acquired_bytes_ != 0)
+          {
+            return EWOULDBLOCK;
+          }
+
+        return internal_receive_ (record, nbytes, record_size_bytes);
+        // ----- Exit critical section --------------------------------------
+      }
+    }
+
+    /**
+     * @details
+     * The `timed_receive()` function shall remove the oldest record from
+     * the buffer and copy it to the location pointed to by _record_.
+     *
+     * If the buffer is empty, or the number of buffered bytes did not
+     * yet reach the trigger level, the wait shall be terminated
+     * when the specified timeout expires.
+     *
+     * The clock used for timeouts can be specified via the `clock`
+     * attribute. By default, the clock derived from the scheduler
+     * timer is used, and the durations are expressed in ticks.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    stream_buffer::timed_receive (void* record, std::size_t nbytes,
+                                  clock::duration_t timeout,
+                                  std::size_t* record_size_bytes)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s(%p,%u,%u) @%p %s\n", __func__, record, nbytes,
+                     timeout, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      micro_os_plus_assert_err (!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      micro_os_plus_assert_err (!scheduler::locked (), EPERM);
+
+      micro_os_plus_assert_err (record != nullptr, EINVAL);
+
+      // Extra test before entering the loop, with its inherent weight.
+      // Trade size for speed.
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        if (internal_is_triggered_ ())
+          {
+            return internal_receive_ (record, nbytes, record_size_bytes);
+          }
+        // ----- Exit critical section --------------------------------------
+      }
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node{ crt_thread };
+
+      internal::clock_timestamps_list& clock_list = clock_->steady_list ();
+      clock::timestamp_t timeout_timestamp = clock_->steady_now () + timeout;
+
+      // Prepare a timeout node pointing to the current thread.
+      internal::timeout_thread_node timeout_node{ timeout_timestamp,
+                                                  crt_thread };
+
+      for (;;)
+        {
+          {
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            if (internal_is_triggered_ ())
+              {
+                return internal_receive_ (record, nbytes, record_size_bytes);
+              }
+
+            // Add this thread to the stream buffer receive waiting list,
+            // and the clock timeout list.
+            scheduler::internal_link_node (
+                receive_list_, node, clock_list, timeout_node,
+                rtos::statistics::wait_reason::queue_receive, this);
+            // state::suspended set in above link().
+            // ----- Exit critical section ----------------------------------
+          }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the receive waiting list,
+          // if not already removed by send() and from the clock timeout
+          // list, if not already removed by the timer.
+          scheduler::internal_unlink_node (node, timeout_node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+              trace::printf ("%s(%p,%u,%u) EINTR @%p %s\n", __func__, record,
+                             nbytes, timeout, this, name ());
+#endif
+              return EINTR;
+            }
+
+          if (clock_->steady_now () >= timeout_timestamp)
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+              trace::printf ("%s(%p,%u,%u) ETIMEDOUT @%p %s\n", __func__,
+                             record, nbytes, timeout, this, name ());
+#endif
+              return ETIMEDOUT;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * The `acquire()` function shall describe the oldest record
+     * via _record_spans_, without removing it from the buffer.
+     * The record must be removed later with `release()`.
+     *
+     * If the buffer is empty, or the number of buffered bytes did not
+     * yet reach the trigger level, `acquire()` shall block
+     * until enough records are sent or until
+     * `acquire()` is cancelled/interrupted.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    stream_buffer::acquire (spans& record_spans)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      micro_os_plus_assert_err (!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      micro_os_plus_assert_err (!scheduler::locked (), EPERM);
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node{ crt_thread };
+
+      for (;;)
+        {
+          {
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            if (acquired_bytes_ != 0)
+              {
+                return EBUSY;
+              }
+
+            if (internal_is_triggered_ ())
+              {
+                internal_acquire_ (record_spans);
+                return result::ok;
+              }
+
+            // Add this thread to the stream buffer receive waiting list.
+            scheduler::internal_link_node (
+                receive_list_, node,
+                rtos::statistics::wait_reason::queue_receive, this);
+            // state::suspended set in above link().
+            // ----- Exit critical section ----------------------------------
+          }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the receive waiting list,
+          // if not already removed by send().
+          scheduler::internal_unlink_node (node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+              trace::printf ("%s() EINTR @%p %s\n", __func__, this, name ());
+#endif
+              return EINTR;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * The `try_acquire()` function shall try to describe the oldest
+     * record via _record_spans_, without removing it from the buffer.
+     * The trigger level is ignored.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    stream_buffer::try_acquire (spans& record_spans)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // Don't call this from high priority interrupts.
+      assert (port::interrupts::is_priority_valid ());
+
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        if (acquired_bytes_ != 0)
+          {
+            return EBUSY;
+          }
+
+        if (records_ == 0)
+          {
+            return EWOULDBLOCK;
+          }
+
+        internal_acquire_ (record_spans);
+        return result::ok;
+        // ----- Exit critical section --------------------------------------
+      }
+    }
+
+    /**
+     * @details
+     * The `timed_acquire()` function shall describe the oldest record
+     * via _record_spans_, without removing it from the buffer.
+     *
+     * If the buffer is empty, or the number of buffered bytes did not
+     * yet reach the trigger level, the wait shall be terminated
+     * when the specified timeout expires.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    stream_buffer::timed_acquire (spans& record_spans,
+                                  clock::duration_t timeout)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s(%u) @%p %s\n", __func__, timeout, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      micro_os_plus_assert_err (!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      micro_os_plus_assert_err (!scheduler::locked (), EPERM);
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node{ crt_thread };
+
+      internal::clock_timestamps_list& clock_list = clock_->steady_list ();
+      clock::timestamp_t timeout_timestamp = clock_->steady_now () + timeout;
+
+      // Prepare a timeout node pointing to the current thread.
+      internal::timeout_thread_node timeout_node{ timeout_timestamp,
+                                                  crt_thread };
+
+      for (;;)
+        {
+          {
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            if (acquired_bytes_ != 0)
+              {
+                return EBUSY;
+              }
+
+            if (internal_is_triggered_ ())
+              {
+                internal_acquire_ (record_spans);
+                return result::ok;
+              }
+
+            // Add this thread to the stream buffer receive waiting list,
+            // and the clock timeout list.
+            scheduler::internal_link_node (
+                receive_list_, node, clock_list, timeout_node,
+                rtos::statistics::wait_reason::queue_receive, this);
+            // state::suspended set in above link().
+            // ----- Exit critical section ----------------------------------
+          }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the receive waiting list,
+          // if not already removed by send() and from the clock timeout
+          // list, if not already removed by the timer.
+          scheduler::internal_unlink_node (node, timeout_node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+              trace::printf ("%s(%u) EINTR @%p %s\n", __func__, timeout, this,
+                             name ());
+#endif
+              return EINTR;
+            }
+
+          if (clock_->steady_now () >= timeout_timestamp)
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+              trace::printf ("%s(%u) ETIMEDOUT @%p %s\n", __func__, timeout,
+                             this, name ());
+#endif
+              return ETIMEDOUT;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * Remove the record previously acquired with one of the
+     * `acquire()` functions from the buffer, and resume the
+     * threads waiting for free space.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    stream_buffer::release (void)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // Don't call this from high priority interrupts.
+      assert (port::interrupts::is_priority_valid ());
+
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        if (acquired_bytes_ == 0)
+          {
+            return EINVAL;
+          }
+
+        std::size_t offset = head_ + acquired_bytes_;
+        if (offset >= size_bytes_)
+          {
+            offset -= size_bytes_;
+          }
+        head_ = offset;
+
+        used_bytes_ = used_bytes_ - acquired_bytes_; // Volatile decrement.
+        records_ = records_ - 1; // Volatile decrement.
+        acquired_bytes_ = 0;
+
+        // Let all senders retry, the freed space might fit several records.
+        send_list_.resume_all ();
+
+        if (internal_is_triggered_ ())
+          {
+            // The head is no longer blocked; wake-up one reader, if any.
+            receive_list_.resume_one ();
+          }
+
+        return result::ok;
+        // ----- Exit critical section --------------------------------------
+      }
+    }
+
+    /**
+     * @details
+     * The trigger level is limited to the buffer capacity; a zero
+     * value is considered 1.
+     *
+     * Readers are also resumed below the trigger level when a
+     * sender blocks, since a level close to the capacity may
+     * never be reached with records which do not fit in the
+     * remaining space.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    std::size_t
+    stream_buffer::trigger_level (std::size_t level_bytes)
+    {
+      if (level_bytes == 0)
+        {
+          level_bytes = 1;
+        }
+      else if (level_bytes > size_bytes_)
+        {
+          level_bytes = size_bytes_;
+        }
+
+      // ----- Enter critical section -----------------------------------------
+      interrupts::critical_section ics;
+
+      std::size_t tmp = trigger_level_bytes_;
+      trigger_level_bytes_ = level_bytes;
+
+      if (internal_is_triggered_ ())
+        {
+          // A lower level may release a waiting reader.
+          receive_list_.resume_one ();
+        }
+
+      return tmp;
+      // ----- Exit critical section ------------------------------------------
+    }
+
+    /**
+     * @details
+     * Discard all records and return the buffer to the
+     * initial state.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    stream_buffer::reset (void)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_SBUFFER)
+      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      micro_os_plus_assert_err (!interrupts::in_handler_mode (), EPERM);
+
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        internal_init_ ();
+        return result::ok;
+        // ----- Exit critical section --------------------------------------
+      }
+    }
+
+    // ------------------------------------------------------------------------
+
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
@@ -32,6 +32,20 @@
 
 // ----------------------------------------------------------------------------
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE)
+
+#if !defined(MICRO_OS_PLUS_INTEGER_RTOS_THREAD_CACHE_STACKS)
+#define MICRO_OS_PLUS_INTEGER_RTOS_THREAD_CACHE_STACKS (4)
+#endif
+
+#if !defined(MICRO_OS_PLUS_INTEGER_RTOS_THREAD_CACHE_OBJECTS)
+#define MICRO_OS_PLUS_INTEGER_RTOS_THREAD_CACHE_OBJECTS (4)
+#endif
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE)
+
+// ----------------------------------------------------------------------------
+
 #pragma GCC diagnostic push
 
 #if defined(__clang__)
@@ -61,6 +75,95 @@ namespace micro_os_plus
     using mutexes_list = utils::intrusive_list<mutex, utils::double_list_links,
                                                &mutex::owner_links_>;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE)
+
+    /**
+     * @cond ignore
+     */
+
+    namespace
+    {
+      // A cached stack, with the memory resource it belongs to and
+      // the number of bottom bytes which were never used, thus still
+      // hold the magic.
+      struct cached_stack
+      {
+        memory::memory_resource* resource;
+        thread::stack::allocation_element_t* address;
+        std::size_t size_elements;
+        std::size_t intact_bytes;
+      };
+
+      cached_stack cached_stacks[MICRO_OS_PLUS_INTEGER_RTOS_THREAD_CACHE_STACKS];
+      std::size_t cached_stacks_count;
+
+      void* cached_objects[MICRO_OS_PLUS_INTEGER_RTOS_THREAD_CACHE_OBJECTS];
+      std::size_t cached_objects_count;
+
+      std::size_t cache_hits;
+      std::size_t cache_misses;
+
+      // Get a cached stack at least as large as requested, but not
+      // more than 25% larger, which belongs to the memory resource
+      // the allocator would use; the size is updated.
+      thread::stack::allocation_element_t*
+      cache_get_stack (std::size_t& size_elements, std::size_t& intact_bytes)
+      {
+        // ----- Enter critical section -------------------------------------
+        scheduler::critical_section scs;
+
+        memory::memory_resource* resource = memory::get_default_resource ();
+        for (std::size_t i = 0; i < cached_stacks_count; ++i)
+          {
+            cached_stack& cs = cached_stacks[i];
+            if (cs.resource == resource && cs.size_elements >= size_elements
+                && cs.size_elements <= size_elements + size_elements / 4)
+              {
+                thread::stack::allocation_element_t* address = cs.address;
+                size_elements = cs.size_elements;
+                intact_bytes = cs.intact_bytes;
+
+                cs = cached_stacks[--cached_stacks_count];
+                ++cache_hits;
+
+                return address;
+              }
+          }
+
+        ++cache_misses;
+        return nullptr;
+        // ----- Exit critical section --------------------------------------
+      }
+
+      bool
+      cache_put_stack (thread::stack::allocation_element_t* address,
+                       std::size_t size_elements, std::size_t intact_bytes)
+      {
+        // ----- Enter critical section -------------------------------------
+        scheduler::critical_section scs;
+
+        if (cached_stacks_count
+            >= MICRO_OS_PLUS_INTEGER_RTOS_THREAD_CACHE_STACKS)
+          {
+            return false;
+          }
+
+        // The stack allocator gets the memory from the default
+        // resource; remember it, since it may be changed later.
+        cached_stacks[cached_stacks_count++]
+            = { memory::get_default_resource (), address, size_elements,
+                intact_bytes };
+        return true;
+        // ----- Exit critical section --------------------------------------
+      }
+    } // namespace
+
+    /**
+     * @endcond
+     */
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE)
+
     // ========================================================================
     /**
      * @class thread::attributes
@@ -162,6 +265,18 @@ namespace micro_os_plus
 
     void
     thread::stack::initialize (void)
+    {
+      initialize (0);
+    }
+
+    /**
+     * @details
+     * Used when reusing a stack whose bottom part was never
+     * touched by the previous thread, to save the time to
+     * refill it.
+     */
+    void
+    thread::stack::initialize (std::size_t intact_bytes)
     {
       // Align the bottom of the stack.
       void* pa = bottom_address_;
@@ -175,7 +290,22 @@ namespace micro_os_plus
       element_t* p = bottom_address_;
       element_t* pend = top ();
 
-      // Initialise the entire stack with the magic word.
+      // Skip the part which still holds the magic word.
+      p += intact_bytes / sizeof (element_t);
+      if (p > pend)
+        {
+          p = pend;
+        }
+
+      // Initialise the rest of the stack with the magic word.
+      // Unrolled, to let the compiler use multiple register stores.
+      for (; p + 4 <= pend; p += 4)
+        {
+          p[0] = magic;
+          p[1] = magic;
+          p[2] = magic;
+          p[3] = magic;
+        }
       for (; p < pend; ++p)
         {
           *p = magic;
@@ -184,6 +314,11 @@ namespace micro_os_plus
       // Compute the actual size. The -1 is to leave space for the magic.
       size_bytes_ = ((static_cast<std::size_t> (p - bottom_address_) - 1)
                      * sizeof (element_t));
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+      scan_elements_ = 0;
+      available_bytes_ = size_bytes_;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
     }
 
     /**
@@ -202,16 +337,276 @@ namespace micro_os_plus
     thread::stack::available (void)
     {
       element_t* p = bottom_address_;
-      std::size_t count = 0;
-      while (*p == magic)
+      element_t* pend = top ();
+
+      // Check 4 elements at a time, with a single branch.
+      for (; p + 4 <= pend; p += 4)
+        {
+          if (((p[0] ^ magic) | (p[1] ^ magic) | (p[2] ^ magic)
+               | (p[3] ^ magic))
+              != 0)
+            {
+              break;
+            }
+        }
+      while (p < pend && *p == magic)
         {
-          count += sizeof (element_t);
           ++p;
         }
 
-      return count;
+      return static_cast<std::size_t> (p - bottom_address_)
+             * sizeof (element_t);
+    }
+
+    /**
+     * @details
+     * Binary search for the boundary between the bottom area still
+     * holding the magic word and the used area, in logarithmic time.
+     *
+     * The result is exact as long as the used area holds no
+     * words equal to the magic; a buffer on the stack which was
+     * never written may make the estimate larger than the actual
+     * available space. Use `available()` when the exact value
+     * is required.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    std::size_t
+    thread::stack::available_estimate (void)
+    {
+      std::size_t lo = 0;
+      std::size_t hi = size_bytes_ / sizeof (element_t);
+
+      // Invariant: elements below `lo` hold the magic,
+      // the element at `hi` (if any) was used.
+      while (lo < hi)
+        {
+          std::size_t mid = lo + (hi - lo) / 2;
+          if (bottom_address_[mid] == magic)
+            {
+              lo = mid + 1;
+            }
+          else
+            {
+              hi = mid;
+            }
+        }
+
+      return lo * sizeof (element_t);
+    }
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
+    /**
+     * @details
+     * Check at most `elements` stack elements, continuing from where
+     * the previous call stopped. When the first used element is
+     * found, the result is cached and the next call restarts
+     * from the bottom.
+     *
+     * Intended to be called periodically, from the idle thread,
+     * to spread the cost of `available()` over time;
+     * `available_cached()` returns the result.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    bool
+    thread::stack::scan (std::size_t elements)
+    {
+      std::size_t end = size_bytes_ / sizeof (element_t);
+      std::size_t i = scan_elements_;
+      std::size_t limit = (end - i > elements) ? i + elements : end;
+
+      while (i < limit && bottom_address_[i] == magic)
+        {
+          ++i;
+        }
+
+      if (i < limit || i == end)
+        {
+          available_bytes_ = i * sizeof (element_t);
+          scan_elements_ = 0;
+          return true;
+        }
+
+      scan_elements_ = i;
+      return false;
+    }
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+    /**
+     * @details
+     * The pending resume timestamp is preserved.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    void
+    thread::statistics::clear_wakeup_latency (void)
+    {
+      // ----- Enter critical section -----------------------------------------
+      interrupts::critical_section ics;
+
+      wakeups_ = 0;
+      wakeup_latency_total_ = 0;
+      wakeup_latency_min_ = 0;
+      wakeup_latency_max_ = 0;
+      for (std::size_t i = 0; i < wakeup_histogram_buckets; ++i)
+        {
+          wakeup_histogram_[i] = 0;
+        }
+      // ----- Exit critical section ------------------------------------------
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    /*
+     * Called by the scheduler when switching to the thread,
+     * with interrupts disabled.
+     */
+    void
+    thread::statistics::internal_record_wakeup_ (
+        rtos::statistics::duration_t now)
+    {
+      if (wakeup_timestamp_ == 0)
+        {
+          // Not resumed, only preempted.
+          return;
+        }
+
+      rtos::statistics::duration_t latency = now - wakeup_timestamp_;
+      wakeup_timestamp_ = 0;
+
+      if (wakeups_ == 0 || latency < wakeup_latency_min_)
+        {
+          wakeup_latency_min_ = latency;
+        }
+      if (latency > wakeup_latency_max_)
+        {
+          wakeup_latency_max_ = latency;
+        }
+      wakeup_latency_total_ += latency;
+      ++wakeups_;
+      ++wakeup_histogram_[wakeup_histogram_bucket (latency)];
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+      if (wakeup_edge_ != nullptr)
+        {
+          wakeup_graph::internal_record_ (
+              wakeup_edge_, scheduler::current_thread_, latency);
+          wakeup_edge_ = nullptr;
+        }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+    }
+
+    /**
+     * @endcond
+     */
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+
+    /**
+     * @details
+     * An ongoing wait is preserved, and accounted when it ends.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    void
+    thread::statistics::clear_waits (void)
+    {
+      // ----- Enter critical section -----------------------------------------
+      interrupts::critical_section ics;
+
+      for (std::size_t i = 0; i < rtos::statistics::wait_reasons; ++i)
+        {
+          waits_[i] = 0;
+          wait_cycles_[i] = 0;
+        }
+#if MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_THREAD_WAIT_OBJECTS > 0
+      for (std::size_t i = 0; i < wait_objects_size; ++i)
+        {
+          wait_objects_[i] = {};
+        }
+#endif
+      // ----- Exit critical section ------------------------------------------
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    /*
+     * Called when the thread is linked to a waiting list,
+     * with interrupts disabled.
+     */
+    void
+    thread::statistics::internal_wait_begin_ (
+        rtos::statistics::wait_reason reason, const void* object)
+    {
+      wait_timestamp_ = hrclock.now ();
+      wait_reason_ = reason;
+      wait_object_ = object;
+    }
+
+    /*
+     * Called when the thread is removed from the waiting list,
+     * with interrupts disabled.
+     */
+    void
+    thread::statistics::internal_wait_end_ (void)
+    {
+      if (wait_timestamp_ == 0)
+        {
+          // Not blocked.
+          return;
+        }
+
+      rtos::statistics::duration_t cycles = hrclock.now () - wait_timestamp_;
+      wait_timestamp_ = 0;
+
+      std::size_t r = static_cast<std::size_t> (wait_reason_);
+      ++waits_[r];
+      wait_cycles_[r] += cycles;
+
+#if MICRO_OS_PLUS_INTEGER_RTOS_STATISTICS_THREAD_WAIT_OBJECTS > 0
+      if (wait_object_ == nullptr)
+        {
+          return;
+        }
+
+      for (std::size_t i = 0; i < wait_objects_size; ++i)
+        {
+          wait_object& w = wait_objects_[i];
+          if (w.object == nullptr)
+            {
+              // First wait for this object.
+              w.object = wait_object_;
+              w.reason = wait_reason_;
+            }
+          else if (w.object != wait_object_ || w.reason != wait_reason_)
+            {
+              continue;
+            }
+
+          ++w.waits;
+          w.cycles += cycles;
+          break;
+        }
+#endif
     }
 
+    /**
+     * @endcond
+     */
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+
     /**
      * @cond ignore
      */
@@ -406,9 +801,18 @@ namespace micro_os_plus
                     / sizeof (stack::allocation_element_t);
             }
 
-          allocated_stack_address_
-              = const_cast<allocator_type2&> (allocator).allocate (
-                  allocated_stack_size_elements_);
+          std::size_t intact_bytes = 0;
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE)
+          allocated_stack_address_ = cache_get_stack (
+              allocated_stack_size_elements_, intact_bytes);
+          if (allocated_stack_address_ == nullptr)
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE)
+            {
+              allocated_stack_address_
+                  = const_cast<allocator_type2&> (allocator).allocate (
+                      allocated_stack_size_elements_);
+            }
 
           // Stack allocation failed.
           assert (allocated_stack_address_ != nullptr);
@@ -416,7 +820,8 @@ namespace micro_os_plus
           internal_construct_ (function, arguments, _attributes,
                                allocated_stack_address_,
                                allocated_stack_size_elements_
-                                   * sizeof (stack::allocation_element_t));
+                                   * sizeof (stack::allocation_element_t),
+                               intact_bytes);
         }
     }
 
@@ -429,7 +834,8 @@ namespace micro_os_plus
                                  function_arguments_t arguments,
                                  const attributes& _attributes,
                                  void* stack_address,
-                                 std::size_t stack_size_bytes)
+                                 std::size_t stack_size_bytes,
+                                 std::size_t stack_intact_bytes)
     {
       // Don't call this from interrupt handlers.
       micro_os_plus_assert_throw (!interrupts::in_handler_mode (), EPERM);
@@ -441,6 +847,10 @@ namespace micro_os_plus
 
       clock_ = _attributes.clock != nullptr ? _attributes.clock : &sysclock;
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+      event_trace::record_name (this, name ());
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+
       if (stack_address != nullptr)
         {
           // The attributes should not define any storage in this case.
@@ -487,7 +897,11 @@ namespace micro_os_plus
             scheduler::top_threads_list_.link (*this);
           }
 
-        stack ().initialize ();
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+        object_registry::internal_link_ (*this, object_registry::kind::thread);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
+        stack ().initialize (stack_intact_bytes);
 
 #if defined(MICRO_OS_PLUS_USE_RTOS_PORT_SCHEDULER)
 
@@ -548,6 +962,14 @@ namespace micro_os_plus
       trace::printf ("%s() @%p %s \n", __func__, this, name ());
 #endif
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+      object_registry::internal_unlink_ (*this);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_OBJECT_REGISTRY)
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+      wakeup_graph::internal_forget_ (this);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+
       // Prevent the main thread to destroy itself while running
       // the exit cleanup code.
       if (this != &this_thread::thread ())
@@ -580,6 +1002,11 @@ namespace micro_os_plus
                      priority_assigned_);
 #endif
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+      event_trace::record_event (event_trace::event::thread_resume,
+                                 priority_assigned_, this, 0);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+
 #if defined(MICRO_OS_PLUS_USE_RTOS_PORT_SCHEDULER)
 
       {
@@ -603,6 +1030,29 @@ namespace micro_os_plus
         // If the thread is not already in the ready list, enqueue it.
         if (ready_node_.next () == nullptr)
           {
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+            // Keep the first resume; the running thread has
+            // nothing to wait for.
+            if (statistics_.wakeup_timestamp_ == 0
+                && state_ != state::running)
+              {
+                statistics_.wakeup_timestamp_ = hrclock.now ();
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+                // The wait is still pending, it ends when the
+                // thread runs.
+                bool waiting = (statistics_.wait_timestamp_ != 0);
+                thread* waker = interrupts::in_handler_mode ()
+                                    ? nullptr
+                                    : scheduler::current_thread_;
+                statistics_.wakeup_edge_ = wakeup_graph::internal_find_ (
+                    waker, this, waiting ? statistics_.wait_object_ : nullptr,
+                    waiting ? statistics_.wait_reason_
+                            : rtos::statistics::wait_reason::other);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+              }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAKEUP_LATENCY)
+
             scheduler::ready_threads_list_.link (ready_node_);
             // state::ready set in above link().
           }
@@ -993,6 +1443,11 @@ namespace micro_os_plus
       trace::printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+      event_trace::record_event (event_trace::event::thread_suspend,
+                                 priority_assigned_, this, 0);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_EVENT_TRACE)
+
       {
         // ----- Enter critical section -------------------------------------
         interrupts::critical_section ics;
@@ -1027,6 +1482,14 @@ namespace micro_os_plus
 
           ready_node_.unlink ();
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+          if (scheduler::stack_scan_cursor_ == this)
+            {
+              // Move the idle scan past the leaving thread.
+              scheduler::stack_scan_cursor_ = internal_next_in_tree_ (false);
+            }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
           child_links_.unlink ();
           // ----- Exit critical section ----------------------------------
         }
@@ -1092,6 +1555,34 @@ namespace micro_os_plus
         }
     }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
+    /*
+     * Must be called with the scheduler locked.
+     */
+    thread*
+    thread::internal_next_in_tree_ (bool children)
+    {
+      if (children && !children_.empty ())
+        {
+          return &(*children_.begin ());
+        }
+
+      // The next sibling of the closest ancestor that has one.
+      for (thread* th = this; th != nullptr; th = th->parent_)
+        {
+          threads_list::iterator it{ &th->child_links_ };
+          ++it;
+          if (it != scheduler::children_threads (th->parent_).end ())
+            {
+              return &(*it);
+            }
+        }
+      return nullptr;
+    }
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
 #pragma GCC diagnostic push
 
 #if defined(__GNUC__) && !defined(__clang__)
@@ -1106,13 +1597,25 @@ namespace micro_os_plus
       trace::printf ("%s() @%p %s\n", __func__, this, name ());
 #endif
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE)
+      // Must be computed before the stack is cleared.
+      std::size_t intact_bytes
+          = (stack ().size () > 0) ? stack ().available () : 0;
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE)
+
       internal_check_stack_ ();
 
       if (allocated_stack_address_ != nullptr)
         {
-          static_cast<allocator_type*> (const_cast<void*> (allocator_))
-              ->deallocate (allocated_stack_address_,
-                            allocated_stack_size_elements_);
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE)
+          if (!cache_put_stack (allocated_stack_address_,
+                                allocated_stack_size_elements_, intact_bytes))
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE)
+            {
+              static_cast<allocator_type*> (const_cast<void*> (allocator_))
+                  ->deallocate (allocated_stack_address_,
+                                allocated_stack_size_elements_);
+            }
 
           allocated_stack_address_ = nullptr;
         }
@@ -1201,6 +1704,14 @@ namespace micro_os_plus
               clock_node_->unlink ();
             }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+          if (scheduler::stack_scan_cursor_ == this)
+            {
+              // Move the idle scan past the leaving thread.
+              scheduler::stack_scan_cursor_ = internal_next_in_tree_ (false);
+            }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_STACK_SCAN)
+
           child_links_.unlink ();
           // ----- Exit critical section ----------------------------------
         }
@@ -1315,8 +1826,29 @@ namespace micro_os_plus
             // ----- Exit critical section ----------------------------------
           }
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+          {
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            statistics_.internal_wait_begin_ (
+                rtos::statistics::wait_reason::flags, this);
+            // ----- Exit critical section ----------------------------------
+          }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+
           internal_suspend_ ();
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+          {
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            statistics_.internal_wait_end_ ();
+            // ----- Exit critical section ----------------------------------
+          }
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+
           if (interrupted ())
             {
 #if defined(MICRO_OS_PLUS_TRACE_RTMICRO_OS_PLUS_THREAD_FLAGS)
@@ -1437,6 +1969,11 @@ namespace micro_os_plus
             timeout_node.thread.clock_node_ = &timeout_node;
 
             state_ = state::suspended;
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+            statistics_.internal_wait_begin_ (
+                rtos::statistics::wait_reason::flags, this);
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
             // ----- Exit critical section ----------------------------------
           }
 
@@ -1450,6 +1987,10 @@ namespace micro_os_plus
             // if not already removed by the timer.
             timeout_node.thread.clock_node_ = nullptr;
             timeout_node.unlink ();
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
+            statistics_.internal_wait_end_ ();
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_STATISTICS_THREAD_WAIT)
             // ----- Exit critical section ----------------------------------
           }
 
@@ -1533,6 +2074,143 @@ namespace micro_os_plus
      * @endcond
      */
 
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE)
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @details
+     * Plain thread objects are taken from the cache, if available;
+     * larger objects of derived classes use the RTOS system allocator.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    void*
+    thread::operator new (std::size_t bytes)
+    {
+      if (bytes == sizeof (thread))
+        {
+          // ----- Enter critical section -----------------------------------
+          scheduler::critical_section scs;
+
+          if (cached_objects_count > 0)
+            {
+              ++cache_hits;
+              return cached_objects[--cached_objects_count];
+            }
+          ++cache_misses;
+          // ----- Exit critical section ------------------------------------
+        }
+
+      return object_named_system::operator new (bytes);
+    }
+
+    /**
+     * @details
+     * Plain thread objects are kept in the cache, if not full.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    void
+    thread::operator delete (void* ptr, std::size_t bytes)
+    {
+      if (ptr == nullptr)
+        {
+          return;
+        }
+
+      if (bytes == sizeof (thread))
+        {
+          // ----- Enter critical section -----------------------------------
+          scheduler::critical_section scs;
+
+          if (cached_objects_count
+              < MICRO_OS_PLUS_INTEGER_RTOS_THREAD_CACHE_OBJECTS)
+            {
+              cached_objects[cached_objects_count++] = ptr;
+              return;
+            }
+          // ----- Exit critical section ------------------------------------
+        }
+
+      object_named_system::operator delete (ptr, bytes);
+    }
+
+    /**
+     * @details
+     * The micro_os_plus::rtos::thread_cache namespace groups functions
+     * to inspect and flush the cache of thread objects and stacks.
+     *
+     * Up to `MICRO_OS_PLUS_INTEGER_RTOS_THREAD_CACHE_STACKS` stacks and
+     * `MICRO_OS_PLUS_INTEGER_RTOS_THREAD_CACHE_OBJECTS` objects
+     * are kept. A cached stack is reused for threads requesting
+     * a stack up to 25% smaller, as long as it was allocated
+     * from the current default memory resource; stacks from a
+     * previous resource are returned to it by `flush()`.
+     *
+     * When the stack of a terminated thread is cached, the bottom
+     * part which still holds the magic word is remembered, and
+     * when reused, only the rest of the stack is refilled.
+     *
+     * Only the stacks allocated by the `thread` constructor are cached;
+     * threads with static stacks, or with custom allocators, are not
+     * affected.
+     */
+    namespace thread_cache
+    {
+      std::size_t
+      stacks (void)
+      {
+        return cached_stacks_count;
+      }
+
+      std::size_t
+      objects (void)
+      {
+        return cached_objects_count;
+      }
+
+      std::size_t
+      hits (void)
+      {
+        return cache_hits;
+      }
+
+      std::size_t
+      misses (void)
+      {
+        return cache_misses;
+      }
+
+      /**
+       * @warning Cannot be invoked from Interrupt Service Routines.
+       */
+      void
+      flush (void)
+      {
+        // ----- Enter critical section -------------------------------------
+        scheduler::critical_section scs;
+
+        while (cached_stacks_count > 0)
+          {
+            cached_stack& cs = cached_stacks[--cached_stacks_count];
+            cs.resource->deallocate (
+                cs.address,
+                cs.size_elements
+                    * sizeof (thread::stack::allocation_element_t));
+          }
+
+        while (cached_objects_count > 0)
+          {
+            internal::object_named_system::operator delete (
+                cached_objects[--cached_objects_count], sizeof (thread));
+          }
+        // ----- Exit critical section --------------------------------------
+      }
+    } // namespace thread_cache
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_THREAD_CACHE)
+
     // ------------------------------------------------------------------------
     /**
      * @details
@@ -0,0 +1,1121 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <micro-os-plus/rtos.h>
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    // ------------------------------------------------------------------------
+
+    /**
+     * @cond ignore
+     */
+
+    using subscribers_list
+        = utils::intrusive_list<topic_subscriber, utils::double_list_links,
+                                &topic_subscriber::topic_links_>;
+
+    /**
+     * @endcond
+     */
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @class topic::attributes
+     * @details
+     * Allow to assign a name and custom attributes (like a clock)
+     * to the topic.
+     */
+
+    /**
+     * @details
+     * This variable is used by the default constructor.
+     */
+    const topic::attributes topic::initializer;
+
+    /**
+     * @class topic_subscriber::attributes
+     * @details
+     * Allow to assign a name and custom attributes (like a static
+     * address for the queue, or the overflow policy) to the subscriber.
+     *
+     * To simplify access, the member variables are public and do not
+     * require accessors or mutators.
+     */
+
+    /**
+     * @var topic::overflow_t topic_subscriber::attributes::overflow
+     * @details
+     * The policy used when a message is published and the subscriber
+     * queue is full:
+     * - `topic::overflow::drop_oldest` discards the oldest queued message,
+     *   useful for consumers interested only in the latest values;
+     * - `topic::overflow::drop_newest` discards the new message;
+     * - `topic::overflow::block` makes the publisher wait until the
+     *   subscriber makes room; the non-blocking publish fails.
+     */
+
+    /**
+     * @details
+     * This variable is used by the default constructor.
+     */
+    const topic_subscriber::attributes topic_subscriber::initializer;
+
+    // ------------------------------------------------------------------------
+
+    /**
+     * @class topic
+     * @details
+     * A topic delivers the same message to multiple subscribers,
+     * without copying it.
+     *
+     * The publisher allocates a message from the memory pool
+     * associated with the topic, writes the payload once and publishes it.
+     * Each subscriber receives a pointer to the same payload,
+     * and the message keeps a reference count; the block is returned
+     * to the pool when the last subscriber releases it.
+     *
+     * Each subscriber has its own queue depth and overflow policy.
+     *
+     * @par Example
+     *
+     * @code{.cpp}
+     * memory_pool_inclusive<sample_t, 8> pool;
+     * topic samples { "samples", pool };
+     *
+     * topic_subscriber_inclusive<4> logger { samples };
+     *
+     * void
+     * producer(void)
+     * {
+     *   void* payload = samples.alloc();
+     *   // Fill in the payload.
+     *   samples.publish(payload, sizeof(sample_t));
+     * }
+     *
+     * void
+     * consumer(void)
+     * {
+     *   const void* payload;
+     *   for (; some_condition();)
+     *     {
+     *       logger.receive(&payload);
+     *       // Process payload.
+     *       logger.release(payload);
+     *     }
+     * }
+     * @endcode
+     *
+     * @note The pool blocks must be large enough to also store
+     * a small header (`topic::header_size_bytes`).
+     *
+     * @par POSIX compatibility
+     *  No POSIX similar functionality identified.
+     */
+
+    /**
+     * @details
+     * The memory pool must not be used for other purposes.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    topic::topic (memory_pool& pool, const attributes& _attributes)
+        : topic{ nullptr, pool, _attributes }
+    {
+      ;
+    }
+
+    /**
+     * @details
+     * The memory pool must not be used for other purposes.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    topic::topic (const char* name, memory_pool& pool,
+                  const attributes& _attributes)
+        : object_named_system{ name }
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      micro_os_plus_assert_throw (!interrupts::in_handler_mode (), EPERM);
+
+      clock_ = _attributes.clock != nullptr ? _attributes.clock : &sysclock;
+
+      // The blocks must accommodate the header and some payload.
+      micro_os_plus_assert_throw (pool.block_size () > header_size_bytes,
+                                  EINVAL);
+
+      pool_ = &pool;
+    }
+
+    /**
+     * @details
+     * All subscribers must be destroyed before the topic.
+     */
+    topic::~topic ()
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // There must be no subscribers and no threads waiting.
+      assert (subscribers_.empty ());
+      assert (publish_list_.empty ());
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    void*
+    topic::internal_payload_ (void* block)
+    {
+      if (block == nullptr)
+        {
+          return nullptr;
+        }
+
+      message_header* header = static_cast<message_header*> (block);
+      header->references = unpublished_references;
+      header->size_bytes = 0;
+
+      return static_cast<char*> (block) + header_size_bytes;
+    }
+
+    topic::message_header*
+    topic::internal_header_ (const void* payload)
+    {
+      if (payload == nullptr)
+        {
+          return nullptr;
+        }
+
+      char* block = const_cast<char*> (static_cast<const char*> (payload))
+                    - header_size_bytes;
+
+      // Validate pointer.
+      char* first = static_cast<char*> (pool_->pool ());
+      if ((block < first)
+          || (block >= first + pool_->capacity () * pool_->block_size ()))
+        {
+          return nullptr;
+        }
+
+      return reinterpret_cast<message_header*> (block);
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    bool
+    topic::internal_try_publish_ (message_header* header)
+    {
+      subscribers_list& list
+          = reinterpret_cast<subscribers_list&> (subscribers_);
+
+      // First pass, blocking subscribers must have room, since the
+      // message is delivered to all subscribers or to none.
+      for (auto& sub : list)
+        {
+          if (sub.overflow_ == overflow::block && sub.count_ >= sub.depth_)
+            {
+              return false;
+            }
+        }
+
+      for (auto& sub : list)
+        {
+          if (sub.count_ >= sub.depth_)
+            {
+              ++sub.dropped_;
+              if (sub.overflow_ == overflow::drop_newest)
+                {
+                  continue;
+                }
+
+              // Make room by discarding the oldest message.
+              internal_release_ (sub.internal_pop_ ());
+            }
+
+          header->references = header->references + 1;
+          sub.internal_push_ (header);
+
+          // Wake-up one thread, if any.
+          sub.receive_list_.resume_one ();
+        }
+
+      return true;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    void
+    topic::internal_release_ (message_header* header)
+    {
+      assert (header->references > 0);
+
+      header->references = header->references - 1;
+      if (header->references == 0)
+        {
+          // The last reference, return the block to the pool.
+          pool_->free (header);
+        }
+    }
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @details
+     * Allocate a message from the topic memory pool. If the pool
+     * is exhausted, `alloc()` shall block until a message is
+     * released or until `alloc()` is cancelled/interrupted.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    void*
+    topic::alloc (void)
+    {
+      return internal_payload_ (pool_->alloc ());
+    }
+
+    /**
+     * @details
+     * Try to allocate a message from the topic memory pool.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    void*
+    topic::try_alloc (void)
+    {
+      return internal_payload_ (pool_->try_alloc ());
+    }
+
+    /**
+     * @details
+     * Allocate a message from the topic memory pool. If the pool
+     * is exhausted, the wait shall be terminated when the specified
+     * timeout expires.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    void*
+    topic::timed_alloc (clock::duration_t timeout)
+    {
+      return internal_payload_ (pool_->timed_alloc (timeout));
+    }
+
+    /**
+     * @details
+     * Deliver the message to all subscribers. Subscribers with
+     * full queues are handled according to their overflow policy;
+     * if any of them uses `overflow::block`, `publish()` shall block
+     * until all of them have room, or until `publish()` is
+     * cancelled/interrupted.
+     *
+     * After a successful publish, the payload belongs to the
+     * subscribers and must no longer be accessed by the publisher.
+     * On error, the payload remains with the publisher, which
+     * may retry or give it back with `release()`.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    topic::publish (void* payload, std::size_t nbytes)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+      trace::printf ("%s(%p,%u) @%p %s\n", __func__, payload, nbytes, this,
+                     name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      micro_os_plus_assert_err (!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      micro_os_plus_assert_err (!scheduler::locked (), EPERM);
+
+      message_header* header = internal_header_ (payload);
+      micro_os_plus_assert_err (header != nullptr, EINVAL);
+      micro_os_plus_assert_err (nbytes <= max_payload_size (), EMSGSIZE);
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node{ crt_thread };
+
+      for (;;)
+        {
+          {
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            header->size_bytes = nbytes;
+
+            // The publisher reference; released after delivery, which
+            // also frees the block if there are no subscribers.
+            header->references = 1;
+            if (internal_try_publish_ (header))
+              {
+                internal_release_ (header);
+                return result::ok;
+              }
+            header->references = unpublished_references;
+
+            // Add this thread to the topic publish waiting list.
+            scheduler::internal_link_node (
+                publish_list_, node, rtos::statistics::wait_reason::queue_send,
+                this);
+            // state::suspended set in above link().
+            // ----- Exit critical section ----------------------------------
+          }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the publish waiting list,
+          // if not already removed by receive().
+          scheduler::internal_unlink_node (node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+              trace::printf ("%s(%p,%u) EINTR @%p %s\n", __func__, payload,
+                             nbytes, this, name ());
+#endif
+              return EINTR;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * Deliver the message to all subscribers. If a subscriber
+     * using `overflow::block` is full, the message is not delivered
+     * to any subscriber and `try_publish()` shall return an error.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    topic::try_publish (void* payload, std::size_t nbytes)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+      trace::printf ("%s(%p,%u) @%p %s\n", __func__, payload, nbytes, this,
+                     name ());
+#endif
+
+      message_header* header = internal_header_ (payload);
+      micro_os_plus_assert_err (header != nullptr, EINVAL);
+      micro_os_plus_assert_err (nbytes <= max_payload_size (), EMSGSIZE);
+
+      // Don't call this from high priority interrupts.
+      assert (port::interrupts::is_priority_valid ());
+
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        header->size_bytes = nbytes;
+
+        header->references = 1;
+        if (internal_try_publish_ (header))
+          {
+            internal_release_ (header);
+            return result::ok;
+          }
+        header->references = unpublished_references;
+
+        return EWOULDBLOCK;
+        // ----- Exit critical section --------------------------------------
+      }
+    }
+
+    /**
+     * @details
+     * Deliver the message to all subscribers. If a subscriber
+     * using `overflow::block` is full, the wait shall be terminated
+     * when the specified timeout expires.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    topic::timed_publish (void* payload, std::size_t nbytes,
+                          clock::duration_t timeout)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+      trace::printf ("%s(%p,%u,%u) @%p %s\n", __func__, payload, nbytes,
+                     timeout, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      micro_os_plus_assert_err (!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      micro_os_plus_assert_err (!scheduler::locked (), EPERM);
+
+      message_header* header = internal_header_ (payload);
+      micro_os_plus_assert_err (header != nullptr, EINVAL);
+      micro_os_plus_assert_err (nbytes <= max_payload_size (), EMSGSIZE);
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node{ crt_thread };
+
+      internal::clock_timestamps_list& clock_list = clock_->steady_list ();
+      clock::timestamp_t timeout_timestamp = clock_->steady_now () + timeout;
+
+      // Prepare a timeout node pointing to the current thread.
+      internal::timeout_thread_node timeout_node{ timeout_timestamp,
+                                                  crt_thread };
+
+      for (;;)
+        {
+          {
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            header->size_bytes = nbytes;
+
+            header->references = 1;
+            if (internal_try_publish_ (header))
+              {
+                internal_release_ (header);
+                return result::ok;
+              }
+            header->references = unpublished_references;
+
+            // Add this thread to the topic publish waiting list,
+            // and the clock timeout list.
+            scheduler::internal_link_node (
+                publish_list_, node, clock_list, timeout_node,
+                rtos::statistics::wait_reason::queue_send, this);
+            // state::suspended set in above link().
+            // ----- Exit critical section ----------------------------------
+          }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the publish waiting list,
+          // if not already removed by receive() and from the clock timeout
+          // list, if not already removed by the timer.
+          scheduler::internal_unlink_node (node, timeout_node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+              trace::printf ("%s(%p,%u,%u) EINTR @%p %s\n", __func__, payload,
+                             nbytes, timeout, this, name ());
+#endif
+              return EINTR;
+            }
+
+          if (clock_->steady_now () >= timeout_timestamp)
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+              trace::printf ("%s(%p,%u,%u) ETIMEDOUT @%p %s\n", __func__,
+                             payload, nbytes, timeout, this, name ());
+#endif
+              return ETIMEDOUT;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * Drop a reference to the message; when the last reference
+     * is dropped, the block is returned to the memory pool.
+     *
+     * Also used by the publisher to give back an allocated message
+     * that was not published.
+     *
+     * Releasing a message which has no references left, for
+     * example releasing it twice, fails with `EINVAL`.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    topic::release (const void* payload)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+      trace::printf ("%s(%p) @%p %s\n", __func__, payload, this, name ());
+#endif
+
+      message_header* header = internal_header_ (payload);
+      micro_os_plus_assert_err (header != nullptr, EINVAL);
+
+      // Don't call this from high priority interrupts.
+      assert (port::interrupts::is_priority_valid ());
+
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        if (header->references == 0)
+          {
+            // Already released, freeing it again would corrupt the pool.
+            return EINVAL;
+          }
+
+        if (header->references == unpublished_references)
+          {
+            // Never published, there are no other references.
+            header->references = 1;
+          }
+        internal_release_ (header);
+        // ----- Exit critical section --------------------------------------
+      }
+
+      return result::ok;
+    }
+
+    // ========================================================================
+
+    /**
+     * @class topic_subscriber
+     * @details
+     * A subscriber keeps a queue of references to messages published
+     * on a topic. After processing, each received message must
+     * be released.
+     *
+     * The storage for the queue is allocated dynamically,
+     * using the
+     * RTOS specific allocator (`micro_os_plus::memory::allocator`).
+     *
+     * For special cases, the storage can be allocated outside the
+     * class and specified via the `arena_address` and
+     * `arena_size_bytes` attributes.
+     */
+
+    /**
+     * @class topic_subscriber_inclusive
+     * @details
+     * If the queue depth is known at compile time, it might be
+     * preferred to allocate the queue storage statically inside
+     * the subscriber instance.
+     */
+
+    /**
+     * @cond ignore
+     */
+
+    // Protected internal constructor.
+    topic_subscriber::topic_subscriber (const char* name)
+        : object_named_system{ name }
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+      trace::printf ("%s() @%p %s\n", __func__, this, this->name ());
+#endif
+    }
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @details
+     * The subscriber is linked to the topic and starts receiving
+     * the messages published after construction.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    topic_subscriber::topic_subscriber (rtos::topic& topic, std::size_t depth,
+                                        const attributes& _attributes,
+                                        const allocator_type& allocator)
+        : topic_subscriber{ nullptr, topic, depth, _attributes, allocator }
+    {
+      ;
+    }
+
+    /**
+     * @details
+     * The subscriber is linked to the topic and starts receiving
+     * the messages published after construction.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    topic_subscriber::topic_subscriber (const char* name, rtos::topic& topic,
+                                        std::size_t depth,
+                                        const attributes& _attributes,
+                                        const allocator_type& allocator)
+        : object_named_system{ name }
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+      trace::printf ("%s() @%p %s %u\n", __func__, this, this->name (),
+                     depth);
+#endif
+
+      if (_attributes.arena_address != nullptr)
+        {
+          // Do not use any allocator at all.
+          internal_construct_ (topic, depth, _attributes, nullptr, 0);
+        }
+      else
+        {
+          allocator_ = &allocator;
+
+          // If no user storage was provided via attributes,
+          // allocate it dynamically via the allocator.
+          allocated_arena_size_elements_ = depth;
+
+          allocated_arena_address_
+              = const_cast<allocator_type&> (allocator).allocate (
+                  allocated_arena_size_elements_);
+
+          internal_construct_ (topic, depth, _attributes,
+                               allocated_arena_address_,
+                               allocated_arena_size_elements_
+                                   * sizeof (allocator_type::value_type));
+        }
+    }
+
+    /**
+     * @details
+     * The subscriber is unlinked from the topic, and the references
+     * to the messages still in the queue are released.
+     *
+     * If the storage for the queue was dynamically allocated,
+     * it is deallocated using the same allocator.
+     */
+    topic_subscriber::~topic_subscriber ()
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // There must be no threads waiting for this subscriber.
+      assert (receive_list_.empty ());
+
+      if (topic_ != nullptr)
+        {
+          // ----- Enter critical section -----------------------------------
+          interrupts::critical_section ics;
+
+          topic_links_.unlink ();
+          --topic_->subscribers_count_;
+
+          while (count_ > 0)
+            {
+              topic_->internal_release_ (internal_pop_ ());
+            }
+
+          // A blocked publisher might proceed now.
+          topic_->publish_list_.resume_all ();
+          // ----- Exit critical section ------------------------------------
+        }
+
+      if (allocated_arena_address_ != nullptr)
+        {
+          static_cast<allocator_type*> (const_cast<void*> (allocator_))
+              ->deallocate (static_cast<allocator_type::value_type*> (
+                                allocated_arena_address_),
+                            allocated_arena_size_elements_);
+        }
+    }
+
+    /**
+     * @cond ignore
+     */
+
+    void
+    topic_subscriber::internal_construct_ (rtos::topic& topic,
+                                           std::size_t depth,
+                                           const attributes& _attributes,
+                                           void* arena_address,
+                                           std::size_t arena_size_bytes)
+    {
+      // Don't call this from interrupt handlers.
+      micro_os_plus_assert_throw (!interrupts::in_handler_mode (), EPERM);
+
+      clock_ = _attributes.clock != nullptr ? _attributes.clock : &sysclock;
+
+      micro_os_plus_assert_throw (depth > 0, EINVAL);
+      micro_os_plus_assert_throw (
+          _attributes.overflow <= rtos::topic::overflow::max_, EINVAL);
+
+      depth_ = depth;
+      overflow_ = _attributes.overflow;
+
+      // If the storage is given explicitly, override attributes.
+      if (arena_address == nullptr)
+        {
+          arena_address = _attributes.arena_address;
+          arena_size_bytes = _attributes.arena_size_bytes;
+        }
+      else
+        {
+          // The attributes should not define any storage in this case.
+          assert (_attributes.arena_address == nullptr);
+        }
+
+      // The queue storage must have a real address.
+      micro_os_plus_assert_throw (arena_address != nullptr, ENOMEM);
+      micro_os_plus_assert_throw (
+          arena_size_bytes >= depth * sizeof (rtos::topic::message_header*),
+          EINVAL);
+
+      queue_ = static_cast<rtos::topic::message_header**> (arena_address);
+
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        subscribers_list& list
+            = reinterpret_cast<subscribers_list&> (topic.subscribers_);
+        list.link (*this);
+        ++topic.subscribers_count_;
+
+        topic_ = &topic;
+        // ----- Exit critical section --------------------------------------
+      }
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section,
+     * with room in the queue.
+     */
+    void
+    topic_subscriber::internal_push_ (rtos::topic::message_header* header)
+    {
+      std::size_t ix = head_ + count_;
+      if (ix >= depth_)
+        {
+          ix -= depth_;
+        }
+      queue_[ix] = header;
+
+      count_ = count_ + 1; // Volatile increment.
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    rtos::topic::message_header*
+    topic_subscriber::internal_pop_ (void)
+    {
+      if (count_ == 0)
+        {
+          return nullptr;
+        }
+
+      rtos::topic::message_header* header = queue_[head_];
+      if (++head_ >= depth_)
+        {
+          head_ = 0;
+        }
+
+      count_ = count_ - 1; // Volatile decrement.
+
+      return header;
+    }
+
+    /*
+     * Internal function.
+     * Should be called from an interrupts critical section.
+     */
+    bool
+    topic_subscriber::internal_try_receive_ (const void** payload,
+                                             std::size_t* nbytes)
+    {
+      rtos::topic::message_header* header = internal_pop_ ();
+      if (header == nullptr)
+        {
+          return false;
+        }
+
+      *payload = reinterpret_cast<char*> (header)
+                 + rtos::topic::header_size_bytes;
+      if (nbytes != nullptr)
+        {
+          *nbytes = header->size_bytes;
+        }
+
+      if (overflow_ == rtos::topic::overflow::block)
+        {
+          // Publishers might be waiting for room in this queue.
+          topic_->publish_list_.resume_all ();
+        }
+
+      return true;
+    }
+
+    /**
+     * @endcond
+     */
+
+    /**
+     * @details
+     * Get the oldest message from the queue. If the queue is empty,
+     * `receive()` shall block until a message is published or until
+     * `receive()` is cancelled/interrupted.
+     *
+     * The message must be released after processing.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    topic_subscriber::receive (const void** payload, std::size_t* nbytes)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      micro_os_plus_assert_err (!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      micro_os_plus_assert_err (!scheduler::locked (), EPERM);
+
+      micro_os_plus_assert_err (payload != nullptr, EINVAL);
+
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        if (internal_try_receive_ (payload, nbytes))
+          {
+            return result::ok;
+          }
+        // ----- Exit critical section --------------------------------------
+      }
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node{ crt_thread };
+
+      for (;;)
+        {
+          {
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            if (internal_try_receive_ (payload, nbytes))
+              {
+                return result::ok;
+              }
+
+            // Add this thread to the subscriber receive waiting list.
+            scheduler::internal_link_node (
+                receive_list_, node,
+                rtos::statistics::wait_reason::queue_receive, this);
+            // state::suspended set in above link().
+            // ----- Exit critical section ----------------------------------
+          }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the receive waiting list,
+          // if not already removed by publish().
+          scheduler::internal_unlink_node (node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+              trace::printf ("%s() EINTR @%p %s\n", __func__, this, name ());
+#endif
+              return EINTR;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    /**
+     * @details
+     * Try to get the oldest message from the queue.
+     *
+     * The message must be released after processing.
+     *
+     * @note Can be invoked from Interrupt Service Routines.
+     */
+    result_t
+    topic_subscriber::try_receive (const void** payload, std::size_t* nbytes)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+      trace::printf ("%s() @%p %s\n", __func__, this, name ());
+#endif
+
+      micro_os_plus_assert_err (payload != nullptr, EINVAL);
+
+      // Don't call this from high priority interrupts.
+      assert (port::interrupts::is_priority_valid ());
+
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        if (internal_try_receive_ (payload, nbytes))
+          {
+            return result::ok;
+          }
+        else
+          {
+            return EWOULDBLOCK;
+          }
+        // ----- Exit critical section --------------------------------------
+      }
+    }
+
+    /**
+     * @details
+     * Get the oldest message from the queue. If the queue is empty,
+     * the wait shall be terminated when the specified timeout expires.
+     *
+     * The message must be released after processing.
+     *
+     * @warning Cannot be invoked from Interrupt Service Routines.
+     */
+    result_t
+    topic_subscriber::timed_receive (const void** payload,
+                                     clock::duration_t timeout,
+                                     std::size_t* nbytes)
+    {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+      trace::printf ("%s(%u) @%p %s\n", __func__, timeout, this, name ());
+#endif
+
+      // Don't call this from interrupt handlers.
+      micro_os_plus_assert_err (!interrupts::in_handler_mode (), EPERM);
+      // Don't call this from critical regions.
+      micro_os_plus_assert_err (!scheduler::locked (), EPERM);
+
+      micro_os_plus_assert_err (payload != nullptr, EINVAL);
+
+      // Extra test before entering the loop, with its inherent weight.
+      // Trade size for speed.
+      {
+        // ----- Enter critical section -------------------------------------
+        interrupts::critical_section ics;
+
+        if (internal_try_receive_ (payload, nbytes))
+          {
+            return result::ok;
+          }
+        // ----- Exit critical section --------------------------------------
+      }
+
+      thread& crt_thread = this_thread::thread ();
+
+      // Prepare a list node pointing to the current thread.
+      // Do not worry for being on stack, it is temporarily linked to the
+      // list and guaranteed to be removed before this function returns.
+      internal::waiting_thread_node node{ crt_thread };
+
+      internal::clock_timestamps_list& clock_list = clock_->steady_list ();
+      clock::timestamp_t timeout_timestamp = clock_->steady_now () + timeout;
+
+      // Prepare a timeout node pointing to the current thread.
+      internal::timeout_thread_node timeout_node{ timeout_timestamp,
+                                                  crt_thread };
+
+      for (;;)
+        {
+          {
+            // ----- Enter critical section ---------------------------------
+            interrupts::critical_section ics;
+
+            if (internal_try_receive_ (payload, nbytes))
+              {
+                return result::ok;
+              }
+
+            // Add this thread to the subscriber receive waiting list,
+            // and the clock timeout list.
+            scheduler::internal_link_node (
+                receive_list_, node, clock_list, timeout_node,
+                rtos::statistics::wait_reason::queue_receive, this);
+            // state::suspended set in above link().
+            // ----- Exit critical section ----------------------------------
+          }
+
+          port::scheduler::reschedule ();
+
+          // Remove the thread from the receive waiting list,
+          // if not already removed by publish() and from the clock timeout
+          // list, if not already removed by the timer.
+          scheduler::internal_unlink_node (node, timeout_node);
+
+          if (crt_thread.interrupted ())
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+              trace::printf ("%s(%u) EINTR @%p %s\n", __func__, timeout, this,
+                             name ());
+#endif
+              return EINTR;
+            }
+
+          if (clock_->steady_now () >= timeout_timestamp)
+            {
+#if defined(MICRO_OS_PLUS_TRACE_RTOS_TOPIC)
+              trace::printf ("%s(%u) ETIMEDOUT @%p %s\n", __func__, timeout,
+                             this, name ());
+#endif
+              return ETIMEDOUT;
+            }
+        }
+
+      /* NOTREACHED */
+      return ENOTRECOVERABLE;
+    }
+
+    // ------------------------------------------------------------------------
+
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+// ----------------------------------------------------------------------------
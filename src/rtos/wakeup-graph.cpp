@@ -0,0 +1,327 @@
+/*
+ * This file is part of the µOS++ distribution.
+ *   (https://github.com/micro-os-plus)
+ * Copyright (c) 2016 Liviu Ionescu.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom
+ * the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+
+#include <micro-os-plus/rtos.h>
+
+#include <micro-os-plus/diag/trace.h>
+
+// ----------------------------------------------------------------------------
+
+#if !defined(MICRO_OS_PLUS_INTEGER_RTOS_WAKEUP_GRAPH_EDGES)
+#define MICRO_OS_PLUS_INTEGER_RTOS_WAKEUP_GRAPH_EDGES (32)
+#endif
+
+// ----------------------------------------------------------------------------
+
+#pragma GCC diagnostic push
+
+#if defined(__clang__)
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#endif
+
+namespace micro_os_plus
+{
+  namespace rtos
+  {
+    namespace wakeup_graph
+    {
+      // ======================================================================
+
+      /**
+       * @cond ignore
+       */
+
+      namespace
+      {
+        constexpr std::size_t table_size
+            = MICRO_OS_PLUS_INTEGER_RTOS_WAKEUP_GRAPH_EDGES;
+
+        static_assert ((table_size & (table_size - 1)) == 0,
+                       "The number of edges must be a power of 2.");
+
+        // Hash table with linear probing; empty slots have a null
+        // wakee, removed slots have the `removed` wakee, so the
+        // probe sequences of the other edges are not broken.
+        edge table[table_size];
+
+        // Only its address is used, to mark removed slots.
+        char removed_marker;
+        const thread* const removed
+            = reinterpret_cast<const thread*> (&removed_marker);
+
+        bool
+        is_used (const edge& e)
+        {
+          return e.wakee != nullptr && e.wakee != removed;
+        }
+
+        uint32_t dropped_;
+
+        // Statically allocated, to avoid large stack frames.
+        edge print_buffer[table_size];
+
+        const char* const reason_names[rtos::statistics::wait_reasons] = {
+          "other", "mutex", "semaphore", "queue_send",
+          "queue_receive", "flags", "sleep", "memory_pool",
+        };
+
+        // Insert the edge in the array sorted by descending total
+        // latency, dropping the last one if full.
+        std::size_t
+        insert_sorted (edge* out, std::size_t used, std::size_t count,
+                       const edge& e)
+        {
+          std::size_t i = (used < count) ? used : count;
+          while (i > 0
+                 && out[i - 1].total_latency_cycles < e.total_latency_cycles)
+            {
+              if (i < count)
+                {
+                  out[i] = out[i - 1];
+                }
+              --i;
+            }
+          if (i < count)
+            {
+              out[i] = e;
+            }
+
+          return (used < count) ? used + 1 : count;
+        }
+      } // namespace
+
+      /*
+       * Called by thread::resume(), with interrupts disabled.
+       */
+      edge*
+      internal_find_ (const thread* waker, const thread* wakee,
+                      const void* object,
+                      rtos::statistics::wait_reason reason) noexcept
+      {
+        uintptr_t key = reinterpret_cast<uintptr_t> (waker)
+                        ^ (reinterpret_cast<uintptr_t> (wakee) >> 2)
+                        ^ (reinterpret_cast<uintptr_t> (object) >> 4);
+        std::size_t i
+            = (static_cast<std::size_t> (key >> 1) * 2654435761u)
+              & (table_size - 1);
+        edge* slot = nullptr;
+        for (std::size_t n = 0; n < table_size; ++n)
+          {
+            edge& e = table[(i + n) & (table_size - 1)];
+            if (e.wakee == wakee && e.waker == waker && e.object == object
+                && e.reason == reason)
+              {
+                return &e;
+              }
+            if (e.wakee == nullptr)
+              {
+                if (slot == nullptr)
+                  {
+                    slot = &e;
+                  }
+                break;
+              }
+            if (e.wakee == removed && slot == nullptr)
+              {
+                // Reuse the first removed slot, if the edge is
+                // not found further on.
+                slot = &e;
+              }
+          }
+
+        if (slot == nullptr)
+          {
+            ++dropped_;
+            return nullptr;
+          }
+
+        *slot = edge{};
+        slot->waker = waker;
+        slot->wakee = wakee;
+        slot->object = object;
+        slot->waker_name = (waker != nullptr) ? waker->name () : "ISR";
+        slot->wakee_name = wakee->name ();
+        slot->reason = reason;
+        return slot;
+      }
+
+      /*
+       * Called by the scheduler when switching to the resumed thread,
+       * with interrupts disabled.
+       */
+      void
+      internal_record_ (edge* e, const thread* wakee,
+                        rtos::statistics::duration_t latency) noexcept
+      {
+        // The entry might have been cleared meanwhile.
+        if (e->wakee != wakee)
+          {
+            return;
+          }
+
+        ++e->count;
+        e->total_latency_cycles += latency;
+      }
+
+      /*
+       * Called by the thread destructor; the edges keep the thread
+       * and its name by address, so they must not survive it.
+       */
+      void
+      internal_forget_ (const thread* th) noexcept
+      {
+        // ----- Enter critical section ---------------------------------------
+        interrupts::critical_section ics;
+
+        for (auto& e : table)
+          {
+            if (is_used (e) && (e.wakee == th || e.waker == th))
+              {
+                e = edge{};
+                e.wakee = removed;
+              }
+          }
+        // ----- Exit critical section ----------------------------------------
+      }
+
+      /**
+       * @endcond
+       */
+
+      // ----------------------------------------------------------------------
+
+      /**
+       * @details
+       * Edges with resumes not yet followed by the resumed thread
+       * running have a zero count.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      std::size_t
+      report (edge* out, std::size_t count) noexcept
+      {
+        if (out == nullptr || count == 0)
+          {
+            return 0;
+          }
+
+        std::size_t used = 0;
+
+        // ----- Enter critical section ---------------------------------------
+        interrupts::critical_section ics;
+
+        for (std::size_t i = 0; i < table_size; ++i)
+          {
+            if (is_used (table[i]))
+              {
+                used = insert_sorted (out, used, count, table[i]);
+              }
+          }
+
+        return used;
+        // ----- Exit critical section ----------------------------------------
+      }
+
+      /**
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      uint32_t
+      dropped (void) noexcept
+      {
+        return dropped_;
+      }
+
+      /**
+       * @details
+       * The pending wakeups are not accounted when the resumed
+       * threads start running.
+       *
+       * @note Can be invoked from Interrupt Service Routines.
+       */
+      void
+      clear (void) noexcept
+      {
+        // ----- Enter critical section ---------------------------------------
+        interrupts::critical_section ics;
+
+        for (auto& e : table)
+          {
+            e = edge{};
+          }
+        dropped_ = 0;
+        // ----- Exit critical section ----------------------------------------
+      }
+
+      /**
+       * @details
+       * Print one edge per line, sorted by the total latency, with
+       * the waker and the resumed thread names, the wait reason,
+       * the object address, the number of wakeups and the average
+       * latency, in CPU cycles.
+       *
+       * The output is parsed by `scripts/wakeup-graph.py`;
+       * thread names should not contain ` -> ` or commas.
+       *
+       * @warning Not reentrant.
+       */
+      void
+      trace_print (void)
+      {
+#if defined(TRACE)
+        std::size_t n = report (print_buffer, table_size);
+
+        trace::printf ("Wakeup graph, %u edges, %u dropped\n",
+                       static_cast<unsigned int> (n),
+                       static_cast<unsigned int> (dropped_));
+
+        for (std::size_t i = 0; i < n; ++i)
+          {
+            const edge& e = print_buffer[i];
+            trace::printf (
+                "\t%s -> %s, %s %p, %u times, avg %lu cycles\n",
+                e.waker_name, e.wakee_name,
+                reason_names[static_cast<std::size_t> (e.reason)], e.object,
+                static_cast<unsigned int> (e.count),
+                static_cast<unsigned long> (e.total_latency_cycles
+                                            / (e.count ? e.count : 1)));
+          }
+#endif // defined(TRACE)
+      }
+
+      // ----------------------------------------------------------------------
+
+    } // namespace wakeup_graph
+  } // namespace rtos
+} // namespace micro_os_plus
+
+#pragma GCC diagnostic pop
+
+#endif // defined(MICRO_OS_PLUS_INCLUDE_RTOS_WAKEUP_GRAPH)
+
+// ----------------------------------------------------------------------------
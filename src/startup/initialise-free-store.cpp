@@ -34,6 +34,9 @@
 #include <micro-os-plus/memory/first-fit-top.h>
 #include <micro-os-plus/memory/lifo.h>
 #include <micro-os-plus/memory/block-pool.h>
+#include <micro-os-plus/rtos/memory-slab.h>
+#include <micro-os-plus/rtos/memory-sized.h>
+#include <micro-os-plus/rtos/memory-tlsf.h>
 #include <micro-os-plus/estd/memory_resource>
 #include <micro-os-plus/startup/defines.h>
 
@@ -44,11 +47,19 @@ using namespace micro_os_plus;
 // ----------------------------------------------------------------------------
 
 #if defined(MICRO_OS_PLUS_TYPE_APPLICATION_MEMORY_RESOURCE)
+// For example `micro_os_plus::rtos::memory::slab`, for near constant
+// time small allocations, or `micro_os_plus::rtos::memory::tlsf`, for
+// constant time allocations regardless of fragmentation.
 using application_memory_resource
     = MICRO_OS_PLUS_TYPE_APPLICATION_MEMORY_RESOURCE;
 #else
-// using free_store_memory_resource = memory::lifo;
-using application_memory_resource = memory::first_fit_top;
+// The first fit allocator does not report the block sizes, which are
+// required by `realloc()` and `malloc_usable_size()`; the adapter
+// keeps them in a header of two words per block.
+// using free_store_memory_resource
+//     = rtos::memory::sized_blocks<memory::lifo>;
+using application_memory_resource
+    = rtos::memory::sized_blocks<memory::first_fit_top>;
 #endif
 
 #if defined(MICRO_OS_PLUS_TYPE_RTOS_MEMORY_RESOURCE)